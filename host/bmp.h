@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * @file    bmp.h
+ * @author  MCD Application Team
+ * @brief   Host copy of the BMP file header structures (Utilities/CPU/bmp.h).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BMP_H
+#define BMP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+typedef struct __attribute__((packed)) {
+	uint16_t bfType;
+	uint32_t bfSize;
+	uint16_t bfReserved1;
+	uint16_t bfReserved2;
+	uint32_t bfOffBits;
+} BITMAPFILEHEADER;
+
+typedef struct __attribute__((packed)) {
+	uint32_t biSize;
+	int32_t biWidth;
+	int32_t biHeight;
+	int16_t biPlanes;
+	int16_t biBitCount;
+	uint32_t biCompression;
+	uint32_t biSizeImage;
+	int32_t biXPelsPerMeter;
+	int32_t biYPelsPerMeter;
+	uint32_t biClrUsed;
+	uint32_t biClrImportant;
+} BITMAPINFOHEADER;
+
+typedef struct __attribute__((packed)) {
+	BITMAPFILEHEADER fileHeader;
+	BITMAPINFOHEADER infoHeader;
+} BITMAPSTRUCT;
+
+#endif /* BMP_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file    lcd.h
+ * @author  MCD Application Team
+ * @brief   Host copy of the BSP LCD driver interface (Drivers/BSP/Components/
+ *          Common/lcd.h).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LCD_H
+#define LCD_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/**
+ * @brief  LCD driver structure definition
+ */
+typedef struct {
+	void     (*Init)(void);
+	uint32_t (*ReadID)(void);
+	void     (*DisplayOn)(void);
+	void     (*DisplayOff)(void);
+	void     (*SetCursor)(uint16_t, uint16_t);
+	void     (*WritePixel)(uint16_t, uint16_t, uint16_t);
+	uint16_t (*ReadPixel)(uint16_t, uint16_t);
+	void     (*SetDisplayWindow)(uint16_t, uint16_t, uint16_t, uint16_t);
+	void     (*DrawHLine)(uint16_t, uint16_t, uint16_t, uint16_t);
+	void     (*DrawVLine)(uint16_t, uint16_t, uint16_t, uint16_t);
+	uint16_t (*GetLcdPixelWidth)(void);
+	uint16_t (*GetLcdPixelHeight)(void);
+	void     (*DrawBitmap)(uint16_t, uint16_t, uint8_t*);
+	void     (*DrawRGBImage)(uint16_t, uint16_t, uint16_t, uint16_t, uint16_t*);
+	void     (*FillRect)(uint16_t, uint16_t, uint16_t, uint16_t, uint16_t);
+	void     (*ReadRGBImage)(uint16_t, uint16_t, uint16_t, uint16_t, uint16_t*);
+	void     (*Scroll)(int16_t, uint16_t, uint16_t);
+	void     (*UserCommand)(uint16_t, uint8_t*, uint32_t, uint8_t);
+} LCD_DrvTypeDef;
+
+#endif /* LCD_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,50 @@
+/**
+ ******************************************************************************
+ * @file    lcd_io.h
+ * @author  MCD Application Team
+ * @brief   Host copy of the lcd_io interface used by the st7796 driver, the
+ *          functions are implemented by the panel emulator (st7796_sim.c).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LCD_IO_H
+#define LCD_IO_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+void LCD_Delay(uint32_t delay);
+void LCD_IO_Bl_OnOff(uint8_t Bl);
+void LCD_IO_Init(void);
+
+void LCD_IO_WriteCmd8DataFill16(uint8_t Cmd, uint16_t Data, uint32_t Size);
+void LCD_IO_WriteCmd8MultipleData8(uint8_t Cmd, uint8_t *pData, uint32_t Size);
+void LCD_IO_WriteCmd8MultipleData16(uint8_t Cmd, uint16_t *pData, uint32_t Size);
+void LCD_IO_ReadCmd8MultipleData8(uint8_t Cmd, uint8_t *pData, uint32_t Size,
+		uint32_t DummySize);
+void LCD_IO_ReadCmd8MultipleData16(uint8_t Cmd, uint16_t *pData, uint32_t Size,
+		uint32_t DummySize);
+
+/* RGB565 data, 24 bit (RGB666 / RGB888) on the wire */
+void LCD_IO_WriteCmd8DataFill16to24(uint8_t Cmd, uint16_t Data, uint32_t Size);
+void LCD_IO_WriteCmd8MultipleData16to24(uint8_t Cmd, uint16_t *pData,
+		uint32_t Size);
+void LCD_IO_ReadCmd8MultipleData24to16(uint8_t Cmd, uint16_t *pData,
+		uint32_t Size, uint32_t DummySize);
+
+#endif /* LCD_IO_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,35 @@
+/**
+ ******************************************************************************
+ * @file    main.h
+ * @author  MCD Application Team
+ * @brief   Host replacement of the application main.h for building the st7796
+ *          driver against the panel emulator (st7796_sim.c).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MAIN_H
+#define MAIN_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* CMSIS intrinsics used by the driver */
+#define __REVSH(x) ((int16_t)((((uint16_t)(x)) >> 8) | (((uint16_t)(x)) << 8)))
+#define __DMB() __sync_synchronize()
+
+#endif /* MAIN_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
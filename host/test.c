@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    test.c
+ * @author  MCD Application Team
+ * @brief   Host test harness of the st7796 driver. It brings up the lcd_io
+ *          panel of the emulator (st7796_sim.c) in the configuration of
+ *          st7796.h, runs the tests of the program (TestRun) and counts the
+ *          checks. The Makefile builds every test program for several
+ *          configurations (st7796.h settings).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "main.h"
+#include "lcd.h"
+#include "st7796.h"
+#include "st7796_sim.h"
+#include "test.h"
+#if ST7796_ASYNC == 1
+#include "st7796_async.h"
+#endif
+#if ST7796_DLIST == 1
+#include "st7796_dlist.h"
+#endif
+
+extern LCD_DrvTypeDef st7796_drv;
+
+uint16_t testref[TEST_MAX * TEST_MAX];
+uint16_t testbuf[TEST_MAX * TEST_MAX];
+uint16_t testwork[2 * TEST_MAX];
+
+static uint32_t checks, fails;
+
+//-----------------------------------------------------------------------------
+void TestCheck(int Cond, const char *pText, int Line) {
+	checks++;
+	if (!Cond) {
+		fails++;
+		printf("  FAIL line %d: %s\n", Line, pText);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void Run(const char *pName, void (*pTest)(void)) {
+	uint32_t f = fails;
+	pTest();
+	printf("%-8s %s\n", pName, (f == fails) ? "ok" : "FAILED");
+}
+
+//-----------------------------------------------------------------------------
+uint16_t ScreenPixel(uint16_t Xpos, uint16_t Ypos) {
+	ST7796_Sync();
+	return ST7796_Sim_GetScreenPixel(Xpos, Ypos);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t ScreenDiff(const uint16_t *pRef) {
+	uint32_t x, y, n = 0;
+	ST7796_Sync();
+	for (y = 0; y < ST7796_SIZE_Y; y++)
+		for (x = 0; x < ST7796_SIZE_X; x++)
+			if (ST7796_Sim_GetScreenPixel(x, y) != pRef[y * ST7796_SIZE_X + x])
+				n++;
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+void RefFill(uint16_t *pRef, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode) {
+	uint32_t x, y;
+	for (y = Ypos; y < Ypos + Ysize; y++)
+		for (x = Xpos; x < Xpos + Xsize; x++)
+			pRef[y * ST7796_SIZE_X + x] = RGBCode;
+}
+
+//-----------------------------------------------------------------------------
+int main(void) {
+	srand(1);
+	ST7796_Sim_Reset();
+	st7796_drv.Init();
+#if ST7796_ASYNC == 1
+	ST7796_Sim_AsyncStart(20);
+#endif
+#if ST7796_DLIST == 1
+	ST7796_DListBegin();
+#endif
+
+	TestRun();
+
+#if ST7796_DLIST == 1
+	ST7796_DListEnd();
+#endif
+#if ST7796_ASYNC == 1
+	ST7796_Sim_AsyncStop();
+#endif
+	CHECK(ST7796_Sim_GetStat()->FormatErrors == 0);
+	printf("%u checks, %u failed\n", checks, fails);
+	return fails ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,63 @@
+/**
+ ******************************************************************************
+ * @file    test.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the host test harness. Every
+ *          test program (test_<name>.c) is linked with test.c, the driver,
+ *          the panel emulator and the modules it tests and defines TestRun.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "st7796.h"
+#include "st7796_reg.h"
+
+#define TEST_W           ST7796_LCD_PIXEL_WIDTH
+#define TEST_H           ST7796_LCD_PIXEL_HEIGHT
+#define TEST_MAX         ((TEST_W > TEST_H) ? TEST_W : TEST_H)
+
+#define CHECK(c)         TestCheck((c), #c, __LINE__)
+
+/* Work buffers of the tests: reference screen, readback and small buffer */
+extern uint16_t testref[TEST_MAX * TEST_MAX];
+extern uint16_t testbuf[TEST_MAX * TEST_MAX];
+extern uint16_t testwork[2 * TEST_MAX];
+
+//-----------------------------------------------------------------------------
+void TestCheck(int Cond, const char *pText, int Line);
+/* Run one test and print its result */
+void Run(const char *pName, void (*pTest)(void));
+
+/* The screen of the lcd_io panel, the queued / recorded primitives are sent
+   first */
+uint16_t ScreenPixel(uint16_t Xpos, uint16_t Ypos);
+/* Number of screen pixels different from the reference (ST7796_SIZE_X
+   pixels / row) */
+uint32_t ScreenDiff(const uint16_t *pRef);
+void RefFill(uint16_t *pRef, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode);
+
+/* Defined by the test program: the Run calls of its tests (the lcd_io panel
+   is initialized, the async transport is started and the display list is
+   recording when the configuration enables them) */
+void TestRun(void);
+
+#endif /* HOST_TEST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
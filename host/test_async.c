@@ -0,0 +1,90 @@
+/**
+ ******************************************************************************
+ * @file    test_async.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 asynchronous drawing API (ST7796_ASYNC == 1)
+ *          on the threaded transport of the emulator (st7796_sim_async.c).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_async.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+//-----------------------------------------------------------------------------
+static volatile uint8_t asyncorder[64];
+static volatile uint8_t asyncdone;
+
+static void AsyncDone(void *pParam) {
+	asyncorder[asyncdone++] = (uint8_t) (uintptr_t) pParam;
+}
+
+//-----------------------------------------------------------------------------
+/* Banded ping-pong image jobs, a fill and streamed windows complete in the
+   queue order and check out pixel for pixel */
+static void TestAsync(void) {
+	static uint16_t band[2][TEST_MAX * 16];
+	static uint16_t chunk[16];
+	uint16_t *p;
+	uint32_t i, n, h = (ST7796_SIZE_Y - 8) / 30, w = ST7796_SIZE_X, bad = 0;
+	ST7796_Sync();
+	asyncdone = 0;
+	ST7796_AsyncSetBuffers(band[0], band[1]);
+	for (n = 0; n < 30; n++) {
+		p = ST7796_AsyncGetBuffer();
+		for (i = 0; i < w * h; i++)
+			p[i] = testref[n * w * h + i] = (uint16_t) rand();
+		ST7796_DrawRGBImageAsync(0, n * h, w, h, p, AsyncDone, (void *) (uintptr_t) n);
+	}
+	ST7796_FillRectAsync(0, 30 * h, w, ST7796_SIZE_Y - 30 * h, 0x1234, AsyncDone,
+			(void *) 30);
+	RefFill(testref, 0, 30 * h, w, ST7796_SIZE_Y - 30 * h, 0x1234);
+
+	/* window, then pixels continuing each other */
+	for (i = 0; i < 16; i++)
+		chunk[i] = (uint16_t) rand();
+	ST7796_SetWriteWindowAsync(10, 10, 8, 4);
+	ST7796_WriteRGBAsync(chunk, 16, AsyncDone, (void *) 31);
+	ST7796_WriteFillAsync(0xF800, 16, AsyncDone, (void *) 32);
+	for (i = 0; i < 16; i++)
+		testref[(10 + i / 8) * w + 10 + i % 8] = chunk[i];
+	RefFill(testref, 10, 12, 8, 2, 0xF800);
+	CHECK(ScreenDiff(testref) == 0);
+
+	/* the same window again: no window command, the pixels restart at the
+	   window origin */
+	ST7796_SetWriteWindowAsync(10, 10, 8, 4);
+	ST7796_WriteFillAsync(0x07E0, 16, AsyncDone, (void *) 33);
+	RefFill(testref, 10, 10, 8, 2, 0x07E0);
+	CHECK(ScreenDiff(testref) == 0);
+
+	/* the queue is empty before the last callback returns */
+	for (i = 0; (asyncdone < 34) && (i < 100000000); i++);
+	CHECK(asyncdone == 34);
+	for (i = 0; i < asyncdone; i++)
+		if (asyncorder[i] != i)
+			bad++;
+	CHECK(bad == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("async", TestAsync);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
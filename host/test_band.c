@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file    test_band.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 band renderer: a full screen render is
+ *          compared with a reference and the windows of the single buffer
+ *          path are counted.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_band.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define IMG_W            60
+#define IMG_H            30
+
+static uint16_t bands[2][TEST_MAX * ST7796_BAND_LINES];
+static uint16_t img[IMG_W * IMG_H];
+static uint32_t bandcnt;
+
+//-----------------------------------------------------------------------------
+static uint16_t BandPattern(uint32_t X, uint32_t Y) {
+	return (uint16_t) (X * 7 + Y * 13 + ((X ^ Y) << 8));
+}
+
+//-----------------------------------------------------------------------------
+/* Background pattern, a rectangle over several bands and an image clipped
+   at the right and bottom edge */
+static void BandDraw(const ST7796_BandTypeDef *pBand, void *pParam) {
+	uint32_t x, y;
+	(void) pParam;
+	for (y = 0; y < pBand->Lines; y++)
+		for (x = 0; x < ST7796_SIZE_X; x++)
+			pBand->pBuffer[y * ST7796_SIZE_X + x] = BandPattern(x, pBand->Ypos + y);
+	ST7796_BandFillRect(pBand, 50, 10, 100, 40, 0xF800);
+	ST7796_BandDrawRGBImage(pBand, ST7796_SIZE_X - IMG_W / 2,
+			ST7796_SIZE_Y - IMG_H / 2, IMG_W, IMG_H, img);
+	bandcnt++;
+}
+
+//-----------------------------------------------------------------------------
+static void BandRef(void) {
+	uint32_t x, y;
+	for (y = 0; y < ST7796_SIZE_Y; y++)
+		for (x = 0; x < ST7796_SIZE_X; x++)
+			testref[y * ST7796_SIZE_X + x] = BandPattern(x, y);
+	RefFill(testref, 50, 10, 100, 40, 0xF800);
+	for (y = 0; y < IMG_H / 2; y++)
+		for (x = 0; x < IMG_W / 2; x++)
+			testref[(ST7796_SIZE_Y - IMG_H / 2 + y) * ST7796_SIZE_X
+					+ ST7796_SIZE_X - IMG_W / 2 + x] = img[y * IMG_W + x];
+}
+
+//-----------------------------------------------------------------------------
+/* One buffer: one window for the screen, RAMWR then RAMWRC / band */
+static void TestBandSingle(void) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	uint32_t i, caset, raset, ramwr, ramwrc;
+	uint32_t n = (ST7796_SIZE_Y + ST7796_BAND_LINES - 1) / ST7796_BAND_LINES;
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		img[i] = (uint16_t) rand();
+	BandRef();
+	/* another window before the frame */
+	ST7796_WritePixel(3, 3, 0);
+	ST7796_Sync();
+	caset = s->CmdCnt[ST7796_CASET];
+	raset = s->CmdCnt[ST7796_RASET];
+	ramwr = s->CmdCnt[ST7796_WRITE_RAM];
+	ramwrc = s->CmdCnt[ST7796_WRITE_RAM_CONT];
+	bandcnt = 0;
+	ST7796_BandInit(bands[0], NULL);
+	ST7796_BandRender(BandDraw, NULL);
+	CHECK(bandcnt == n);
+	CHECK(s->CmdCnt[ST7796_CASET] - caset == 1);
+	CHECK(s->CmdCnt[ST7796_RASET] - raset == 1);
+	CHECK(s->CmdCnt[ST7796_WRITE_RAM] - ramwr == 1);
+#if ST7796_WRITEBITDEPTH == 16
+	CHECK(s->CmdCnt[ST7796_WRITE_RAM_CONT] - ramwrc == n - 1);
+#else
+	/* the lcd_io adapter sends the converted pixels in more transactions */
+	CHECK(s->CmdCnt[ST7796_WRITE_RAM_CONT] - ramwrc >= n - 1);
+#endif
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+#if ST7796_ASYNC == 1
+//-----------------------------------------------------------------------------
+/* Two buffers: the bands are queued while the next one is rendered */
+static void TestBandDouble(void) {
+	uint32_t i;
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		img[i] = (uint16_t) rand();
+	BandRef();
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	bandcnt = 0;
+	ST7796_BandInit(bands[0], bands[1]);
+	ST7796_BandRender(BandDraw, NULL);
+	CHECK(bandcnt == (ST7796_SIZE_Y + ST7796_BAND_LINES - 1) / ST7796_BAND_LINES);
+	CHECK(ScreenDiff(testref) == 0);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("band", TestBandSingle);
+#if ST7796_ASYNC == 1
+	Run("band2", TestBandDouble);
+#endif
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    test_blend.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 alpha blending: translucent rectangles and
+ *          ARGB8888 images are drawn over the screen content and compared
+ *          with the reference blend kernels of st7796_conv.c.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_conv.h"
+#include "st7796_blend.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define IMG_W            40
+#define IMG_H            30
+
+static uint32_t img[IMG_W * IMG_H];
+
+//-----------------------------------------------------------------------------
+/* Random screen and reference */
+static void BlendBackground(void) {
+	uint32_t i;
+	for (i = 0; i < ST7796_SIZE_X * ST7796_SIZE_Y; i++)
+		testref[i] = (uint16_t) rand();
+	ST7796_DrawRGBImage(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, testref);
+}
+
+//-----------------------------------------------------------------------------
+/* Opaque and transparent rectangles, a zero size buffer draws nothing (and
+   does not hang) */
+static void TestBlendLimits(void) {
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_BlendInit(testwork, sizeof(testwork) / 2);
+	ST7796_FillRectAlpha(10, 10, 20, 20, 0xFFFF, 255);
+	ST7796_FillRectAlpha(40, 10, 20, 20, 0xFFFF, 0);
+	CHECK(ScreenPixel(15, 15) == 0xFFFF);
+	CHECK(ScreenPixel(45, 15) == 0x0000);
+	ST7796_BlendInit(testwork, 0);
+	ST7796_FillRectAlpha(70, 10, 20, 20, 0xFFFF, 128);
+	CHECK(ScreenPixel(75, 15) == 0x0000);
+}
+
+//-----------------------------------------------------------------------------
+/* Translucent rectangles over a random screen with a buffer of several rows
+   and with a buffer shorter than a row (column stripes), one clipped at the
+   right and bottom edge */
+static void TestBlendFill(void) {
+	uint16_t y;
+	BlendBackground();
+	ST7796_BlendInit(testwork, sizeof(testwork) / 2);
+	ST7796_FillRectAlpha(10, 20, 100, 50, 0x07E0, 100);
+	for (y = 20; y < 70; y++)
+		ST7796_BlendColor_Ref(0x07E0, 100, &testref[y * ST7796_SIZE_X + 10], 100);
+	ST7796_BlendInit(testwork, 7);
+	ST7796_FillRectAlpha(ST7796_SIZE_X - 30, ST7796_SIZE_Y - 20, 50, 40, 0xF81F, 200);
+	for (y = ST7796_SIZE_Y - 20; y < ST7796_SIZE_Y; y++)
+		ST7796_BlendColor_Ref(0xF81F, 200, &testref[y * ST7796_SIZE_X + ST7796_SIZE_X - 30], 30);
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* ARGB8888 images with random alpha (opaque and transparent pixels too) */
+static void TestBlendImage(void) {
+	uint32_t i;
+	uint16_t y, x0 = 50, y0 = 100;
+	for (i = 0; i < IMG_W * IMG_H; i++) {
+		img[i] = ((uint32_t) rand() << 16) ^ (uint32_t) rand();
+		if (i % 7 == 0)
+			img[i] |= 0xFF000000;
+		else if (i % 7 == 1)
+			img[i] &= 0x00FFFFFF;
+	}
+	BlendBackground();
+	ST7796_BlendInit(testwork, sizeof(testwork) / 2);
+	ST7796_BlendRGBAImage(x0, y0, IMG_W, IMG_H, img);
+	for (y = 0; y < IMG_H; y++)
+		ST7796_BlendARGB8888_Ref(&img[y * IMG_W],
+				&testref[(y0 + y) * ST7796_SIZE_X + x0], IMG_W);
+	ST7796_BlendInit(testwork, 16);
+	x0 = ST7796_SIZE_X - 25;
+	y0 = ST7796_SIZE_Y - 10;
+	ST7796_BlendRGBAImage(x0, y0, IMG_W, IMG_H, img);
+	for (y = 0; y < 10; y++)
+		ST7796_BlendARGB8888_Ref(&img[y * IMG_W],
+				&testref[(y0 + y) * ST7796_SIZE_X + x0], 25);
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("blendlim", TestBlendLimits);
+	Run("blend", TestBlendFill);
+	Run("blendimg", TestBlendImage);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
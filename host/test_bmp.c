@@ -0,0 +1,267 @@
+/**
+ ******************************************************************************
+ * @file    test_bmp.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 streaming BMP decoder: files of every
+ *          supported pixel format are built in memory, drawn through
+ *          ST7796_BmpMemoryRead and compared with a reference.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_bmp.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define BMP_W            37            /* odd width: every format has row padding */
+#define BMP_H            23
+#define BMP_555          15            /* bpp parameter: 16 bit RGB555 (BI_RGB) */
+
+static uint8_t bmpfile[8192];
+static uint32_t bmpsize;
+static uint32_t bmppal[256];           /* 0x00RRGGBB */
+static uint32_t bmppix[BMP_W * BMP_H]; /* palette index, 16 bit code or 0x00RRGGBB */
+
+//-----------------------------------------------------------------------------
+static void BmpPut(uint32_t Pos, uint32_t Data, uint8_t Size) {
+	while (Size--) {
+		bmpfile[Pos++] = Data & 0xFF;
+		Data >>= 8;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* A color which is exact in RGB565 (not changed by the dithering) */
+static uint32_t BmpExact(void) {
+	return ((rand() & 0xF8) << 16) | ((rand() & 0xFC) << 8) | (rand() & 0xF8);
+}
+
+//-----------------------------------------------------------------------------
+static uint16_t BmpTo565(uint32_t Rgb) {
+	return ((Rgb >> 8) & 0xF800) | ((Rgb >> 5) & 0x07E0) | ((Rgb >> 3) & 0x001F);
+}
+
+//-----------------------------------------------------------------------------
+/* Build a Width * |Height| file from bmppix (and bmppal), Height < 0:
+   top-down rows, Gap: unused bytes before the pixels */
+static void BmpBuild(uint16_t Bpp, int32_t Width, int32_t Height,
+		uint32_t Colors, uint32_t Gap) {
+	uint16_t bits = (Bpp == BMP_555) ? 16 : Bpp;
+	uint32_t h = (Height < 0) ? -Height : Height, masks = (Bpp == 16) ? 12 : 0;
+	uint32_t pitch = ((Width * bits + 31) / 32) * 4, off, x, y, r, p, v;
+	memset(bmpfile, 0xEE, sizeof(bmpfile));
+	off = 14 + 40 + masks + Colors * 4 + Gap;
+	bmpsize = off + pitch * h;
+	bmpfile[0] = 'B';
+	bmpfile[1] = 'M';
+	BmpPut(2, bmpsize, 4);
+	BmpPut(6, 0, 4);
+	BmpPut(10, off, 4);
+	BmpPut(14, 40, 4);
+	BmpPut(18, Width, 4);
+	BmpPut(22, Height, 4);
+	BmpPut(26, 1, 2);
+	BmpPut(28, bits, 2);
+	BmpPut(30, masks ? 3 : 0, 4);
+	BmpPut(34, pitch * h, 4);
+	BmpPut(38, 2835, 4);
+	BmpPut(42, 2835, 4);
+	BmpPut(46, (Bpp <= 8) ? Colors : 0, 4);
+	BmpPut(50, 0, 4);
+	if (masks) {
+		BmpPut(54, 0xF800, 4);
+		BmpPut(58, 0x07E0, 4);
+		BmpPut(62, 0x001F, 4);
+	}
+	for (x = 0; x < Colors; x++)
+		BmpPut(54 + masks + x * 4, bmppal[x], 4);
+	for (y = 0; y < h; y++) {
+		/* bottom-up: the first row of the file is the last image row */
+		r = off + pitch * ((Height < 0) ? y : h - 1 - y);
+		memset(&bmpfile[r], 0, pitch);
+		for (x = 0; x < (uint32_t) Width; x++) {
+			v = bmppix[y * Width + x];
+			switch (bits) {
+			case 1:
+				bmpfile[r + x / 8] |= v << (7 - (x & 7));
+				break;
+			case 4:
+				bmpfile[r + x / 2] |= v << ((x & 1) ? 0 : 4);
+				break;
+			case 8:
+				bmpfile[r + x] = v;
+				break;
+			case 16:
+				BmpPut(r + x * 2, v, 2);
+				break;
+			case 24:
+				BmpPut(r + x * 3, v, 3);
+				break;
+			default:
+				BmpPut(r + x * 4, v | 0xFF000000, 4);
+				break;
+			}
+		}
+		/* the padding is not drawn */
+		for (p = (Width * bits + 7) / 8; p < pitch; p++)
+			bmpfile[r + p] = 0xA5;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Random pixels of a format and their RGB565 reference (testbuf) */
+static void BmpPixels(uint16_t Bpp, uint32_t Colors) {
+	uint32_t i, v, g;
+	for (i = 0; i < Colors; i++)
+		bmppal[i] = BmpExact();
+	for (i = 0; i < BMP_W * BMP_H; i++) {
+		switch (Bpp) {
+		case 16:
+			v = (uint16_t) rand();
+			testbuf[i] = v;
+			break;
+		case BMP_555:
+			v = rand() & 0x7FFF;
+			g = (v >> 5) & 0x1F;
+			testbuf[i] = ((v >> 10) << 11) | (((g << 1) | (g >> 4)) << 5) | (v & 0x1F);
+			break;
+		case 24:
+		case 32:
+			v = BmpExact();
+			testbuf[i] = BmpTo565(v);
+			break;
+		default:
+			v = rand() % Colors;
+			testbuf[i] = BmpTo565(bmppal[v]);
+			break;
+		}
+		bmppix[i] = v;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Draw the file at Xpos, Ypos on a black screen, retval the number of pixels
+   different from the reference */
+static uint32_t BmpDraw(uint16_t Xpos, uint16_t Ypos, int32_t Width,
+		int32_t Height) {
+	ST7796_BmpMemoryTypeDef mem = { bmpfile, 0, 0 };
+	uint32_t x, y, h = (Height < 0) ? -Height : Height;
+	mem.Size = bmpsize;
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	memset(testref, 0, sizeof(testref));
+	for (y = 0; y < h; y++)
+		for (x = 0; x < (uint32_t) Width; x++)
+			if ((Xpos + x < ST7796_SIZE_X) && (Ypos + y < ST7796_SIZE_Y))
+				testref[(Ypos + y) * ST7796_SIZE_X + Xpos + x] = testbuf[y * Width + x];
+	CHECK(ST7796_DrawBmpStream(Xpos, Ypos, ST7796_BmpMemoryRead, &mem) == ST7796_BMP_OK);
+	return ScreenDiff(testref);
+}
+
+//-----------------------------------------------------------------------------
+/* Every pixel format, bottom-up and top-down */
+static void TestBmpFormats(void) {
+	static const uint16_t bpp[] = { 1, 4, 8, 16, BMP_555, 24, 32 };
+	uint32_t i, colors;
+	int32_t dir;
+	for (i = 0; i < sizeof(bpp) / sizeof(bpp[0]); i++)
+		for (dir = 1; dir >= -1; dir -= 2) {
+			/* the 8 bit palette is shorter than 256 entries */
+			colors = (bpp[i] <= 4) ? 1U << bpp[i] : (bpp[i] == 8) ? 100 : 0;
+			BmpPixels(bpp[i], colors);
+			BmpBuild(bpp[i], BMP_W, dir * BMP_H, colors, (i & 1) * 6);
+			CHECK(BmpDraw(20, 30, BMP_W, dir * BMP_H) == 0);
+		}
+}
+
+//-----------------------------------------------------------------------------
+/* Clipped at the right and bottom screen edge */
+static void TestBmpClip(void) {
+	int32_t dir;
+	for (dir = 1; dir >= -1; dir -= 2) {
+		BmpPixels(24, 0);
+		BmpBuild(24, BMP_W, dir * BMP_H, 0, 0);
+		CHECK(BmpDraw(ST7796_SIZE_X - 10, ST7796_SIZE_Y - 7, BMP_W, dir * BMP_H) == 0);
+		BmpPixels(4, 16);
+		BmpBuild(4, BMP_W, dir * BMP_H, 16, 0);
+		CHECK(BmpDraw(ST7796_SIZE_X - 11, ST7796_SIZE_Y - 5, BMP_W, dir * BMP_H) == 0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void TestBmpErrors(void) {
+	ST7796_BmpMemoryTypeDef mem = { bmpfile, 0, 0 };
+	BmpPixels(8, 256);
+	BmpBuild(8, BMP_W, BMP_H, 256, 0);
+	/* truncated in the pixels */
+	mem.Size = bmpsize - 100;
+	CHECK(ST7796_DrawBmpStream(0, 0, ST7796_BmpMemoryRead, &mem) == ST7796_BMP_ERROR_READ);
+	/* RLE8 */
+	BmpPut(30, 1, 4);
+	mem.Pos = 0;
+	mem.Size = bmpsize;
+	CHECK(ST7796_DrawBmpStream(0, 0, ST7796_BmpMemoryRead, &mem) == ST7796_BMP_ERROR_FORMAT);
+	bmpfile[1] = 'X';
+	mem.Pos = 0;
+	CHECK(ST7796_DrawBmpStream(0, 0, ST7796_BmpMemoryRead, &mem) == ST7796_BMP_ERROR_FORMAT);
+}
+
+//-----------------------------------------------------------------------------
+/* A flat color between the RGB565 levels: without dithering it is cut to the
+   lower level, with the 4 * 4 ordered dithering every screen aligned 4 * 4
+   block has the average of the color */
+static void TestBmpColor(void) {
+	const uint32_t rgb = 0x848242;       /* 132, 130, 66 */
+	uint32_t i;
+	for (i = 0; i < BMP_W * BMP_H; i++) {
+		bmppix[i] = rgb;
+		testbuf[i] = BmpTo565(rgb);
+	}
+	BmpBuild(24, BMP_W, BMP_H, 0, 0);
+#if ST7796_BMP_DITHER == 0
+	CHECK(BmpDraw(20, 30, BMP_W, BMP_H) == 0);
+#else
+	uint32_t x, y, bx, by, r, g, b, bad = 0;
+	uint16_t c;
+	CHECK(BmpDraw(20, 30, BMP_W, BMP_H) > 0);
+	for (by = 32; by + 4 <= 30 + BMP_H; by += 4)
+		for (bx = 20; bx + 4 <= 20 + BMP_W; bx += 4) {
+			r = g = b = 0;
+			for (y = by; y < by + 4; y++)
+				for (x = bx; x < bx + 4; x++) {
+					c = ScreenPixel(x, y);
+					r += (c >> 8) & 0xF8;
+					g += (c >> 3) & 0xFC;
+					b += (c << 3) & 0xF8;
+				}
+			if ((r != 132 * 16) || (g != 130 * 16) || (b != 66 * 16))
+				bad++;
+		}
+	CHECK(bad == 0);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("bmp", TestBmpFormats);
+	Run("bmpclip", TestBmpClip);
+	Run("bmperr", TestBmpErrors);
+	Run("bmpcolor", TestBmpColor);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
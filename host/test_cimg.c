@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @file    test_cimg.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 compressed image format: images encoded by
+ *          ST7796_CImgEncode are drawn by ST7796_DrawCompressedImage and
+ *          compared pixel by pixel with the source.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_cimg.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define IMG_X            10
+#define IMG_Y            20
+#define IMG_W            100
+#define IMG_H            80
+
+static uint16_t img[IMG_W * IMG_H];
+static uint8_t enc[IMG_W * IMG_H * 3];
+static uint32_t ops[4];                /* ops of the encoded images / type */
+
+//-----------------------------------------------------------------------------
+/* Count the ops of an encoded image */
+static void CImgOps(const uint8_t *p, uint32_t Size) {
+	const uint8_t *e = p + Size;
+	uint8_t op;
+	for (p += ST7796_CIMG_HEADER; p < e;) {
+		op = *p++;
+		ops[op >> 6]++;
+		if ((op & ST7796_CIMG_OP_MASK) == ST7796_CIMG_OP_LITERAL)
+			p += ((op & 0x3F) + 1) * 2;
+		else if (op == (ST7796_CIMG_OP_RUN | ST7796_CIMG_RUN_EXT))
+			p += 2;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Encode, draw and compare a Xsize * Ysize image (img), retval the number of
+   pixel transactions of the drawing */
+static uint32_t CImgRoundTrip(uint16_t Xsize, uint16_t Ysize) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	uint32_t x, y, size, bad = 0, cmds;
+	size = ST7796_CImgEncode(img, Xsize, Ysize, enc, sizeof(enc));
+	CHECK(size <= sizeof(enc));
+	CImgOps(enc, size);
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_Sync();
+	cmds = s->CmdCnt[ST7796_WRITE_RAM] + s->CmdCnt[ST7796_WRITE_RAM_CONT];
+	CHECK(ST7796_DrawCompressedImage(IMG_X, IMG_Y, enc) == 0);
+	for (y = 0; y < Ysize; y++)
+		for (x = 0; x < Xsize; x++)
+			if (ScreenPixel(IMG_X + x, IMG_Y + y) != img[y * Xsize + x])
+				bad++;
+	CHECK(bad == 0);
+	CHECK(ScreenPixel(IMG_X + Xsize, IMG_Y) == 0x0000);
+	CHECK(ScreenPixel(IMG_X, IMG_Y + Ysize) == 0x0000);
+	return s->CmdCnt[ST7796_WRITE_RAM] + s->CmdCnt[ST7796_WRITE_RAM_CONT] - cmds;
+}
+
+//-----------------------------------------------------------------------------
+/* Noise (literals), flat (one long run) and gradient (diffs, runs and the
+   color cache at the row starts) images */
+static void TestCImgImages(void) {
+	uint32_t i, x, y;
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		img[i] = (uint16_t) rand();
+	CImgRoundTrip(IMG_W, IMG_H);
+
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		img[i] = 0x5AA5;
+	/* the first pixel, then one fill for the rest of the image (the 24 bit
+	   lcd_io adapter sends a long fill in more transactions) */
+#if ST7796_WRITEBITDEPTH == 16
+	CHECK(CImgRoundTrip(IMG_W, IMG_H) == 2);
+#else
+	CImgRoundTrip(IMG_W, IMG_H);
+#endif
+
+	for (y = 0; y < IMG_H; y++)
+		for (x = 0; x < IMG_W; x++)
+			img[y * IMG_W + x] = ((x * 31 / IMG_W) << 11)
+					| ((y * 63 / IMG_H) << 5) | (x / 8);
+	CImgRoundTrip(IMG_W, IMG_H);
+
+	CHECK(ops[ST7796_CIMG_OP_INDEX >> 6] > 0);
+	CHECK(ops[ST7796_CIMG_OP_DIFF >> 6] > 0);
+	CHECK(ops[ST7796_CIMG_OP_RUN >> 6] > 0);
+	CHECK(ops[ST7796_CIMG_OP_LITERAL >> 6] > 0);
+}
+
+//-----------------------------------------------------------------------------
+/* A run is sent as a fill from ST7796_CIMG_MINFILL pixels, a shorter one
+   continues the decoded pixels */
+static void TestCImgMinFill(void) {
+	uint32_t i;
+	for (i = 0; i < 10; i++)
+		img[i] = (uint16_t) rand() | 1;
+	for (; i < 10 + ST7796_CIMG_MINFILL - 1; i++)
+		img[i] = img[9];
+	CHECK(CImgRoundTrip(10 + ST7796_CIMG_MINFILL - 1, 1) == 1);
+	img[i] = img[9];
+	CHECK(CImgRoundTrip(10 + ST7796_CIMG_MINFILL, 1) == 2);
+}
+
+//-----------------------------------------------------------------------------
+static void TestCImgBad(void) {
+	static const uint8_t bad[] = { 'S', '7', 'C', 'X', 1, 0, 1, 0, 0 };
+	/* a run longer than the image */
+	static const uint8_t longrun[] = { 'S', '7', 'C', 'I', 4, 0, 1, 0,
+			ST7796_CIMG_OP_RUN | 7 };
+	CHECK(ST7796_DrawCompressedImage(0, 0, bad) == 1);
+	CHECK(ST7796_DrawCompressedImage(0, 0, longrun) == 1);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("cimg", TestCImgImages);
+	Run("cimgfill", TestCImgMinFill);
+	Run("cimgbad", TestCImgBad);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
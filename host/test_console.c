@@ -0,0 +1,189 @@
+/**
+ ******************************************************************************
+ * @file    test_console.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 text console: more lines than the console
+ *          area are written between a fixed header and footer, the screen
+ *          is compared with the expected text and the cost of a new line is
+ *          counted in the command log of the emulator.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_console.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define CON_W            8
+#define CON_H            12            /* the console area is not a multiple of it */
+#define CON_TOP          20
+#define CON_BOTTOM       30
+#define CON_AREA         (ST7796_SIZE_Y - CON_TOP - CON_BOTTOM)
+#define CON_COLS         (ST7796_SIZE_X / CON_W)
+#define CON_LINES        160
+#define CON_TEXT         0xFFE0
+#define CON_BACK         0x0010
+
+static uint8_t contable[95 * CON_H];
+static const ST7796_ConsoleFontTypeDef confont = { contable, CON_W, CON_H };
+static char conlines[CON_LINES][TEST_MAX / CON_W + 1]; /* the lines of the screen */
+static uint32_t concount;
+
+//-----------------------------------------------------------------------------
+/* A font with a different pattern in every row of every character */
+static void ConFont(void) {
+	uint32_t c, r;
+	for (c = 0; c < 95; c++)
+		for (r = 0; r < CON_H; r++)
+			contable[c * CON_H + r] = (uint8_t) ((c * 73 + r * 29) ^ (c << 3));
+}
+
+//-----------------------------------------------------------------------------
+/* Font row Row of a text into the reference row Ypos from Xpos, the rest of
+   Xsize pixels is background */
+static void ConRefRow(uint16_t Xpos, uint16_t Ypos, const char *pText,
+		uint16_t Row, uint16_t Xsize) {
+	uint16_t *p = &testref[Ypos * ST7796_SIZE_X + Xpos];
+	uint32_t x, b;
+	uint8_t bits;
+	for (x = 0; x < Xsize; x++)
+		p[x] = CON_BACK;
+	for (x = 0; pText[x] && ((x + 1) * CON_W <= Xsize); x++) {
+		bits = contable[(pText[x] - ' ') * CON_H + Row];
+		for (b = 0; b < CON_W; b++)
+			if (bits & (0x80 >> b))
+				p[x * CON_W + b] = CON_TEXT;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Write a text to the console and to the line list (wrapped at CON_COLS) */
+static void ConPuts(const char *pText) {
+	uint32_t len = strlen(pText), n;
+	ST7796_ConsolePuts(pText);
+	/* the texts end with '\n' */
+	for (len--; len; len -= n, pText += n) {
+		n = (len > CON_COLS) ? CON_COLS : len;
+		memcpy(conlines[concount], pText, n);
+		conlines[concount++][n] = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* The reference console area: portrait orientation, the newest line is at
+   the bottom and the older lines are above it; landscape orientation, the
+   lines wrap to the first line and the line after the newest is empty */
+static void ConRef(void) {
+	uint32_t s, k, top, slots = CON_AREA / CON_H, j, newest;
+	int32_t i;
+	for (s = 0; s < CON_AREA; s++) {
+		if (ST7796_SIZE_Y == ST7796_LCD_PIXEL_HEIGHT) {
+			top = (concount * CON_H <= CON_AREA) ?
+					(concount - 1) * CON_H : CON_AREA - CON_H;
+			k = (s < top) ? (top - s + CON_H - 1) / CON_H : 0;
+			i = concount - 1 - k;
+			if ((s < top + CON_H) && (i >= 0)) {
+				ConRefRow(0, CON_TOP + s, conlines[i], s + k * CON_H - top,
+						ST7796_SIZE_X);
+				continue;
+			}
+		} else if (s < slots * CON_H) {
+			j = s / CON_H;
+			newest = (concount - 1) % slots;
+			i = concount - 1 - (newest + slots - j) % slots;
+			if ((j != (newest + 1) % slots) && (i >= 0)) {
+				ConRefRow(0, CON_TOP + s, conlines[i], s % CON_H, ST7796_SIZE_X);
+				continue;
+			}
+		}
+		RefFill(testref, 0, CON_TOP + s, ST7796_SIZE_X, 1, CON_BACK);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Header, footer and more lines than the console area (short lines and
+   lines wrapped at the screen width) */
+static void TestConsoleLines(void) {
+	char text[2 * TEST_MAX / CON_W];
+	uint32_t i, r;
+	ConFont();
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	memset(testref, 0, sizeof(testref));
+	ST7796_ConsoleInit(CON_TOP, CON_BOTTOM, &confont, CON_TEXT, CON_BACK);
+	ST7796_ConsoleDrawText(4, 4, "HEADER");
+	ST7796_ConsoleDrawText(4, ST7796_SIZE_Y - CON_BOTTOM + 6, "FOOTER");
+	for (r = 0; r < CON_H; r++) {
+		ConRefRow(4, 4 + r, "HEADER", r, 6 * CON_W);
+		ConRefRow(4, ST7796_SIZE_Y - CON_BOTTOM + 6 + r, "FOOTER", r, 6 * CON_W);
+	}
+	for (i = 0; concount < CON_LINES - 2; i++) {
+		if (i % 9 == 8) {
+			memset(text, 'a' + i % 26, CON_COLS + 5);
+			text[CON_COLS + 5] = 0;
+			strcat(text, "\n");
+		} else
+			snprintf(text, sizeof(text), "line %u\n", (unsigned) i);
+		ConPuts(text);
+		if (concount == CON_AREA / CON_H) {
+			/* the console area is full */
+			ConRef();
+			CHECK(ScreenDiff(testref) == 0);
+		}
+	}
+	ConRef();
+	CHECK(ScreenDiff(testref) == 0);
+	CHECK(ST7796_ConsoleMapRow(CON_TOP - 1) == CON_TOP - 1);
+	CHECK(ST7796_ConsoleMapRow(CON_TOP + CON_AREA) == CON_TOP + CON_AREA);
+}
+
+//-----------------------------------------------------------------------------
+/* A new line of the full console: one band of characters and one scroll
+   address (landscape: the band and the cleared line after it) */
+static void TestConsoleCost(void) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	uint32_t vscrdef, vscrsadd, ramwr, pixels;
+	ST7796_Sync();
+	vscrdef = s->CmdCnt[ST7796_VERT_SCROLLING_DEF];
+	vscrsadd = s->CmdCnt[ST7796_VERT_SCROLLING_ADDR];
+	ramwr = s->CmdCnt[ST7796_WRITE_RAM];
+	pixels = s->WrPixels;
+	ConPuts("one more line\n");
+	ST7796_Sync();
+	CHECK(s->CmdCnt[ST7796_VERT_SCROLLING_DEF] == vscrdef);
+	if (ST7796_SIZE_Y == ST7796_LCD_PIXEL_HEIGHT) {
+		CHECK(s->CmdCnt[ST7796_VERT_SCROLLING_ADDR] - vscrsadd == 1);
+		CHECK(s->WrPixels - pixels == ST7796_SIZE_X * CON_H);
+		/* a second window when the line crosses the GRAM end */
+		CHECK(s->CmdCnt[ST7796_WRITE_RAM] - ramwr >= 1);
+		CHECK(s->CmdCnt[ST7796_WRITE_RAM] - ramwr <= 2);
+	} else {
+		CHECK(s->CmdCnt[ST7796_VERT_SCROLLING_ADDR] == vscrsadd);
+		CHECK(s->WrPixels - pixels == 2 * ST7796_SIZE_X * CON_H);
+	}
+	ConRef();
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("conlines", TestConsoleLines);
+	Run("concost", TestConsoleCost);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
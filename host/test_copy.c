@@ -0,0 +1,97 @@
+/**
+ ******************************************************************************
+ * @file    test_copy.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 rectangle copy: overlapping copies in every
+ *          direction with large and small buffers are compared with the
+ *          screen content moved by the CPU.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_copy.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+//-----------------------------------------------------------------------------
+/* Random screen and reference */
+static void CopyBackground(void) {
+	uint32_t i;
+	for (i = 0; i < ST7796_SIZE_X * ST7796_SIZE_Y; i++)
+		testref[i] = (uint16_t) rand();
+	ST7796_DrawRGBImage(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, testref);
+}
+
+//-----------------------------------------------------------------------------
+/* Copy on the screen and move the reference (the source is read completely
+   before the destination is written, clipped at the screen edge) */
+static void CopyRect(uint16_t Xsrc, uint16_t Ysrc, uint16_t Xdst, uint16_t Ydst,
+		uint16_t Xsize, uint16_t Ysize) {
+	uint32_t y, w = Xsize, h = Ysize;
+	ST7796_CopyRect(Xsrc, Ysrc, Xdst, Ydst, Xsize, Ysize);
+	if (w > ST7796_SIZE_X - ((Xsrc > Xdst) ? Xsrc : Xdst))
+		w = ST7796_SIZE_X - ((Xsrc > Xdst) ? Xsrc : Xdst);
+	if (h > ST7796_SIZE_Y - ((Ysrc > Ydst) ? Ysrc : Ydst))
+		h = ST7796_SIZE_Y - ((Ysrc > Ydst) ? Ysrc : Ydst);
+	for (y = 0; y < h; y++)
+		memcpy(&testbuf[y * w], &testref[(Ysrc + y) * ST7796_SIZE_X + Xsrc], w * 2);
+	for (y = 0; y < h; y++)
+		memcpy(&testref[(Ydst + y) * ST7796_SIZE_X + Xdst], &testbuf[y * w], w * 2);
+}
+
+//-----------------------------------------------------------------------------
+/* Overlapping copies in the 4 diagonal directions, with a buffer of several
+   rows and with a buffer shorter than a row (column stripes) */
+static void TestCopyOverlap(void) {
+	static const uint32_t size[] = { 2 * TEST_MAX, 13 };
+	uint8_t i;
+	CopyBackground();
+	for (i = 0; i < 2; i++) {
+		ST7796_CopyInit(testwork, size[i]);
+		CopyRect(10, 10, 30, 25, 100, 80);
+		CopyRect(40, 50, 25, 35, 90, 70);
+		CopyRect(150, 20, 160, 5, 60, 50);
+		CopyRect(160, 200, 140, 215, 60, 50);
+		CHECK(ScreenDiff(testref) == 0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Clipped at the right and bottom edge, a zero size buffer copies nothing
+   (and does not hang) */
+static void TestCopyLimits(void) {
+	CopyBackground();
+	ST7796_CopyInit(testwork, sizeof(testwork) / 2);
+	CopyRect(ST7796_SIZE_X - 50, ST7796_SIZE_Y - 40, ST7796_SIZE_X - 20,
+			ST7796_SIZE_Y - 30, 100, 100);
+	CopyRect(0, 0, 0, 5, ST7796_SIZE_X, 20);
+	CHECK(ScreenDiff(testref) == 0);
+	ST7796_CopyInit(testwork, 0);
+	ST7796_CopyRect(0, 0, 200, 200, 10, 10);
+	CHECK(ScreenDiff(testref) == 0);
+	ST7796_CopyInit(testwork, sizeof(testwork) / 2);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("copy", TestCopyOverlap);
+	Run("copylim", TestCopyLimits);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file    test_dlist.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 display list (ST7796_DLIST == 1): the
+ *          recorded primitives are sent before the functions which read the
+ *          LCD or draw without the list and are dropped by ST7796_Init.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "bmp.h"
+#include "st7796.h"
+#include "st7796_dlist.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+//-----------------------------------------------------------------------------
+/* The functions reading the LCD or drawing without the list send the
+   recorded primitives first, ST7796_Init drops them */
+static void TestDList(void) {
+	static uint8_t bmp[sizeof(BITMAPSTRUCT) + 2 * 4];
+	BITMAPSTRUCT *b = (BITMAPSTRUCT*) bmp;
+	uint16_t rd[4];
+	ST7796_DListEnd();
+	ST7796_FillRect(0, 0, 4, 1, 0x0000);
+	ST7796_DListBegin();
+	ST7796_FillRect(0, 0, 4, 1, 0xF800);
+	ST7796_ReadRGBImage(0, 0, 4, 1, rd);
+	CHECK(rd[0] == 0xF800);
+	CHECK(rd[3] == 0xF800);
+
+	/* the bitmap is drawn after the recorded fill */
+	b->fileHeader.bfOffBits = sizeof(BITMAPSTRUCT);
+	b->fileHeader.bfSize = sizeof(bmp);
+	memset(&bmp[sizeof(BITMAPSTRUCT)], 0xFF, 8);
+	ST7796_SetDisplayWindow(0, 0, 4, 1);
+	ST7796_FillRect(0, 0, 4, 1, 0x07E0);
+	ST7796_DrawBitmap(0, 0, bmp);
+	ST7796_SetDisplayWindow(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y);
+	CHECK(ScreenPixel(0, 0) == 0xFFFF);
+
+	ST7796_FillRect(0, 0, 4, 1, 0x001F);
+	ST7796_Init();
+	CHECK(ScreenPixel(0, 0) != 0x001F);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("dlist", TestDList);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
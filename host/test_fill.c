@@ -0,0 +1,283 @@
+/**
+ ******************************************************************************
+ * @file    test_fill.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 pattern fills: the gradients with and without
+ *          dithering against a floating point reference, the tile patterns,
+ *          the checkerboards and the runs of one color sent as fills.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <math.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_fill.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#if ST7796_ASYNC == 1
+#define FILL_CHUNK       (ST7796_FILL_BUFFER / 2)
+#else
+#define FILL_CHUNK       ST7796_FILL_BUFFER
+#endif
+
+static const uint8_t fillbayer[4][4] = {
+	{ 0, 8, 2, 10 },
+	{ 12, 4, 14, 6 },
+	{ 3, 11, 1, 9 },
+	{ 15, 7, 13, 5 } };
+
+//-----------------------------------------------------------------------------
+/* Channel of a RGB565 color (0: red, 1: green, 2: blue) */
+static int32_t FillChannel(uint16_t Color, uint8_t Ch) {
+	return (Ch == 0) ? Color >> 11 : (Ch == 1) ? (Color >> 5) & 0x3F : Color & 0x1F;
+}
+
+//-----------------------------------------------------------------------------
+/* Unrounded channel value of the gradient at T (0..1) */
+static double FillLevel(uint16_t C0, uint16_t C1, double T, uint8_t Ch) {
+	return FillChannel(C0, Ch) + (FillChannel(C1, Ch) - FillChannel(C0, Ch)) * T;
+}
+
+//-----------------------------------------------------------------------------
+/* Pixels of a gradient rectangle further than one step / channel from the
+   rounded (dithered: Bayer threshold) reference, the first and the last
+   corner in the gradient direction are Color0 and Color1 exactly */
+static uint32_t FillGradientDiff(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t C0, uint16_t C1, int16_t Dx, int16_t Dy,
+		uint8_t Flags) {
+	int32_t p0, range;
+	uint16_t x, y, xe = Xpos + Xsize - 1, ye = Ypos + Ysize - 1, c;
+	double t, bias;
+	uint32_t bad = 0;
+	uint8_t ch;
+	p0 = ((Dx < 0) ? (int32_t) (Xsize - 1) * Dx : 0)
+			+ ((Dy < 0) ? (int32_t) (Ysize - 1) * Dy : 0);
+	range = (int32_t) (Xsize - 1) * abs(Dx) + (int32_t) (Ysize - 1) * abs(Dy);
+	for (y = Ypos; y <= ye; y++)
+		for (x = Xpos; x <= xe; x++) {
+			t = (double) ((x - Xpos) * Dx + (y - Ypos) * Dy - p0) / range;
+			bias = (Flags & ST7796_FILL_DITHER) ?
+					(fillbayer[y & 3][x & 3] + 0.5) / 16 : 0.5;
+			c = ScreenPixel(x, y);
+			for (ch = 0; ch < 3; ch++)
+				if (fabs(floor(FillLevel(C0, C1, t, ch) + bias)
+						- FillChannel(c, ch)) > 1)
+					bad++;
+		}
+	/* the corners at the ends of the direction */
+	x = (Dx < 0) ? xe : Xpos;
+	y = (Dy < 0) ? ye : Ypos;
+	if (ScreenPixel(x, y) != C0)
+		bad++;
+	x = (Dx < 0) ? Xpos : xe;
+	y = (Dy < 0) ? Ypos : ye;
+	if (ScreenPixel(x, y) != C1)
+		bad++;
+	return bad;
+}
+
+//-----------------------------------------------------------------------------
+/* Pixel transfers (RAMWR / RAMWRC) of a fill function call */
+static uint32_t FillXfers(void) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	ST7796_Sync();
+	return s->CmdCnt[ST7796_WRITE_RAM] + s->CmdCnt[ST7796_WRITE_RAM_CONT];
+}
+
+//-----------------------------------------------------------------------------
+/* The gradients in the 4 diagonal and the axis directions, with and without
+   dithering, one clipped at the right and bottom edge */
+static void TestFillGradient(void) {
+	static const int16_t dir[][2] = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 },
+			{ 2, 1 }, { -1, 3 }, { 1, -1 }, { -3, -2 } };
+	uint16_t c0 = 0x0841, c1 = 0xF7BE, x, y, w = 90, h = 70;
+	uint32_t n, bad = 0;
+	uint8_t d, f;
+	for (f = 0; f < 2; f++) {
+		ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+		for (d = 0; d < sizeof(dir) / sizeof(dir[0]); d++) {
+			x = 5 + (d % 3) * (w + 5);
+			y = 5 + (d / 3) * (h + 5);
+			ST7796_FillGradient(x, y, w, h, c0, c1, dir[d][0], dir[d][1], f);
+			CHECK(FillGradientDiff(x, y, w, h, c0, c1, dir[d][0], dir[d][1], f) == 0);
+		}
+		ST7796_FillGradientV(5, 250, 60, 45, 0xF800, 0x001F, f);
+		CHECK(FillGradientDiff(5, 250, 60, 45, 0xF800, 0x001F, 0, 1, f) == 0);
+		ST7796_FillGradientH(80, 250, 61, 45, 0x07E0, 0xFFFF, f);
+		CHECK(FillGradientDiff(80, 250, 61, 45, 0x07E0, 0xFFFF, 1, 0, f) == 0);
+		/* the same colors at both ends: one fill */
+		n = FillXfers();
+		ST7796_FillGradientV(150, 250, 30, 30, 0x1234, 0x1234, f);
+#if ST7796_WRITEBITDEPTH == 16
+		CHECK(FillXfers() == n + 1);
+#else
+		/* the 64 pixel lines of the 24 bit adapter */
+		CHECK(FillXfers() == n + (30 * 30 + 63) / 64);
+#endif
+		CHECK(FillGradientDiff(150, 250, 30, 30, 0x1234, 0x1234, 0, 1, f) == 0);
+
+		/* clipped: the colors of the full rectangle */
+		if (f & ST7796_FILL_DITHER)
+			continue;
+		ST7796_FillGradientH(0, 0, ST7796_SIZE_X, 1, c0, c1, f);
+		ST7796_ReadRGBImage(0, 0, ST7796_SIZE_X, 1, testref);
+		ST7796_FillGradientH(ST7796_SIZE_X - 40, 100, ST7796_SIZE_X, 20, c0, c1, f);
+		ST7796_ReadRGBImage(ST7796_SIZE_X - 40, 100, 40, 20, testbuf);
+		for (y = 0; y < 20; y++)
+			for (x = 0; x < 40; x++)
+				if (testbuf[y * 40 + x] != testref[x])
+					bad++;
+		CHECK(bad == 0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* The dithered levels average to the unrounded gradient in every 4 * 4
+   block, the undithered gradient has only the rounded levels */
+static void TestFillDither(void) {
+	uint16_t x, y, bx, w = 128, h = 16;
+	double sum, ref;
+	uint32_t bad = 0, mixed = 0;
+	ST7796_FillGradientH(0, 0, w, h, 0x0000, 0x001F, ST7796_FILL_DITHER);
+	for (bx = 0; bx < w; bx += 4)
+		for (y = 0; y < h; y += 4) {
+			sum = 0;
+			ref = 0;
+			for (x = 0; x < 16; x++) {
+				sum += ScreenPixel(bx + x % 4, y + x / 4) & 0x1F;
+				ref += 31.0 * (bx + x % 4) / (w - 1);
+				/* the columns of a horizontal gradient are dithered too */
+				if ((x >= 4) && ((ScreenPixel(bx + x % 4, y + x / 4) & 0x1F)
+						!= (ScreenPixel(bx + x % 4, y + x / 4 - 1) & 0x1F)))
+					mixed++;
+			}
+			if (fabs(sum - ref) > 4)
+				bad++;
+		}
+	CHECK(bad == 0);
+	CHECK(mixed > 0);
+	/* the rows of a vertical gradient */
+	ST7796_FillGradientV(0, 40, h, w, 0x0000, 0x001F, ST7796_FILL_DITHER);
+	CHECK(FillGradientDiff(0, 40, h, w, 0x0000, 0x001F, 0, 1, ST7796_FILL_DITHER) == 0);
+	mixed = 0;
+	for (y = 40; y < 40 + w; y++)
+		for (x = 1; x < h; x++)
+			if (ScreenPixel(x, y) != ScreenPixel(x - 1, y))
+				mixed++;
+	CHECK(mixed > 0);
+	ST7796_FillGradientH(0, 20, w, h, 0x0000, 0x001F, 0);
+	for (x = 0; x < w; x++)
+		if ((ScreenPixel(x, 20) & 0x1F) != (uint16_t) floor(31.0 * x / (w - 1) + 0.5))
+			bad++;
+	CHECK(bad == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Repeated tiles of several sizes, clipped at the right and bottom edge */
+static void TestFillPattern(void) {
+	static const uint16_t size[][2] = { { 1, 1 }, { 3, 2 }, { 7, 5 }, { 16, 16 } };
+	static uint16_t tile[16 * 16];
+	uint16_t x, y, tx, ty, w = 50, h = 33, px, py;
+	uint32_t i;
+	uint8_t k;
+	for (i = 0; i < 16 * 16; i++)
+		tile[i] = (uint16_t) rand();
+	RefFill(testref, 0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	for (k = 0; k < 5; k++) {
+		tx = size[k & 3][0];
+		ty = size[k & 3][1];
+		px = (k < 4) ? 5 + k * (w + 5) : (uint16_t) (ST7796_SIZE_X - 20);
+		py = (k < 4) ? 5 : (uint16_t) (ST7796_SIZE_Y - 10);
+		ST7796_FillPattern(px, py, w, h, tile, tx, ty);
+		for (y = 0; (y < h) && (py + y < ST7796_SIZE_Y); y++)
+			for (x = 0; (x < w) && (px + x < ST7796_SIZE_X); x++)
+				testref[(py + y) * ST7796_SIZE_X + px + x] = tile[(y % ty) * tx + x % tx];
+	}
+	/* empty tile: nothing */
+	ST7796_FillPattern(0, 100, 10, 10, tile, 0, 5);
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Checkerboards with cells of several sizes (the last cells cut), clipped
+   at the right and bottom edge */
+static void TestFillChecker(void) {
+	static const uint16_t cell[][2] = { { 1, 1 }, { 4, 3 }, { 10, 7 }, { 25, 40 } };
+	uint16_t x, y, w = 55, h = 47, px, py, cx, cy;
+	uint8_t k;
+	RefFill(testref, 0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	for (k = 0; k < 5; k++) {
+		cx = cell[k & 3][0];
+		cy = cell[k & 3][1];
+		px = (k < 4) ? 5 + k * (w + 5) : (uint16_t) (ST7796_SIZE_X - 13);
+		py = (k < 4) ? 5 : (uint16_t) (ST7796_SIZE_Y - 9);
+		ST7796_FillChecker(px, py, w, h, 0xFFFF, 0x1234, cx, cy);
+		for (y = 0; (y < h) && (py + y < ST7796_SIZE_Y); y++)
+			for (x = 0; (x < w) && (px + x < ST7796_SIZE_X); x++)
+				testref[(py + y) * ST7796_SIZE_X + px + x] =
+						((x / cx + y / cy) & 1) ? 0x1234 : 0xFFFF;
+	}
+	ST7796_FillChecker(0, 100, 10, 10, 0xFFFF, 0x1234, 5, 0);
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Runs of ST7796_FILL_MINFILL pixels are sent as fills (one transfer / run),
+   shorter runs are collected in the chunk buffer, runs of one color over
+   the row ends are merged */
+static void TestFillRuns(void) {
+	uint32_t n;
+	/* a row of 4 cells */
+	n = FillXfers();
+	ST7796_FillChecker(0, 0, 4 * ST7796_FILL_MINFILL, 1, 0xFFFF, 0x0000,
+			ST7796_FILL_MINFILL, 1);
+	CHECK(FillXfers() == n + 4);
+	n = FillXfers();
+	ST7796_FillChecker(0, 0, 4 * (ST7796_FILL_MINFILL - 1), 1, 0xFFFF, 0x0000,
+			ST7796_FILL_MINFILL - 1, 1);
+	CHECK(FillXfers() == n + (4 * (ST7796_FILL_MINFILL - 1) + FILL_CHUNK - 1) / FILL_CHUNK);
+	/* a cell column of 2 rows: one run of 2 * cell width */
+	n = FillXfers();
+	ST7796_FillChecker(0, 0, ST7796_FILL_MINFILL / 2, 2, 0xFFFF, 0x0000,
+			ST7796_FILL_MINFILL / 2, 2);
+	CHECK(FillXfers() == n + 1);
+	/* 32 blue levels in 64 rows: a fill / level */
+	n = FillXfers();
+	ST7796_FillGradientV(0, 0, ST7796_FILL_MINFILL, 64, 0x0000, 0x001F, 0);
+#if ST7796_WRITEBITDEPTH == 16
+	CHECK(FillXfers() == n + 32);
+#endif
+	CHECK(FillGradientDiff(0, 0, ST7796_FILL_MINFILL, 64, 0x0000, 0x001F, 0, 1, 0) == 0);
+	/* narrower than the fill run: the levels as pixels */
+	n = FillXfers();
+	ST7796_FillGradientV(0, 0, 1, 64, 0x0000, 0x001F, 0);
+	CHECK(FillXfers() == n + (64 + FILL_CHUNK - 1) / FILL_CHUNK);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("fillgrad", TestFillGradient);
+	Run("filldither", TestFillDither);
+	Run("fillpat", TestFillPattern);
+	Run("fillcheck", TestFillChecker);
+	Run("fillrun", TestFillRuns);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,254 @@
+/**
+ ******************************************************************************
+ * @file    test_font.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 anti-aliased font renderer: characters and
+ *          strings of fonts encoded by ST7796_FontEncodeGlyph are compared
+ *          with a reference render of the coverage levels.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_font.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define FONT_N           95            /* ' ' .. '~' */
+#define FONT_CELL        (32 * 20)     /* largest cell [pixel] */
+#define FONT_LINEH       20            /* line buffer rows */
+
+typedef struct {
+	ST7796_FontTypeDef Font;
+	ST7796_GlyphTypeDef Glyph[FONT_N];
+	uint8_t Span[FONT_N * FONT_CELL];
+	uint8_t Level[FONT_N][FONT_CELL];
+} TestFontTypeDef;
+
+/* small: cached cells, large: cells over ST7796_FONT_CACHEPIXELS (streamed),
+   alt: the small font with other glyphs (cache test) */
+static TestFontTypeDef fontsmall, fontlarge, fontalt;
+static uint16_t fonttext, fontback;
+static uint16_t fontlinebuf[TEST_MAX * FONT_LINEH];
+
+//-----------------------------------------------------------------------------
+/* Glyph cells of Advance from Adv to Adv + 4 pixels: background border, a core
+   of random coverage levels and full coverage bars (long spans) */
+static void FontBuild(TestFontTypeDef *pF, uint8_t Bpp, uint16_t Adv,
+		uint16_t Height) {
+	uint32_t c, x, y, n = 0, max = (1 << Bpp) - 1;
+	uint8_t *l;
+	pF->Font.pGlyph = pF->Glyph;
+	pF->Font.pSpan = pF->Span;
+	pF->Font.First = ' ';
+	pF->Font.Count = FONT_N;
+	pF->Font.Height = Height;
+	pF->Font.Baseline = Height - 3;
+	pF->Font.Bpp = Bpp;
+	for (c = 0; c < FONT_N; c++) {
+		pF->Glyph[c].Advance = Adv + c % 5;
+		pF->Glyph[c].Offset = n;
+		l = pF->Level[c];
+		for (y = 0; y < Height; y++)
+			for (x = 0; x < pF->Glyph[c].Advance; x++)
+				*l++ = ((x == 0) || (y < 2) || (y + 2 >= Height)) ? 0 :
+						((y + c) % 4 == 0) ? max : rand() % (max + 1);
+		n += ST7796_FontEncodeGlyph(pF->Level[c], pF->Glyph[c].Advance * Height,
+				Bpp, &pF->Span[n], sizeof(pF->Span) - n);
+	}
+	CHECK(n <= sizeof(pF->Span));
+}
+
+//-----------------------------------------------------------------------------
+static void FontColor(uint16_t TextColor, uint16_t BackColor) {
+	fonttext = TextColor;
+	fontback = BackColor;
+	ST7796_FontSetColor(TextColor, BackColor);
+}
+
+//-----------------------------------------------------------------------------
+/* Blend of the colors, Level of 2^Bpp - 1 (rounded to the nearest value) */
+static uint16_t FontBlend(uint8_t Level, uint8_t Bpp) {
+	uint32_t max = (1 << Bpp) - 1, r, g, b;
+	r = ((fontback >> 11) * (max - Level) + (fonttext >> 11) * Level + max / 2) / max;
+	g = (((fontback >> 5) & 0x3F) * (max - Level) + ((fonttext >> 5) & 0x3F) * Level
+			+ max / 2) / max;
+	b = ((fontback & 0x1F) * (max - Level) + (fonttext & 0x1F) * Level + max / 2) / max;
+	return (r << 11) | (g << 5) | b;
+}
+
+//-----------------------------------------------------------------------------
+/* Reference of a character (clipped at the screen edge), retval advance */
+static uint16_t RefChar(const TestFontTypeDef *pF, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Code) {
+	uint16_t g = ((Code < ' ') || (Code - ' ' >= FONT_N)) ? 0 : Code - ' ';
+	uint16_t w = pF->Glyph[g].Advance, x, y;
+	for (y = 0; y < pF->Font.Height; y++)
+		for (x = 0; x < w; x++)
+			if ((Xpos + x < ST7796_SIZE_X) && (Ypos + y < ST7796_SIZE_Y))
+				testref[(Ypos + y) * ST7796_SIZE_X + Xpos + x] =
+						FontBlend(pF->Level[g][y * w + x], pF->Font.Bpp);
+	return w;
+}
+
+//-----------------------------------------------------------------------------
+static uint16_t RefString(const TestFontTypeDef *pF, uint16_t Xpos,
+		uint16_t Ypos, const char *pText) {
+	uint16_t x = Xpos;
+	while (*pText)
+		x += RefChar(pF, x, Ypos, (uint8_t) *pText++);
+	return x - Xpos;
+}
+
+//-----------------------------------------------------------------------------
+static void FontClear(void) {
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	memset(testref, 0, sizeof(testref));
+}
+
+//-----------------------------------------------------------------------------
+/* Number of windows started by a string */
+static uint32_t FontString(const TestFontTypeDef *pF, uint16_t Xpos,
+		uint16_t Ypos, const char *pText) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	uint32_t w;
+	ST7796_Sync();
+	w = s->CmdCnt[ST7796_WRITE_RAM];
+	CHECK(ST7796_DrawString(Xpos, Ypos, &pF->Font, pText)
+			== RefString(pF, Xpos, Ypos, pText));
+	ST7796_Sync();
+	return s->CmdCnt[ST7796_WRITE_RAM] - w;
+}
+
+//-----------------------------------------------------------------------------
+/* Characters of the cached and of the streamed font, two color pairs and a
+   character out of the font range (first glyph) */
+static void TestFontChar(void) {
+	uint16_t x, i;
+	FontBuild(&fontsmall, 4, 6, 14);
+	FontBuild(&fontlarge, 2, 27, 20);
+	CHECK(fontsmall.Glyph[FONT_N - 1].Advance * 14 <= ST7796_FONT_CACHEPIXELS);
+	CHECK(fontlarge.Glyph[0].Advance * 20 > ST7796_FONT_CACHEPIXELS);
+	ST7796_FontInit(NULL, 0);
+	FontClear();
+	FontColor(0xFFFF, 0x0000);
+	for (i = 0, x = 0; i < 30; i++)
+		x += ST7796_DrawChar(x, 10, &fontsmall.Font, 'A' + i);
+	CHECK(x == RefString(&fontsmall, 0, 10, "ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^"));
+	for (i = 0, x = 0; i < 10; i++)
+		x += ST7796_DrawChar(x, 40, &fontlarge.Font, '0' + i);
+	RefString(&fontlarge, 0, 40, "0123456789");
+	FontColor(0xF800, 0x041F);
+	CHECK(ST7796_DrawChar(5, 80, &fontsmall.Font, 200) == RefChar(&fontsmall, 5, 80, ' '));
+	CHECK(ST7796_DrawChar(5, 100, &fontlarge.Font, '~') == RefChar(&fontlarge, 5, 100, '~'));
+	CHECK(ST7796_DrawChar(50, 100, &fontsmall.Font, 'A') == RefChar(&fontsmall, 50, 100, 'A'));
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* One window / string in the line buffer, one window / glyph without it or
+   when the string does not fit in it */
+static void TestFontString(void) {
+	static const char text[] = "Hello, world! 0123";
+	uint32_t n = strlen(text);
+	FontClear();
+	FontColor(0x07E0, 0x0000);
+	ST7796_FontInit(NULL, 0);
+	CHECK(FontString(&fontsmall, 3, 10, text) == n);
+	CHECK(FontString(&fontlarge, 3, 30, "Wide") == 4);
+	ST7796_FontInit(fontlinebuf, sizeof(fontlinebuf) / sizeof(fontlinebuf[0]));
+	CHECK(FontString(&fontsmall, 3, 60, text) == 1);
+	CHECK(FontString(&fontlarge, 3, 80, "Wide") == 1);
+	ST7796_FontInit(fontlinebuf, 100);
+	CHECK(FontString(&fontsmall, 3, 110, text) == n);
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Strings and characters over the right and bottom edge */
+static void TestFontClip(void) {
+	uint8_t line;
+	FontColor(0xFFFF, 0x8010);
+	for (line = 0; line < 2; line++) {
+		FontClear();
+		if (line)
+			ST7796_FontInit(fontlinebuf, sizeof(fontlinebuf) / sizeof(fontlinebuf[0]));
+		else
+			ST7796_FontInit(NULL, 0);
+		FontString(&fontsmall, ST7796_SIZE_X - 23, 10, "abcdef");
+		FontString(&fontlarge, ST7796_SIZE_X - 41, 40, "xyz");
+		FontString(&fontsmall, 30, ST7796_SIZE_Y - 5, "abcdef");
+		FontString(&fontlarge, ST7796_SIZE_X - 41, ST7796_SIZE_Y - 7, "xyz");
+		ST7796_DrawChar(ST7796_SIZE_X - 3, 200, &fontsmall.Font, 'q');
+		RefChar(&fontsmall, ST7796_SIZE_X - 3, 200, 'q');
+		ST7796_DrawChar(ST7796_SIZE_X - 5, ST7796_SIZE_Y - 9, &fontlarge.Font, 'q');
+		RefChar(&fontlarge, ST7796_SIZE_X - 5, ST7796_SIZE_Y - 9, 'q');
+		CHECK(ScreenDiff(testref) == 0);
+	}
+}
+
+#if ST7796_FONT_CACHE > 0
+//-----------------------------------------------------------------------------
+/* The cached cells are drawn also after the glyph data changed: the font
+   data of the cached font is replaced to see the hits and the evictions */
+static void TestFontCache(void) {
+	static ST7796_FontTypeDef font;
+	uint16_t i;
+	FontBuild(&fontalt, 4, 6, 14);
+	font = fontsmall.Font;
+	ST7796_FontInit(NULL, 0);
+	FontColor(0xFFFF, 0x0000);
+	FontClear();
+	/* fill the cache, 'A' is used again: 'B' is the least recently used */
+	for (i = 0; i < ST7796_FONT_CACHE; i++)
+		ST7796_DrawChar(i * 16, 10, &font, 'A' + i);
+	ST7796_DrawChar(0, 10, &font, 'A');
+	font.pGlyph = fontalt.Glyph;
+	font.pSpan = fontalt.Span;
+	/* new glyph: evicts 'B' */
+	ST7796_DrawChar(0, 40, &font, 'a');
+	RefChar(&fontalt, 0, 40, 'a');
+	/* hits: the old glyph */
+	ST7796_DrawChar(0, 70, &font, 'A');
+	RefChar(&fontsmall, 0, 70, 'A');
+	ST7796_DrawChar(16, 70, &font, 'A' + ST7796_FONT_CACHE - 1);
+	RefChar(&fontsmall, 16, 70, 'A' + ST7796_FONT_CACHE - 1);
+	/* evicted: the new glyph */
+	ST7796_DrawChar(32, 70, &font, 'B');
+	RefChar(&fontalt, 32, 70, 'B');
+	for (i = 0; i < ST7796_FONT_CACHE; i++)
+		RefChar(&fontsmall, i * 16, 10, 'A' + i);
+	/* other colors are not in the cache */
+	FontColor(0x001F, 0xFFE0);
+	ST7796_DrawChar(48, 70, &font, 'A');
+	RefChar(&fontalt, 48, 70, 'A');
+	CHECK(ScreenDiff(testref) == 0);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("fontchar", TestFontChar);
+	Run("fontstr", TestFontString);
+	Run("fontclip", TestFontClip);
+#if ST7796_FONT_CACHE > 0
+	Run("fontcache", TestFontCache);
+#endif
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
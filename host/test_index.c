@@ -0,0 +1,187 @@
+/**
+ ******************************************************************************
+ * @file    test_index.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 indexed framebuffer (ST7796_INDEX_BPP 8 and 4):
+ *          the drawings at odd positions and widths are flushed through line
+ *          buffers longer and shorter than a row and compared with the
+ *          indexes expanded through the palette by the CPU.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_index.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define INDEX_COLORS     (1 << ST7796_INDEX_BPP)
+#define IMG_W            21
+#define IMG_H            13
+
+static uint8_t indexframe[ST7796_INDEX_FRAMESIZE];
+static uint8_t indexref[TEST_MAX * TEST_MAX];  /* indexes, ST7796_SIZE_X / row */
+static uint16_t indexpal[INDEX_COLORS];
+static uint8_t img[IMG_W * IMG_H];
+
+//-----------------------------------------------------------------------------
+/* A rectangle of one index into the reference, clipped */
+static void IndexRef(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize,
+		uint8_t Index) {
+	uint16_t x, y;
+	for (y = Ypos; (y < Ypos + Ysize) && (y < ST7796_SIZE_Y); y++)
+		for (x = Xpos; (x < Xpos + Xsize) && (x < ST7796_SIZE_X); x++)
+			indexref[y * ST7796_SIZE_X + x] = Index & (INDEX_COLORS - 1);
+}
+
+//-----------------------------------------------------------------------------
+/* Screen pixels different from the reference indexes through the palette */
+static uint32_t IndexDiff(void) {
+	uint32_t i;
+	for (i = 0; i < ST7796_SIZE_X * ST7796_SIZE_Y; i++)
+		testref[i] = indexpal[indexref[i]];
+	return ScreenDiff(testref);
+}
+
+//-----------------------------------------------------------------------------
+/* Random palette, the framebuffer cleared to index 0 and flushed */
+static void IndexStart(uint32_t BufSize) {
+	uint32_t i;
+	for (i = 0; i < INDEX_COLORS; i++)
+		indexpal[i] = (uint16_t) rand();
+	ST7796_IndexInit(indexframe, testwork, BufSize);
+	ST7796_IndexSetPalette(0, INDEX_COLORS, indexpal);
+	ST7796_IndexFillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0);
+	IndexRef(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0);
+	CHECK(ST7796_IndexFlush() == ST7796_SIZE_X * ST7796_SIZE_Y);
+	CHECK(ST7796_IndexFlush() == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* The drawings at odd and even positions and sizes (the nibble edges of the
+   4 bit framebuffer), the flush sends their bounding rectangle */
+static void TestIndexDraw(void) {
+	uint16_t x, y;
+	uint32_t i, bad = 0;
+	IndexStart(sizeof(testwork) / 2);
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		img[i] = (uint8_t) rand();
+
+	ST7796_IndexFillRect(3, 5, 7, 9, 1);
+	IndexRef(3, 5, 7, 9, 1);
+	ST7796_IndexFillRect(10, 5, 8, 2, 2);
+	IndexRef(10, 5, 8, 2, 2);
+	ST7796_IndexFillRect(11, 8, 1, 1, 3);
+	IndexRef(11, 8, 1, 1, 3);
+	ST7796_IndexDrawHLine(4, 21, 10, 6);
+	IndexRef(21, 10, 6, 1, 4);
+	ST7796_IndexDrawVLine(5, 30, 2, 20);
+	IndexRef(30, 2, 1, 20, 5);
+	ST7796_IndexWritePixel(33, 3, 6);
+	IndexRef(33, 3, 1, 1, 6);
+	ST7796_IndexWritePixel(34, 3, 7);
+	IndexRef(34, 3, 1, 1, 7);
+	ST7796_IndexDrawImage(15, 12, IMG_W, IMG_H, img);
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		IndexRef(15 + i % IMG_W, 12 + i / IMG_W, 1, 1, img[i]);
+	/* bounding rectangle: 3, 2 .. 35, 24 */
+	CHECK(ST7796_IndexFlush() == (36 - 3) * (25 - 2));
+	CHECK(IndexDiff() == 0);
+
+	/* clipped at the right and bottom edge */
+	ST7796_IndexDrawImage(ST7796_SIZE_X - 6, ST7796_SIZE_Y - 4, IMG_W, IMG_H, img);
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		if ((i % IMG_W < 6) && (i / IMG_W < 4))
+			IndexRef(ST7796_SIZE_X - 6 + i % IMG_W, ST7796_SIZE_Y - 4 + i / IMG_W,
+					1, 1, img[i]);
+	ST7796_IndexFillRect(ST7796_SIZE_X - 3, 100, 50, 3, 8);
+	IndexRef(ST7796_SIZE_X - 3, 100, 50, 3, 8);
+	ST7796_IndexWritePixel(ST7796_SIZE_X, 0, 9);
+	CHECK(ST7796_IndexFlush() == 6 * (ST7796_SIZE_Y - 100));
+	CHECK(IndexDiff() == 0);
+	for (y = 0; y < ST7796_SIZE_Y; y++)
+		for (x = 0; x < ST7796_SIZE_X; x++)
+			if (ST7796_IndexReadPixel(x, y) != indexref[y * ST7796_SIZE_X + x])
+				bad++;
+	CHECK(bad == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Line buffers shorter than a row: the chunks continue at the memory
+   pointer over the row ends of the window (one RAMWR, the rest RAMWRC) */
+static void TestIndexChunk(void) {
+	static const uint32_t size[] = { 7, 8, 50 };
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	uint32_t ramwr, ramwrc, chunk, i;
+	uint8_t k;
+	for (k = 0; k < sizeof(size) / sizeof(size[0]); k++) {
+		IndexStart(size[k]);
+#if ST7796_WRITEBITDEPTH == 24
+		chunk = size[k] * 2 / 3;
+#else
+		chunk = size[k];
+#endif
+		for (i = 0; i < 40; i++) {
+			ST7796_IndexDrawVLine(i, 13 + i, 31, 5);
+			IndexRef(13 + i, 31, 1, 5, i);
+		}
+		ST7796_Sync();
+		ramwr = s->CmdCnt[ST7796_WRITE_RAM];
+		ramwrc = s->CmdCnt[ST7796_WRITE_RAM_CONT];
+		CHECK(ST7796_IndexFlush() == 40 * 5);
+		ST7796_Sync();
+		CHECK(s->CmdCnt[ST7796_WRITE_RAM] == ramwr + 1);
+		CHECK(s->CmdCnt[ST7796_WRITE_RAM_CONT] == ramwrc + (40 * 5 + chunk - 1) / chunk - 1);
+		CHECK(IndexDiff() == 0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* A palette change marks the full screen, a direct framebuffer change the
+   marked area, a read in between does not change the written pixels */
+static void TestIndexPalette(void) {
+	uint8_t *p;
+	IndexStart(sizeof(testwork) / 2);
+	ST7796_IndexFillRect(0, 0, 40, 10, 1);
+	IndexRef(0, 0, 40, 10, 1);
+	CHECK(ST7796_IndexFlush() == 40 * 10);
+	indexpal[1] ^= 0xFFFF;
+	ST7796_IndexSetPalette(1, 1, &indexpal[1]);
+	CHECK(ST7796_IndexFlush() == ST7796_SIZE_X * ST7796_SIZE_Y);
+	CHECK(IndexDiff() == 0);
+	/* not changed: out of the palette */
+	ST7796_IndexSetPalette(INDEX_COLORS, 1, &indexpal[0]);
+	CHECK(ST7796_IndexFlush() == 0);
+
+	p = ST7796_IndexGetFrame();
+	CHECK(p == indexframe);
+	p[20 * ST7796_SIZE_X * ST7796_INDEX_BPP / 8] = (ST7796_INDEX_BPP == 4) ? 0x22 : 2;
+	IndexRef(0, 20, 8 / ST7796_INDEX_BPP, 1, 2);
+	ST7796_IndexMarkDirty(0, 20, 2, 1);
+	ST7796_ReadPixel(0, 0);
+	CHECK(ST7796_IndexFlush() == 2);
+	CHECK(IndexDiff() == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("indexdraw", TestIndexDraw);
+	Run("indexchunk", TestIndexChunk);
+	Run("indexpal", TestIndexPalette);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,175 @@
+/**
+ ******************************************************************************
+ * @file    test_init.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 init table interpreter: the commands, the
+ *          delays and the boot work calls of the default and of a custom
+ *          init table are checked in the command log of an emulated panel
+ *          (ST7796_FASTBOOT 0 and 1).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define INIT_LOG         64
+
+#if ST7796_WRITEBITDEPTH == 16
+#define INIT_COLMOD      0x55
+#else
+#define INIT_COLMOD      0x66
+#endif
+
+/* Panel variant: the mandatory wait, a delay skipped by the fast boot, an
+   inversion control with 2 arguments and the orientation MADCTL */
+static const uint8_t inittable[] = {
+	ST7796_SW_RESET, ST7796_INIT_WAIT | 0, 5,
+	ST7796_COLOR_MODE, ST7796_INIT_DELAY | 1, INIT_COLMOD, 7,
+	ST7796_INV_CTRL, 2, 0x12, 0x34,
+	ST7796_MADCTL, 0,
+	ST7796_DISPLAY_ON, 0,
+	ST7796_INIT_END
+};
+
+static ST7796_SimPanelTypeDef initsim;
+static ST7796_PanelTypeDef initpanel;
+static uint8_t initcmd[INIT_LOG];
+static uint32_t initsize[INIT_LOG];
+static uint32_t initcnt;
+static uint32_t initwait[INIT_LOG];    /* WaitMs of the boot work calls */
+static uint32_t initwaitcnt;
+static uint32_t initworkms;            /* work time / boot work call [ms] */
+
+//-----------------------------------------------------------------------------
+static void InitTrace(uint8_t Cmd, uint32_t Size) {
+	if (initcnt < INIT_LOG) {
+		initcmd[initcnt] = Cmd;
+		initsize[initcnt] = Size;
+	}
+	initcnt++;
+}
+
+//-----------------------------------------------------------------------------
+static uint32_t InitBootWork(uint32_t WaitMs) {
+	if (initwaitcnt < INIT_LOG)
+		initwait[initwaitcnt] = WaitMs;
+	initwaitcnt++;
+	return initworkms;
+}
+
+//-----------------------------------------------------------------------------
+/* Init an emulated panel in the next orientation (Orientation + 1) with an
+   init table (NULL: the default) and a boot work callback */
+static void InitPanel(const uint8_t *pTable, ST7796_BootWorkCallback pBootWork) {
+	ST7796_SimPanel_Reset(&initsim, 0);
+	initsim.pTrace = InitTrace;
+	initpanel = (ST7796_PanelTypeDef) ST7796_PANEL_INIT(&ST7796_SimPanelIo, &initsim);
+	initpanel.Orientation = (ST7796_ORIENTATION + 1) & 3;
+	initpanel.pInitTable = pTable;
+	initpanel.pBootWork = pBootWork;
+	initcnt = 0;
+	initwaitcnt = 0;
+	ST7796_Panel_Init(&initpanel);
+}
+
+//-----------------------------------------------------------------------------
+/* The commands of the custom table in order, the MADCTL without argument
+   sends the direction of the orientation */
+static void TestInitTable(void) {
+	static const uint8_t cmd[] = { ST7796_SW_RESET, ST7796_COLOR_MODE,
+			ST7796_INV_CTRL, ST7796_MADCTL, ST7796_DISPLAY_ON };
+	static const uint8_t size[] = { 0, 1, 2, 1, 0 };
+	uint8_t mad, i;
+	InitPanel(inittable, NULL);
+	mad = ST7796_PANEL_MAD_RIGHT_THEN_DOWN(&initpanel);
+	CHECK(initcnt > sizeof(cmd));
+	for (i = 0; i < sizeof(cmd); i++) {
+		CHECK(initcmd[i] == cmd[i]);
+		CHECK(initsize[i] == size[i]);
+	}
+	CHECK(initsim.State.Param[ST7796_INV_CTRL][0] == 0x12);
+	CHECK(initsim.State.Param[ST7796_INV_CTRL][1] == 0x34);
+	CHECK(initsim.State.Madctl == mad);
+	CHECK(initpanel.LastEntry == mad);
+	CHECK(initsim.State.DisplayOn == 1);
+	/* power on wait, WAIT, DELAY and the screen clear (not with the fast boot) */
+#if ST7796_FASTBOOT == 0
+	CHECK(initsim.Stat.DelayMs == 120 + 5 + 7 + ((ST7796_INITCLEAR == 1) ? 10 : 0));
+#else
+	CHECK(initsim.Stat.DelayMs == 5);
+#endif
+	CHECK(initsim.Stat.FormatErrors == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* The default table: both MADCTL entries send the orientation, the fast boot
+   only waits after SWRESET and SLPOUT */
+static void TestInitDefault(void) {
+	uint32_t i, mads = 0;
+	InitPanel(NULL, NULL);
+	for (i = 0; (i < initcnt) && (i < INIT_LOG); i++)
+		if (initcmd[i] == ST7796_MADCTL) {
+			CHECK(initsize[i] == 1);
+			mads++;
+		}
+	CHECK(mads == 2);
+	CHECK(initsim.State.Madctl == ST7796_PANEL_MAD_RIGHT_THEN_DOWN(&initpanel));
+	CHECK(initsim.State.Colmod == INIT_COLMOD);
+	CHECK(initsim.State.SleepOut == 1);
+#if ST7796_FASTBOOT == 0
+	CHECK(initsim.Stat.DelayMs > 120 + 120);
+#else
+	CHECK(initsim.Stat.DelayMs == 120 + 120);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/* The boot work runs in the delays, only the rest of a delay is waited */
+static void TestInitBootWork(void) {
+	initworkms = 3;
+	InitPanel(inittable, InitBootWork);
+#if ST7796_FASTBOOT == 0
+	CHECK(initwaitcnt == 3);
+	CHECK(initwait[0] == 120);
+	CHECK(initwait[1] == 5);
+	CHECK(initwait[2] == 7);
+	CHECK(initsim.Stat.DelayMs == (120 - 3) + (5 - 3) + (7 - 3)
+			+ ((ST7796_INITCLEAR == 1) ? 10 : 0));
+#else
+	CHECK(initwaitcnt == 1);
+	CHECK(initwait[0] == 5);
+	CHECK(initsim.Stat.DelayMs == 5 - 3);
+#endif
+	/* work longer than the delays: no waiting in the table */
+	initworkms = 1000;
+	InitPanel(inittable, InitBootWork);
+#if ST7796_FASTBOOT == 0
+	CHECK(initsim.Stat.DelayMs == ((ST7796_INITCLEAR == 1) ? 10 : 0));
+#else
+	CHECK(initsim.Stat.DelayMs == 0);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("inittable", TestInitTable);
+	Run("initdef", TestInitDefault);
+	Run("initwork", TestInitBootWork);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
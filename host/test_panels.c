@@ -0,0 +1,224 @@
+/**
+ ******************************************************************************
+ * @file    test_panels.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 panel instances: two emulated panels with
+ *          different orientations and window cache states are drawn one
+ *          after the other and from two threads, neither may change the
+ *          GRAM or the driver state of the other.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define PANEL_RECTS      200           /* rectangles / thread */
+
+typedef struct {
+	ST7796_PanelTypeDef hpanel;
+	ST7796_SimPanelTypeDef sim;
+	uint32_t Seed;
+} TestPanelTypeDef;
+
+static TestPanelTypeDef panel[2];
+static uint16_t panelgram[ST7796_SIM_GRAM_HEIGHT][ST7796_SIM_GRAM_WIDTH];
+static ST7796_PanelTypeDef panelstate;
+static uint16_t img[20 * 10];
+
+//-----------------------------------------------------------------------------
+static uint32_t PanelRand(TestPanelTypeDef *pP) {
+	pP->Seed = pP->Seed * 1103515245 + 12345;
+	return pP->Seed >> 8;
+}
+
+//-----------------------------------------------------------------------------
+/* Keep the GRAM and the driver state of a panel */
+static void PanelSave(const TestPanelTypeDef *pP) {
+	memcpy(panelgram, pP->sim.Gram, sizeof(panelgram));
+	panelstate = pP->hpanel;
+}
+
+//-----------------------------------------------------------------------------
+/* 1: the GRAM and the driver state are the saved ones */
+static uint8_t PanelSame(const TestPanelTypeDef *pP) {
+	return (memcmp(panelgram, pP->sim.Gram, sizeof(panelgram)) == 0)
+			&& (pP->hpanel.Orientation == panelstate.Orientation)
+			&& (pP->hpanel.LastEntry == panelstate.LastEntry)
+			&& (pP->hpanel.LastDir == panelstate.LastDir)
+			&& (memcmp(pP->hpanel.LastWindow, panelstate.LastWindow,
+					sizeof(panelstate.LastWindow)) == 0)
+			&& (memcmp(pP->hpanel.ScrParam, panelstate.ScrParam,
+					sizeof(panelstate.ScrParam)) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Pixels of a panel rectangle different from the reference (pitch: the
+   panel width) */
+static uint32_t PanelDiff(TestPanelTypeDef *pP, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Xsize, uint16_t Ysize) {
+	uint16_t w = ST7796_PANEL_SIZE_X(&pP->hpanel), x, y;
+	uint32_t bad = 0;
+	ST7796_Panel_ReadRGBImage(&pP->hpanel, Xpos, Ypos, Xsize, Ysize, testbuf);
+	for (y = 0; y < Ysize; y++)
+		for (x = 0; x < Xsize; x++)
+			if (testbuf[y * Xsize + x] != testref[(Ypos + y) * w + Xpos + x])
+				bad++;
+	return bad;
+}
+
+//-----------------------------------------------------------------------------
+/* The 50 * 40 rectangle at 10, 10 of the tests into the reference */
+static void PanelRef(uint16_t Pitch, uint16_t RGBCode) {
+	uint16_t x, y;
+	for (y = 10; y < 50; y++)
+		for (x = 10; x < 60; x++)
+			testref[y * Pitch + x] = RGBCode;
+}
+
+//-----------------------------------------------------------------------------
+/* Panel 0 in the compile time orientation with a scroll area, panel 1 turned
+   by 90 degrees with an invalid window cache */
+static void PanelInit(void) {
+	uint8_t i;
+	for (i = 0; i < 2; i++) {
+		ST7796_SimPanel_Reset(&panel[i].sim, 0);
+		panel[i].hpanel = (ST7796_PanelTypeDef) ST7796_PANEL_INIT(
+				&ST7796_SimPanelIo, &panel[i].sim);
+		panel[i].Seed = i + 1;
+		ST7796_Panel_Init(&panel[i].hpanel);
+	}
+	ST7796_Panel_SetOrientation(&panel[1].hpanel, (ST7796_ORIENTATION + 1) & 3);
+	ST7796_Panel_FillRect(&panel[0].hpanel, 0, 0, ST7796_PANEL_SIZE_X(&panel[0].hpanel),
+			ST7796_PANEL_SIZE_Y(&panel[0].hpanel), 0x1111);
+	ST7796_Panel_FillRect(&panel[1].hpanel, 0, 0, ST7796_PANEL_SIZE_X(&panel[1].hpanel),
+			ST7796_PANEL_SIZE_Y(&panel[1].hpanel), 0x2222);
+	ST7796_Panel_Scroll(&panel[0].hpanel, 10, 20, 30);
+	ST7796_Panel_UserCommand(&panel[1].hpanel, ST7796_NOP, NULL, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+/* The drawings of one panel do not change the other panel and the lcd_io
+   panel, the window cache of a panel survives the drawings of the other */
+static void TestPanelsSerial(void) {
+	const ST7796_SimStatTypeDef *s0 = &panel[0].sim.Stat;
+	uint32_t i, cmds = ST7796_Sim_GetStat()->Cmds, caset, raset;
+	uint16_t w0;
+	PanelInit();
+	for (i = 0; i < 20 * 10; i++)
+		img[i] = (uint16_t) rand();
+
+	PanelSave(&panel[1]);
+	ST7796_Panel_FillRect(&panel[0].hpanel, 10, 10, 50, 40, 0xF800);
+	ST7796_Panel_DrawRGBImageTransform(&panel[0].hpanel, 100, 10, 20, 10, img,
+			ST7796_ROT_90);
+	ST7796_Panel_DrawRGBImage(&panel[0].hpanel, 100, 50, 20, 10, img);
+	ST7796_Panel_WritePixel(&panel[0].hpanel, 3, 3, 0x07E0);
+	ST7796_Panel_Scroll(&panel[0].hpanel, 25, 20, 30);
+	CHECK(PanelSame(&panel[1]));
+
+	/* the scroll invalidated the window cache of panel 0 */
+	ST7796_Panel_WritePixel(&panel[0].hpanel, 3, 3, 0x07E0);
+	PanelSave(&panel[0]);
+	caset = s0->CmdCnt[ST7796_CASET];
+	raset = s0->CmdCnt[ST7796_RASET];
+	ST7796_Panel_FillRect(&panel[1].hpanel, 10, 10, 50, 40, 0x001F);
+	ST7796_Panel_DrawRGBImageTransform(&panel[1].hpanel, 200, 100, 20, 10, img,
+			ST7796_ROT_180 | ST7796_FLIP_X);
+	ST7796_Panel_Scroll(&panel[1].hpanel, 5, 0, 0);
+	CHECK(PanelSame(&panel[0]));
+	/* the same window again: no CASET / RASET on panel 0 */
+	ST7796_Panel_WritePixel(&panel[0].hpanel, 3, 3, 0x07E0);
+	CHECK(s0->CmdCnt[ST7796_CASET] == caset);
+	CHECK(s0->CmdCnt[ST7796_RASET] == raset);
+	CHECK(ST7796_Sim_GetStat()->Cmds == cmds);
+
+	/* the content in the coordinates of the panels */
+	w0 = ST7796_PANEL_SIZE_X(&panel[0].hpanel);
+	for (i = 0; i < 60 * w0; i++)
+		testref[i] = 0x1111;
+	PanelRef(w0, 0xF800);
+	testref[3 * w0 + 3] = 0x07E0;
+	for (i = 0; i < 20 * 10; i++)
+		testref[(50 + i / 20) * w0 + 100 + i % 20] = img[i];
+	CHECK(PanelDiff(&panel[0], 0, 0, 70, 60) == 0);
+	CHECK(PanelDiff(&panel[0], 100, 50, 20, 10) == 0);
+	w0 = ST7796_PANEL_SIZE_X(&panel[1].hpanel);
+	for (i = 0; i < 60 * w0; i++)
+		testref[i] = 0x2222;
+	PanelRef(w0, 0x001F);
+	CHECK(PanelDiff(&panel[1], 0, 0, 70, 60) == 0);
+}
+
+//-----------------------------------------------------------------------------
+static void * PanelThread(void *pParam) {
+	TestPanelTypeDef *p = pParam;
+	uint16_t w = ST7796_PANEL_SIZE_X(&p->hpanel), h = ST7796_PANEL_SIZE_Y(&p->hpanel);
+	uint16_t x, y, xs, ys;
+	uint32_t i;
+	for (i = 0; i < PANEL_RECTS; i++) {
+		x = PanelRand(p) % (w - 40);
+		y = PanelRand(p) % (h - 40);
+		xs = 1 + PanelRand(p) % 40;
+		ys = 1 + PanelRand(p) % 40;
+		ST7796_Panel_FillRect(&p->hpanel, x, y, xs, ys, (uint16_t) PanelRand(p));
+	}
+	return NULL;
+}
+
+//-----------------------------------------------------------------------------
+/* Both panels drawn at the same time, compared with the same rectangles
+   drawn into the reference */
+static void TestPanelsThreads(void) {
+	pthread_t thread[2];
+	uint16_t w, h, x, y, xs, ys, c;
+	uint32_t i, n;
+	uint8_t p;
+	PanelInit();
+	for (p = 0; p < 2; p++)
+		pthread_create(&thread[p], NULL, PanelThread, &panel[p]);
+	for (p = 0; p < 2; p++)
+		pthread_join(thread[p], NULL);
+	for (p = 0; p < 2; p++) {
+		w = ST7796_PANEL_SIZE_X(&panel[p].hpanel);
+		h = ST7796_PANEL_SIZE_Y(&panel[p].hpanel);
+		panel[p].Seed = p + 1;
+		for (n = 0; n < (uint32_t) w * h; n++)
+			testref[n] = p ? 0x2222 : 0x1111;
+		for (i = 0; i < PANEL_RECTS; i++) {
+			x = PanelRand(&panel[p]) % (w - 40);
+			y = PanelRand(&panel[p]) % (h - 40);
+			xs = 1 + PanelRand(&panel[p]) % 40;
+			ys = 1 + PanelRand(&panel[p]) % 40;
+			c = (uint16_t) PanelRand(&panel[p]);
+			for (n = 0; n < (uint32_t) xs * ys; n++)
+				testref[(y + n / xs) * w + x + n % xs] = c;
+		}
+		CHECK(PanelDiff(&panel[p], 0, 0, w, h) == 0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("panels", TestPanelsSerial);
+	Run("panelthr", TestPanelsThreads);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
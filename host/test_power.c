@@ -0,0 +1,242 @@
+/**
+ ******************************************************************************
+ * @file    test_power.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 power profiles (ST7796_POWER 1): the partial
+ *          display area in every orientation, the drawing clipped to it, the
+ *          automatic idle mode and the power draw of the emulated panel.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_power.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define BAND_START       40
+#define BAND_SIZE        100
+#define IMG_W            150
+#define IMG_H            150
+
+static uint16_t img[IMG_W * IMG_H];
+
+//-----------------------------------------------------------------------------
+/* 1: the gate lines of the orientation are screen columns */
+static uint8_t PowerColumns(void) {
+	return (ST7796_Sim_GetState()->Madctl & ST7796_MAD_VERTICAL) ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+/* The rectangle clipped to the band into the reference (pData: image of
+   Xsize pixels / row, NULL: RGBCode) */
+static void PowerRef(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize,
+		const uint16_t *pData, uint16_t RGBCode) {
+	uint16_t x, y, p;
+	for (y = 0; y < Ysize; y++)
+		for (x = 0; x < Xsize; x++) {
+			p = PowerColumns() ? Xpos + x : Ypos + y;
+			if ((p >= BAND_START) && (p < BAND_START + BAND_SIZE)
+					&& (Xpos + x < ST7796_SIZE_X) && (Ypos + y < ST7796_SIZE_Y))
+				testref[(Ypos + y) * ST7796_SIZE_X + Xpos + x] =
+						pData ? pData[y * Xsize + x] : RGBCode;
+		}
+}
+
+//-----------------------------------------------------------------------------
+/* The band in the 4 orientations: the PTLAR rows (mirrored with MY) and
+   only the band is on the screen, the rest is black */
+static void TestPowerArea(void) {
+	static const ST7796_PowerProfileTypeDef band = { BAND_START, BAND_SIZE,
+			ST7796_POWER_IDLE_OFF, 0 };
+	const ST7796_SimStateTypeDef *s = ST7796_Sim_GetState();
+	uint16_t lines, first, last, x, y, p;
+	uint32_t bad;
+	uint8_t o;
+	for (o = 0; o < 4; o++) {
+		ST7796_SetOrientation(o);
+		ST7796_PowerSetProfile(NULL);
+		ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0xFFFF);
+		CHECK(ST7796_PowerSetProfile(&band) == 0);
+		ST7796_Sync();
+		lines = PowerColumns() ? ST7796_SIZE_X : ST7796_SIZE_Y;
+		if (s->Madctl & ST7796_MAD_Y_DOWN) {
+			first = lines - BAND_START - BAND_SIZE;
+			last = lines - 1 - BAND_START;
+		} else {
+			first = BAND_START;
+			last = BAND_START + BAND_SIZE - 1;
+		}
+		CHECK(s->Partial == 1);
+		CHECK(s->ParamLen[ST7796_PTLAR] == 4);
+		CHECK(((s->Param[ST7796_PTLAR][0] << 8) | s->Param[ST7796_PTLAR][1]) == first);
+		CHECK(((s->Param[ST7796_PTLAR][2] << 8) | s->Param[ST7796_PTLAR][3]) == last);
+		CHECK((s->Psl == first) && (s->Pel == last));
+		bad = 0;
+		for (y = 0; y < ST7796_SIZE_Y; y++)
+			for (x = 0; x < ST7796_SIZE_X; x++) {
+				p = PowerColumns() ? x : y;
+				if (ScreenPixel(x, y) != (((p >= BAND_START)
+						&& (p < BAND_START + BAND_SIZE)) ? 0xFFFF : 0x0000))
+					bad++;
+			}
+		CHECK(bad == 0);
+	}
+	ST7796_SetOrientation(ST7796_ORIENTATION);
+	ST7796_PowerSetProfile(NULL);
+	CHECK(s->Partial == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* The primitives of st7796_drv over the band edges draw only into the band
+   (rows in the compile time orientation, columns turned by 90 degrees), the
+   frame memory outside is unchanged */
+static void TestPowerClip(void) {
+	static const ST7796_PowerProfileTypeDef band = { BAND_START, BAND_SIZE,
+			ST7796_POWER_IDLE_OFF, 0 };
+	uint32_t i;
+	uint8_t o;
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		img[i] = (uint16_t) rand();
+	for (o = 0; o < 2; o++) {
+		ST7796_SetOrientation((ST7796_ORIENTATION + o) & 3);
+		ST7796_PowerSetProfile(NULL);
+		ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x1234);
+		RefFill(testref, 0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x1234);
+		ST7796_PowerSetProfile(&band);
+
+		ST7796_FillRect(20, 20, 200, 200, 0xF800);
+		PowerRef(20, 20, 200, 200, NULL, 0xF800);
+		ST7796_DrawHLine(0x07E0, 0, 60, ST7796_SIZE_X);
+		PowerRef(0, 60, ST7796_SIZE_X, 1, NULL, 0x07E0);
+		ST7796_DrawHLine(0x07E0, 0, 10, ST7796_SIZE_X);
+		PowerRef(0, 10, ST7796_SIZE_X, 1, NULL, 0x07E0);
+		ST7796_DrawVLine(0x001F, 70, 0, ST7796_SIZE_Y);
+		PowerRef(70, 0, 1, ST7796_SIZE_Y, NULL, 0x001F);
+		ST7796_DrawVLine(0x001F, 10, 0, ST7796_SIZE_Y);
+		PowerRef(10, 0, 1, ST7796_SIZE_Y, NULL, 0x001F);
+		ST7796_WritePixel(5, 5, 0xFFE0);
+		PowerRef(5, 5, 1, 1, NULL, 0xFFE0);
+		ST7796_WritePixel(50, 50, 0xFFE0);
+		PowerRef(50, 50, 1, 1, NULL, 0xFFE0);
+		ST7796_DrawRGBImage(30, 30, IMG_W, IMG_H, img);
+		PowerRef(30, 30, IMG_W, IMG_H, img, 0);
+		ST7796_DrawRGBImage(0, 250, IMG_W, IMG_H, img);
+		PowerRef(0, 250, IMG_W, IMG_H, img, 0);
+
+		ST7796_PowerSetProfile(NULL);
+		CHECK(ScreenDiff(testref) == 0);
+	}
+	ST7796_SetOrientation(ST7796_ORIENTATION);
+}
+
+//-----------------------------------------------------------------------------
+/* The automatic idle mode: on if the band (or the full screen) has only the
+   8 idle colors, a pixel outside of the band does not matter */
+static void TestPowerIdle(void) {
+	static const ST7796_PowerProfileTypeDef full = { 0, 0, ST7796_POWER_IDLE_AUTO, 0 };
+	static const ST7796_PowerProfileTypeDef band = { BAND_START, BAND_SIZE,
+			ST7796_POWER_IDLE_AUTO, 0 };
+	static const ST7796_PowerProfileTypeDef on = { BAND_START, BAND_SIZE,
+			ST7796_POWER_IDLE_ON, 0 };
+	const ST7796_SimStateTypeDef *s = ST7796_Sim_GetState();
+	ST7796_PowerInit(testwork, sizeof(testwork) / 2);
+	ST7796_PowerSetProfile(NULL);
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_FillRect(10, 10, 100, 200, 0xF800);
+	ST7796_FillRect(50, 60, 200, 20, 0x07FF);
+	ST7796_DrawHLine(0xFFFF, 0, BAND_START + BAND_SIZE - 1, ST7796_SIZE_X);
+	CHECK(ST7796_PowerSetProfile(&full) == 1);
+	ST7796_Sync();
+	CHECK(s->Idle == 1);
+	CHECK(s->Partial == 0);
+	CHECK(ST7796_PowerSetProfile(&band) == 1);
+
+	/* a pixel of 2 levels below the band */
+	ST7796_PowerSetProfile(NULL);
+	ST7796_WritePixel(100, BAND_START + BAND_SIZE, 0x8410);
+	CHECK(ST7796_PowerSetProfile(&band) == 1);
+	CHECK(ST7796_PowerSetProfile(&full) == 0);
+	ST7796_Sync();
+	CHECK(s->Idle == 0);
+
+	/* in the band, at the last row */
+	ST7796_PowerSetProfile(NULL);
+	ST7796_WritePixel(ST7796_SIZE_X - 1, BAND_START + BAND_SIZE - 1, 0xF810);
+	CHECK(ST7796_PowerSetProfile(&band) == 0);
+	CHECK(ST7796_PowerSetProfile(&on) == 1);
+
+	/* a buffer shorter than a row: no content check */
+	ST7796_PowerInit(testwork, ST7796_SIZE_X - 1);
+	ST7796_PowerSetProfile(NULL);
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	CHECK(ST7796_PowerSetProfile(&band) == 0);
+	ST7796_PowerInit(NULL, 0);
+	CHECK(ST7796_PowerSetProfile(&band) == 0);
+	ST7796_PowerSetProfile(NULL);
+	ST7796_Sync();
+	CHECK(s->Idle == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* The power draw falls with a smaller band, the idle mode and the reduced
+   frame rate */
+static void TestPowerDraw(void) {
+	static const ST7796_PowerProfileTypeDef profile[] = {
+		{ 0, 0, ST7796_POWER_IDLE_OFF, 0 },
+		{ BAND_START, 2 * BAND_SIZE, ST7796_POWER_IDLE_OFF, 0 },
+		{ BAND_START, BAND_SIZE, ST7796_POWER_IDLE_OFF, 0 },
+		{ BAND_START, BAND_SIZE, ST7796_POWER_IDLE_OFF, 1 },
+		{ BAND_START, BAND_SIZE, ST7796_POWER_IDLE_ON, 1 },
+	};
+	static const ST7796_PowerProfileTypeDef idle = { 0, 0, ST7796_POWER_IDLE_ON, 0 };
+	uint32_t power, last;
+	uint8_t i;
+	ST7796_PowerSetProfile(NULL);
+	ST7796_Sync();
+	last = ST7796_Sim_GetPower();
+	for (i = 0; i < sizeof(profile) / sizeof(profile[0]); i++) {
+		ST7796_PowerSetProfile(&profile[i]);
+		ST7796_Sync();
+		power = ST7796_Sim_GetPower();
+		if (i == 0)
+			CHECK(power == last);
+		else
+			CHECK(power < last);
+		last = power;
+	}
+	/* the full screen idle mode is below the normal mode */
+	ST7796_PowerSetProfile(NULL);
+	ST7796_Sync();
+	last = ST7796_Sim_GetPower();
+	ST7796_PowerSetProfile(&idle);
+	ST7796_Sync();
+	CHECK(ST7796_Sim_GetPower() < last);
+	ST7796_PowerSetProfile(NULL);
+	ST7796_Sync();
+	CHECK(ST7796_Sim_GetPower() == last);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("powerarea", TestPowerArea);
+	Run("powerclip", TestPowerClip);
+	Run("poweridle", TestPowerIdle);
+	Run("powerdraw", TestPowerDraw);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
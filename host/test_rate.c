@@ -0,0 +1,155 @@
+/**
+ ******************************************************************************
+ * @file    test_rate.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 refresh rate control: frames are presented at
+ *          several rates in measurement windows of a simulated clock, the
+ *          steps, the FRMCTR1 / INVCTR parameters of the emulated panel and
+ *          the reported rates are checked.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_rate.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define RATE_STEPS       (sizeof(ratehz) / sizeof(ratehz[0]))
+
+static const uint8_t ratesteps[] = ST7796_RATE_STEPS;
+static const uint16_t ratehz[] = { ST7796_RATE_HZ };
+
+static uint32_t ratetime;              /* simulated clock [us] */
+static uint32_t rateframeus;           /* last RateChanged period */
+static uint32_t ratechanges;           /* RateChanged calls */
+
+//-----------------------------------------------------------------------------
+static uint32_t RateGetTimeUs(void) {
+	return ratetime;
+}
+
+//-----------------------------------------------------------------------------
+static void RateChanged(uint32_t FrameUs) {
+	rateframeus = FrameUs;
+	ratechanges++;
+}
+
+static const ST7796_RateSourceTypeDef ratesource = { RateGetTimeUs, RateChanged };
+
+//-----------------------------------------------------------------------------
+/* One measurement window with Fps presented frames / s, returns the
+   ST7796_RateTask result at its end */
+static uint8_t RateWindow(uint32_t Fps) {
+	uint32_t i, frames = Fps * ST7796_RATE_WINDOWMS / 1000;
+	for (i = 0; i < frames; i++) {
+		ratetime += ST7796_RATE_WINDOWMS * 1000U / (frames + 1);
+		ST7796_RateFrame();
+	}
+	ratetime = ratetime - ratetime % (ST7796_RATE_WINDOWMS * 1000U)
+			+ ST7796_RATE_WINDOWMS * 1000U;
+	return ST7796_RateTask();
+}
+
+//-----------------------------------------------------------------------------
+/* 1: the step is programmed in the emulated panel and reported by the API
+   and the notification */
+static uint8_t RateIs(uint8_t Step) {
+	const ST7796_SimStateTypeDef *s = ST7796_Sim_GetState();
+	ST7796_Sync();
+	return (ST7796_RateGetStat()->Step == Step)
+			&& (ST7796_RateGetHz() == ratehz[Step])
+			&& (ST7796_RateGetStat()->Hz == ratehz[Step])
+			&& (rateframeus == 1000000U / ratehz[Step])
+			&& (s->ParamLen[ST7796_FRAME_RATE_CTRL1] == 2)
+			&& (s->Param[ST7796_FRAME_RATE_CTRL1][0] == ratesteps[Step * 3])
+			&& (s->Param[ST7796_FRAME_RATE_CTRL1][1] == ratesteps[Step * 3 + 1])
+			&& (s->ParamLen[ST7796_INV_CTRL] == 1)
+			&& (s->Param[ST7796_INV_CTRL][0] == ratesteps[Step * 3 + 2]);
+}
+
+//-----------------------------------------------------------------------------
+/* Down one step only after ST7796_RATE_HOLD slow windows in a row (a fast
+   window restarts the count), up at once to the slowest step with enough
+   headroom */
+static void TestRateSteps(void) {
+	const ST7796_RateStatTypeDef *st = ST7796_RateGetStat();
+	uint32_t frmctr, i;
+	ratetime = 1000;
+	ratechanges = 0;
+	ST7796_RateInit(&ratesource);
+	CHECK(ratechanges == 1);
+	CHECK(RateIs(RATE_STEPS - 1));
+	CHECK(ratehz[RATE_STEPS - 1] == 60);
+
+	/* before the end of the window: nothing measured */
+	ratetime += ST7796_RATE_WINDOWMS * 1000U - 1;
+	CHECK(ST7796_RateTask() == 0);
+	ratetime = 0;
+	ST7796_RateInit(&ratesource);
+
+	/* 20 frames / s: below 70 % of 30 Hz */
+	for (i = 1; i < ST7796_RATE_HOLD; i++)
+		CHECK(RateWindow(20) == 0);
+	CHECK(st->PresentHz == 20);
+	CHECK(RateWindow(40) == 0);
+	for (i = 1; i < ST7796_RATE_HOLD; i++)
+		CHECK(RateWindow(20) == 0);
+	CHECK(RateIs(2));
+	ST7796_Sync();
+	frmctr = ST7796_Sim_GetStat()->CmdCnt[ST7796_FRAME_RATE_CTRL1];
+	CHECK(RateWindow(20) == 1);
+	CHECK(RateIs(1));
+	CHECK(st->Downs == 1);
+	ST7796_Sync();
+	CHECK(ST7796_Sim_GetStat()->CmdCnt[ST7796_FRAME_RATE_CTRL1] == frmctr + 1);
+	/* 20 frames / s fit 30 Hz (not below 70 % of 15 Hz) */
+	for (i = 0; i < 2 * ST7796_RATE_HOLD; i++)
+		CHECK(RateWindow(20) == 0);
+	CHECK(RateIs(1));
+
+	/* a static screen goes down to the slowest step */
+	for (i = 1; i < ST7796_RATE_HOLD; i++)
+		CHECK(RateWindow(0) == 0);
+	CHECK(RateWindow(0) == 1);
+	CHECK(RateIs(0));
+	CHECK(st->PresentHz == 0);
+	CHECK(RateWindow(0) == 0);
+	CHECK(st->Downs == 2);
+
+	/* 20 frames / s: above 80 % of 15 Hz, 30 Hz is enough */
+	CHECK(RateWindow(20) == 1);
+	CHECK(RateIs(1));
+	for (i = 1; i < ST7796_RATE_HOLD; i++)
+		CHECK(RateWindow(0) == 0);
+	CHECK(RateWindow(0) == 1);
+	CHECK(RateIs(0));
+	/* 60 frames / s: from 15 Hz to 60 Hz in one window */
+	CHECK(RateWindow(60) == 1);
+	CHECK(RateIs(2));
+	CHECK(st->PresentHz == 60);
+	CHECK(st->Ups == 2);
+	CHECK(RateWindow(60) == 0);
+	CHECK(st->Downs == 3);
+	CHECK(st->Frames == 5 * (4 * ST7796_RATE_HOLD) + 10 + 2 * 15);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("rate", TestRateSteps);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
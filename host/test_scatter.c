@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    test_scatter.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 scattered pixel writes: random points with and
+ *          without a work buffer against the last write of every pixel, the
+ *          runs and blocks of neighbouring points through one window.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_scatter.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define SCATTER_NUM      3000
+#define SCATTER_WORK     1000          /* points / batch */
+
+static ST7796_PointTypeDef pt[SCATTER_NUM];
+static uint16_t col[SCATTER_NUM];
+static uint32_t sort[2 * SCATTER_WORK];
+
+//-----------------------------------------------------------------------------
+/* Random points, every second one in a small cluster (points drawn more
+   than once, in several batches) and the others over the screen edges */
+static void TestScatterRandom(void) {
+	uint32_t i;
+	for (i = 0; i < SCATTER_NUM; i++) {
+		pt[i].X = (i & 1) ? rand() % (ST7796_SIZE_X + 8) : 40U + rand() % 30;
+		pt[i].Y = (i & 1) ? rand() % (ST7796_SIZE_Y + 8) : 50U + rand() % 20;
+		col[i] = (uint16_t) rand();
+	}
+	RefFill(testref, 0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	for (i = 0; i < SCATTER_NUM; i++)
+		if ((pt[i].X < ST7796_SIZE_X) && (pt[i].Y < ST7796_SIZE_Y))
+			testref[pt[i].Y * ST7796_SIZE_X + pt[i].X] = col[i];
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_ScatterInit(sort, 2 * SCATTER_WORK);
+	ST7796_WritePixels(pt, col, SCATTER_NUM);
+	CHECK(ScreenDiff(testref) == 0);
+
+	/* without a work buffer: one by one */
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_ScatterInit(NULL, 0);
+	ST7796_WritePixels(pt, col, SCATTER_NUM);
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* A dense block of points in random order goes through one window, a run
+   of a row through an other one */
+static void TestScatterBlock(void) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	uint32_t i, j, ramwr, n = 0;
+	ST7796_PointTypeDef t;
+	for (i = 0; i < 12 * 9; i++) {
+		pt[n].X = 100 + i % 12;
+		pt[n].Y = 200 + i / 12;
+		col[n++] = (uint16_t) rand();
+	}
+	for (i = 0; i < 20; i++) {
+		pt[n].X = 10 + i;
+		pt[n].Y = 300;
+		col[n++] = (uint16_t) rand();
+	}
+	for (i = n - 1; i > 0; i--) {
+		j = rand() % (i + 1);
+		t = pt[i];
+		pt[i] = pt[j];
+		pt[j] = t;
+	}
+	RefFill(testref, 0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	for (i = 0; i < n; i++)
+		testref[pt[i].Y * ST7796_SIZE_X + pt[i].X] = col[i];
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_ScatterInit(sort, 2 * SCATTER_WORK);
+	ST7796_Sync();
+	ramwr = s->CmdCnt[ST7796_WRITE_RAM];
+	ST7796_WritePixels(pt, col, n);
+	ST7796_Sync();
+	CHECK(s->CmdCnt[ST7796_WRITE_RAM] == ramwr + 2);
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("scatter", TestScatterRandom);
+	Run("scatterblock", TestScatterBlock);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
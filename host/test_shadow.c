@@ -0,0 +1,130 @@
+/**
+ ******************************************************************************
+ * @file    test_shadow.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 shadow framebuffer: the flushed screen is
+ *          compared with the buffer and the number of sent rectangles with
+ *          the tile merging of ST7796_SHADOW_MERGE and ST7796_SHADOW_GAP.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_shadow.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define T                ST7796_SHADOW_TILE
+#define TX               ((ST7796_SIZE_X + T - 1) / T)
+#define TY               ((ST7796_SIZE_Y + T - 1) / T)
+
+//-----------------------------------------------------------------------------
+/* Flush and count the windows started on the panel (one RAMWR / rectangle) */
+static uint32_t ShadowFlush(uint32_t *pWindows) {
+	uint32_t n, w = ST7796_Sim_GetStat()->CmdCnt[ST7796_WRITE_RAM];
+	n = ST7796_ShadowFlush();
+	*pWindows = ST7796_Sim_GetStat()->CmdCnt[ST7796_WRITE_RAM] - w;
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+/* After the init every tile is dirty */
+static void TestShadowFull(void) {
+	uint32_t i, n, w;
+	ST7796_ShadowInit(testbuf);
+	for (i = 0; i < ST7796_SIZE_X * ST7796_SIZE_Y; i++)
+		testbuf[i] = (uint16_t) rand();
+	n = ShadowFlush(&w);
+	CHECK(ScreenDiff(testbuf) == 0);
+	CHECK(n == w);
+#if ST7796_SHADOW_MERGE == 0
+	CHECK(n == TX * TY);
+#elif ST7796_SHADOW_MERGE == 1
+	CHECK(n == TY);
+#else
+	CHECK(n == 1);
+#endif
+	/* nothing is dirty any more */
+	CHECK(ShadowFlush(&w) == 0);
+	CHECK(w == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Tile row 0: tiles 0 and 2 (one clean tile between) and 5 (two clean
+   tiles after 2), a 2 * 3 tile block at tile 8, 2 and a pixel at the
+   screen corner (partial tile) */
+static void TestShadowMerge(void) {
+	uint32_t n, w, runs;
+	ST7796_ShadowFillRect(0 * T + 3, 5, 1, 1, 0xF800);
+	ST7796_ShadowDrawHLine(0x07E0, 2 * T, 7, T);
+	ST7796_ShadowDrawVLine(0x001F, 5 * T + T - 1, 0, T);
+	ST7796_ShadowFillRect(8 * T + 1, 2 * T + 1, 2 * T - 2, 3 * T - 2, 0xFFE0);
+	ST7796_ShadowWritePixel(ST7796_SIZE_X - 1, ST7796_SIZE_Y - 1, 0x1234);
+	CHECK(ST7796_ShadowReadPixel(0 * T + 3, 5) == 0xF800);
+	CHECK(ST7796_ShadowReadPixel(ST7796_SIZE_X, 0) == 0);
+	n = ShadowFlush(&w);
+	CHECK(ScreenDiff(testbuf) == 0);
+	CHECK(n == w);
+#if ST7796_SHADOW_MERGE == 0
+	runs = 3 + 6;
+#else
+#if ST7796_SHADOW_GAP >= 2
+	runs = 1;
+#elif ST7796_SHADOW_GAP == 1
+	runs = 2;
+#else
+	runs = 3;
+#endif
+#if ST7796_SHADOW_MERGE == 1
+	runs += 3;
+#else
+	runs += 1;
+#endif
+#endif
+	CHECK(n == runs + 1);
+
+	/* a direct change of the buffer is sent only after marking it */
+	testbuf[T * ST7796_SIZE_X + T] = 0xABCD;
+	CHECK(ShadowFlush(&w) == 0);
+	CHECK(ScreenPixel(T, T) != 0xABCD);
+	ST7796_ShadowMarkDirty(T, T, 1, 1);
+	CHECK(ShadowFlush(&w) == 1);
+	CHECK(ScreenDiff(testbuf) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* An image clipped at the right and bottom edge */
+static void TestShadowImage(void) {
+	uint32_t i, w;
+	for (i = 0; i < 40 * 3; i++)
+		testwork[i] = (uint16_t) rand();
+	ST7796_ShadowDrawRGBImage(ST7796_SIZE_X - 20, ST7796_SIZE_Y - 2, 40, 3,
+			testwork);
+	CHECK(ST7796_ShadowReadPixel(ST7796_SIZE_X - 1, ST7796_SIZE_Y - 2) == testwork[19]);
+	CHECK(ST7796_ShadowReadPixel(ST7796_SIZE_X - 20, ST7796_SIZE_Y - 1) == testwork[40]);
+	ShadowFlush(&w);
+	CHECK(ScreenDiff(testbuf) == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("shfull", TestShadowFull);
+	Run("shmerge", TestShadowMerge);
+	Run("shimage", TestShadowImage);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
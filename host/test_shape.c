@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @file    test_shape.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 shape rasterizer: the spans of lines, round
+ *          rectangles, circles and triangles against simple references.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_shape.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+//-----------------------------------------------------------------------------
+/* Horizontal and vertical lines (clipped at the screen edges), a diagonal
+   line and a round rectangle without corners */
+static void TestShapeLine(void) {
+	uint16_t i;
+	RefFill(testref, 0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_DrawLine(-10, 30, ST7796_SIZE_X + 10, 30, 0xFFFF);
+	RefFill(testref, 0, 30, ST7796_SIZE_X, 1, 0xFFFF);
+	ST7796_DrawLine(70, 0, 70, 300, 0x07E0);
+	RefFill(testref, 70, 0, 1, 301, 0x07E0);
+	ST7796_FillRoundRect(100, 100, 60, 40, 0, 0xF800);
+	RefFill(testref, 100, 100, 60, 40, 0xF800);
+	ST7796_DrawLine(200, 50, 150, 100, 0x001F);
+	for (i = 0; i <= 50; i++)
+		testref[(50 + i) * ST7796_SIZE_X + 200 - i] = 0x001F;
+	CHECK(ScreenDiff(testref) == 0);
+}
+
+//-----------------------------------------------------------------------------
+/* Filled circle: symmetric, inside the radius, the area about pi * r * r */
+static void TestShapeCircle(void) {
+	int32_t x, y, r = 40, inside = 0, bad = 0;
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_FillCircle(150, 200, r, 0x001F);
+	for (y = -r - 2; y <= r + 2; y++)
+		for (x = -r - 2; x <= r + 2; x++)
+			if (ScreenPixel(150 + x, 200 + y) == 0x001F) {
+				inside++;
+				if ((x * x + y * y > (r + 1) * (r + 1))
+						|| (ScreenPixel(150 - x, 200 - y) != 0x001F))
+					bad++;
+			}
+	CHECK(bad == 0);
+	CHECK((inside > 3 * r * r) && (inside < 4 * r * r));
+}
+
+//-----------------------------------------------------------------------------
+/* Filled right triangle: nothing outside of the legs and the hypotenuse,
+   the area about a half of the bounding rectangle */
+static void TestShapeTriangle(void) {
+	int32_t x, y, w = 80, h = 60, inside = 0, bad = 0;
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_FillTriangle(20, 20, 20 + w, 20, 20, 20 + h, 0xF81F);
+	for (y = -2; y <= h + 2; y++)
+		for (x = -2; x <= w + 2; x++)
+			if (ScreenPixel(20 + x, 20 + y) == 0xF81F) {
+				inside++;
+				if ((x < 0) || (y < 0) || (x * h + y * w > w * h + w + h))
+					bad++;
+			}
+	CHECK(bad == 0);
+	CHECK((inside > w * h / 2 - w - h) && (inside < w * h / 2 + w + h));
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("shapeline", TestShapeLine);
+	Run("shapecircle", TestShapeCircle);
+	Run("shapetri", TestShapeTriangle);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
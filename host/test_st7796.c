@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file    test_st7796.c
+ * @author  MCD Application Team
+ * @brief   Pixel tests of the st7796 driver primitives on the panel emulator.
+ *          The drawn pixels are compared with the screen of the emulated
+ *          panel (st7796_sim.c) and with a software reference.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+//-----------------------------------------------------------------------------
+static void TestFill(void) {
+	ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_FillRect(10, 20, 30, 40, 0xF800);
+	CHECK(ScreenPixel(10, 20) == 0xF800);
+	CHECK(ScreenPixel(39, 59) == 0xF800);
+	CHECK(ScreenPixel(40, 59) == 0x0000);
+	CHECK(ScreenPixel(39, 60) == 0x0000);
+	CHECK(ScreenPixel(9, 20) == 0x0000);
+
+	ST7796_DrawHLine(0x07E0, 0, 100, ST7796_SIZE_X);
+	ST7796_DrawVLine(0x001F, 200, 0, ST7796_SIZE_Y);
+	CHECK(ScreenPixel(0, 100) == 0x07E0);
+	CHECK(ScreenPixel(ST7796_SIZE_X - 1, 100) == 0x07E0);
+	CHECK(ScreenPixel(200, ST7796_SIZE_Y - 1) == 0x001F);
+	CHECK(ScreenPixel(200, 100) == 0x001F);
+	CHECK(ScreenPixel(201, 101) == 0x0000);
+}
+
+//-----------------------------------------------------------------------------
+static void TestPixel(void) {
+	ST7796_WritePixel(5, 6, 0x1234);
+	ST7796_WritePixel(ST7796_SIZE_X - 1, ST7796_SIZE_Y - 1, 0xABCD);
+	CHECK(ScreenPixel(5, 6) == 0x1234);
+	CHECK(ScreenPixel(ST7796_SIZE_X - 1, ST7796_SIZE_Y - 1) == 0xABCD);
+	CHECK(ST7796_ReadPixel(5, 6) == 0x1234);
+	CHECK(ST7796_ReadPixel(ST7796_SIZE_X - 1, ST7796_SIZE_Y - 1) == 0xABCD);
+}
+
+//-----------------------------------------------------------------------------
+static void TestImage(void) {
+	uint32_t i, n = 50 * 60, bad = 0;
+	for (i = 0; i < n; i++)
+		testref[i] = (uint16_t) rand();
+	ST7796_DrawRGBImage(100, 200, 50, 60, testref);
+	for (i = 0; i < n; i++)
+		if (ScreenPixel(100 + i % 50, 200 + i / 50) != testref[i])
+			bad++;
+	CHECK(bad == 0);
+	memset(testbuf, 0, n * 2);
+	ST7796_ReadRGBImage(100, 200, 50, 60, testbuf);
+	CHECK(memcmp(testbuf, testref, n * 2) == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("fill", TestFill);
+	Run("pixel", TestPixel);
+	Run("image", TestImage);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
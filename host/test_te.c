@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file    test_te.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 tearing effect synchronized presentation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "st7796.h"
+#include "st7796_te.h"
+#include "test.h"
+
+//-----------------------------------------------------------------------------
+static void TeFlush(void *pParam) {
+	(*(uint32_t *) pParam)++;
+}
+
+//-----------------------------------------------------------------------------
+/* A rectangle outside of the screen is not sent (no TE source needed) */
+static void TestTe(void) {
+	uint32_t flushes = 0;
+	CHECK(ST7796_TePresent(ST7796_SIZE_X, 0, 10, 10, TeFlush, &flushes) == 0);
+	CHECK(ST7796_TePresent(0, ST7796_SIZE_Y + 5, 10, 10, TeFlush, &flushes) == 0);
+	CHECK(ST7796_TePresent(0, 0, 0, 10, TeFlush, &flushes) == 0);
+	CHECK(flushes == 0);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("te", TestTe);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
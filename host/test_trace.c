@@ -0,0 +1,210 @@
+/**
+ ******************************************************************************
+ * @file    test_trace.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 trace (ST7796_TRACE 1): the counters of the
+ *          primitives against the traffic of the emulated panel, the nested
+ *          primitives and the event ring buffer.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_trace.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+static uint32_t tracetime;             /* time source: one tick / call */
+static uint16_t img[20 * 30];
+
+/* The traffic of the emulated panel when the primitive started */
+static ST7796_TraceCountTypeDef tracecnt;
+static uint32_t tracebytes, tracecmds, tracemad, tracecol;
+
+//-----------------------------------------------------------------------------
+static uint32_t TraceGetTime(void) {
+	return ++tracetime;
+}
+
+//-----------------------------------------------------------------------------
+/* Bytes on the bus of the emulated panel (dummy read bytes included) */
+static uint32_t TraceSimBytes(void) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	return s->WrBytes + s->RdBytes + s->DummyBytes;
+}
+
+//-----------------------------------------------------------------------------
+/* Keep the counters of a primitive and the traffic of the emulated panel */
+static void TraceStart(uint8_t Prim) {
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	tracecnt = *ST7796_TraceGetCount(Prim);
+	tracebytes = TraceSimBytes();
+	tracecmds = s->Cmds;
+	tracemad = s->CmdCnt[ST7796_MADCTL];
+	tracecol = s->CmdCnt[ST7796_COLOR_MODE];
+}
+
+//-----------------------------------------------------------------------------
+/* 1: one more call of the primitive with Pixels, the bus traffic of the
+   emulated panel since TraceStart is counted there */
+static uint8_t TraceCounted(uint8_t Prim, uint32_t Pixels) {
+	const ST7796_TraceCountTypeDef *c = ST7796_TraceGetCount(Prim);
+	const ST7796_SimStatTypeDef *s = ST7796_Sim_GetStat();
+	/* the 24 bit pixel transfers are split into several transactions */
+	uint8_t split = (Prim == ST7796_TR_READIMAGE) ? (ST7796_READBITDEPTH == 24)
+			: (ST7796_WRITEBITDEPTH == 24);
+	return (c->Calls == tracecnt.Calls + 1)
+			&& (c->Pixels == tracecnt.Pixels + Pixels)
+			&& (c->BusBytes - tracecnt.BusBytes == TraceSimBytes() - tracebytes)
+			&& (c->BusBytes > tracecnt.BusBytes)
+			&& (split || (c->Cmds - tracecnt.Cmds == s->Cmds - tracecmds))
+			&& (c->Madctl - tracecnt.Madctl == s->CmdCnt[ST7796_MADCTL] - tracemad)
+			&& (c->Colmod - tracecnt.Colmod == s->CmdCnt[ST7796_COLOR_MODE] - tracecol)
+			&& (c->TimeSum > tracecnt.TimeSum);
+}
+
+//-----------------------------------------------------------------------------
+/* The counters of every primitive of the single panel interface and the
+   traffic outside of the primitives */
+static void TestTraceCount(void) {
+	ST7796_TraceEventTypeDef e;
+	uint32_t i;
+	for (i = 0; i < 20 * 30; i++)
+		img[i] = (uint16_t) rand();
+	ST7796_TraceInit(TraceGetTime);
+	for (i = 0; i < ST7796_TR_NUM; i++)
+		CHECK(ST7796_TraceGetCount(i)->Calls == 0);
+
+	TraceStart(ST7796_TR_FILLRECT);
+	ST7796_FillRect(10, 10, 100, 50, 0xF800);
+	CHECK(TraceCounted(ST7796_TR_FILLRECT, 100 * 50));
+	TraceStart(ST7796_TR_WRITEPIXEL);
+	ST7796_WritePixel(200, 5, 0x07E0);
+	CHECK(TraceCounted(ST7796_TR_WRITEPIXEL, 1));
+	TraceStart(ST7796_TR_HLINE);
+	ST7796_DrawHLine(0x001F, 5, 100, 80);
+	CHECK(TraceCounted(ST7796_TR_HLINE, 80));
+	TraceStart(ST7796_TR_VLINE);
+	ST7796_DrawVLine(0x001F, 5, 100, 70);
+	CHECK(TraceCounted(ST7796_TR_VLINE, 70));
+	TraceStart(ST7796_TR_RGBIMAGE);
+	ST7796_DrawRGBImage(50, 150, 20, 30, img);
+	CHECK(TraceCounted(ST7796_TR_RGBIMAGE, 20 * 30));
+	TraceStart(ST7796_TR_TRANSFORM);
+	ST7796_DrawRGBImageTransform(100, 150, 20, 30, img, ST7796_ROT_90);
+	CHECK(TraceCounted(ST7796_TR_TRANSFORM, 20 * 30));
+	CHECK(ST7796_TraceGetCount(ST7796_TR_TRANSFORM)->Madctl > 0);
+	TraceStart(ST7796_TR_READIMAGE);
+	ST7796_ReadRGBImage(50, 150, 20, 30, testbuf);
+	CHECK(TraceCounted(ST7796_TR_READIMAGE, 20 * 30));
+	TraceStart(ST7796_TR_READPIXEL);
+	CHECK(ST7796_ReadPixel(200, 5) == 0x07E0);
+	CHECK(TraceCounted(ST7796_TR_READPIXEL, 1));
+	TraceStart(ST7796_TR_SCROLL);
+	ST7796_Scroll(0, 0, 0);
+	CHECK(TraceCounted(ST7796_TR_SCROLL, 0));
+	TraceStart(ST7796_TR_COMMAND);
+	ST7796_SetOrientation((ST7796_ORIENTATION + 1) & 3);
+	CHECK(TraceCounted(ST7796_TR_COMMAND, 0));
+	ST7796_SetOrientation(ST7796_ORIENTATION);
+
+	/* the panel interface outside of the primitives */
+	TraceStart(ST7796_TR_OTHER);
+	ST7796_Panel_FillRect(&hst7796, 0, 0, 10, 10, 0x0000);
+	CHECK(ST7796_TraceGetCount(ST7796_TR_OTHER)->Calls == 0);
+	CHECK(ST7796_TraceGetCount(ST7796_TR_OTHER)->BusBytes - tracecnt.BusBytes
+			== TraceSimBytes() - tracebytes);
+
+	/* the events of the primitives in order, the MADCTL switch flagged */
+	CHECK(ST7796_TraceRead(&e) && (e.Prim == ST7796_TR_FILLRECT)
+			&& (e.Pixels == 100 * 50) && (e.Duration > 0));
+	for (i = 1; i < 5; i++)
+		CHECK(ST7796_TraceRead(&e));
+	CHECK(e.Prim == ST7796_TR_RGBIMAGE);
+	CHECK(ST7796_TraceRead(&e) && (e.Prim == ST7796_TR_TRANSFORM)
+			&& (e.Flags & ST7796_TRF_MADCTL));
+	CHECK(e.BusBytes == ST7796_TraceGetCount(ST7796_TR_TRANSFORM)->BusBytes);
+}
+
+//-----------------------------------------------------------------------------
+/* The primitives inside of an other primitive are counted there (one call,
+   one event, the depth is back at 0 after the outer end) */
+static void TestTraceNested(void) {
+	ST7796_TraceEventTypeDef e;
+	ST7796_TraceInit(TraceGetTime);
+	TraceStart(ST7796_TR_BITMAP);
+	ST7796_TraceBegin(ST7796_TR_BITMAP, 7);
+	ST7796_FillRect(10, 10, 20, 20, 0xFFFF);
+	ST7796_TraceBegin(ST7796_TR_SCROLL, 0);
+	ST7796_WritePixel(1, 1, 0x0000);
+	ST7796_TraceEnd();
+	ST7796_DrawHLine(0x1234, 0, 50, 30);
+	ST7796_TraceEnd();
+	CHECK(TraceCounted(ST7796_TR_BITMAP, 7));
+	CHECK(ST7796_TraceGetCount(ST7796_TR_FILLRECT)->Calls == 0);
+	CHECK(ST7796_TraceGetCount(ST7796_TR_WRITEPIXEL)->Calls == 0);
+	CHECK(ST7796_TraceGetCount(ST7796_TR_SCROLL)->Calls == 0);
+	CHECK(ST7796_TraceGetCount(ST7796_TR_HLINE)->Calls == 0);
+	CHECK(ST7796_TraceRead(&e) && (e.Prim == ST7796_TR_BITMAP));
+	CHECK(ST7796_TraceRead(&e) == 0);
+
+	/* the next primitive is an outer one again */
+	TraceStart(ST7796_TR_HLINE);
+	ST7796_DrawHLine(0x1234, 0, 51, 30);
+	CHECK(TraceCounted(ST7796_TR_HLINE, 30));
+	CHECK(ST7796_TraceRead(&e) && (e.Prim == ST7796_TR_HLINE));
+}
+
+//-----------------------------------------------------------------------------
+/* A full ring drops the new events, the free running indexes wrap over the
+   end of the ring, the events are read in order */
+static void TestTraceRing(void) {
+	ST7796_TraceEventTypeDef e;
+	uint32_t i, n = 0, bad = 0;
+	ST7796_TraceInit(TraceGetTime);
+	for (i = 0; i < ST7796_TRACE_RING + 10; i++)
+		ST7796_FillRect(0, 0, 1, 1 + i, 0x0000);
+	CHECK(st7796_tracering.Dropped == 10);
+	CHECK(st7796_tracering.Head - st7796_tracering.Tail == ST7796_TRACE_RING);
+	CHECK(ST7796_TraceGetCount(ST7796_TR_FILLRECT)->Calls == ST7796_TRACE_RING + 10);
+	for (i = 0; i < ST7796_TRACE_RING / 2 + 3; i++)
+		if (!ST7796_TraceRead(&e) || (e.Pixels != 1 + n++))
+			bad++;
+	/* the new events go into the read slots at the start of the ring */
+	for (i = 0; i < ST7796_TRACE_RING / 2; i++)
+		ST7796_FillRect(0, 0, 1, 1000 + i, 0x0000);
+	CHECK(st7796_tracering.Dropped == 10);
+	while (n < ST7796_TRACE_RING)
+		if (!ST7796_TraceRead(&e) || (e.Pixels != 1 + n++))
+			bad++;
+	for (i = 0; i < ST7796_TRACE_RING / 2; i++)
+		if (!ST7796_TraceRead(&e) || (e.Pixels != 1000 + i))
+			bad++;
+	CHECK(bad == 0);
+	CHECK(ST7796_TraceRead(&e) == 0);
+	CHECK(st7796_tracering.Head == st7796_tracering.Tail);
+	CHECK(st7796_tracering.Head > ST7796_TRACE_RING);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("tracecnt", TestTraceCount);
+	Run("tracenest", TestTraceNested);
+	Run("tracering", TestTraceRing);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
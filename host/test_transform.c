@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file    test_transform.c
+ * @author  MCD Application Team
+ * @brief   Tests of the st7796 rotated and mirrored image drawing: every
+ *          transform is drawn in every orientation and compared with an
+ *          image rotated by the CPU.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_sim.h"
+#include "test.h"
+
+#define IMG_W            23
+#define IMG_H            11
+#define IMG_STEP         30            /* distance of the drawn images */
+
+static uint16_t img[IMG_W * IMG_H];
+
+//-----------------------------------------------------------------------------
+/* The image mirrored (ST7796_FLIP_X), then rotated clockwise into the
+   reference at Xpos, Ypos */
+static void RefTransform(uint16_t Xpos, uint16_t Ypos, uint8_t Transform) {
+	uint16_t x, y, sx, u, v;
+	for (y = 0; y < IMG_H; y++)
+		for (x = 0; x < IMG_W; x++) {
+			sx = (Transform & ST7796_FLIP_X) ? IMG_W - 1 - x : x;
+			switch (Transform & 3) {
+			case ST7796_ROT_0:
+				u = x;
+				v = y;
+				break;
+			case ST7796_ROT_90:
+				u = IMG_H - 1 - y;
+				v = x;
+				break;
+			case ST7796_ROT_180:
+				u = IMG_W - 1 - x;
+				v = IMG_H - 1 - y;
+				break;
+			default:
+				u = y;
+				v = IMG_W - 1 - x;
+				break;
+			}
+			testref[(Ypos + v) * ST7796_SIZE_X + Xpos + u] = img[y * IMG_W + sx];
+		}
+}
+
+//-----------------------------------------------------------------------------
+/* The 8 transforms in the 4 orientations: the first row by the single panel
+   interface, the second by the panel interface, then an untransformed image
+   (the drawing direction is restored) */
+static void TestTransform(void) {
+	uint32_t i;
+	uint8_t o, t;
+	for (i = 0; i < IMG_W * IMG_H; i++)
+		img[i] = (uint16_t) rand();
+	for (o = 0; o < 4; o++) {
+		ST7796_SetOrientation(o);
+		CHECK(ST7796_GetOrientation() == o);
+		ST7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+		RefFill(testref, 0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+		for (t = 0; t < 8; t++) {
+			ST7796_DrawRGBImageTransform(5 + t * IMG_STEP, 5, IMG_W, IMG_H, img, t);
+			RefTransform(5 + t * IMG_STEP, 5, t);
+			ST7796_Sync();
+			ST7796_Panel_DrawRGBImageTransform(&hst7796, 5 + t * IMG_STEP,
+					5 + IMG_STEP, IMG_W, IMG_H, img, t);
+			RefTransform(5 + t * IMG_STEP, 5 + IMG_STEP, t);
+		}
+		/* at the bottom right corner */
+		ST7796_DrawRGBImageTransform(ST7796_SIZE_X - IMG_H, ST7796_SIZE_Y - IMG_W,
+				IMG_W, IMG_H, img, ST7796_ROT_270 | ST7796_FLIP_X);
+		RefTransform(ST7796_SIZE_X - IMG_H, ST7796_SIZE_Y - IMG_W,
+				ST7796_ROT_270 | ST7796_FLIP_X);
+		ST7796_DrawRGBImage(5, 3 * IMG_STEP, IMG_W, IMG_H, img);
+		RefTransform(5, 3 * IMG_STEP, ST7796_ROT_0);
+		CHECK(ScreenDiff(testref) == 0);
+	}
+	ST7796_SetOrientation(ST7796_ORIENTATION);
+}
+
+//-----------------------------------------------------------------------------
+void TestRun(void) {
+	Run("transform", TestTransform);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -5,297 +5,518 @@
  * @brief   This file includes the driver for ST7796 LCD mounted on the Adafruit
  *          1.8" TFT LCD shield (reference ID 802).
  ******************************************************************************
+ */
 
- /* Includes ------------------------------------------------------------------*/
+/* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "lcd.h"
 #include "lcd_io.h"
 #include "bmp.h"
 #include "st7796.h"
 #include "st7796_reg.h"
+#include "st7796_conv.h"
+#if ST7796_DLIST == 1
+#include "st7796_dlist.h"
+/* while the display list is recording, store the primitive and return */
+#define ST7796_DLISTRECORD(Type, Xpos, Ypos, Xsize, Ysize, RGBCode, pData) \
+  { if(ST7796_DListRecord(Type, Xpos, Ypos, Xsize, Ysize, RGBCode, pData)) return; }
+/* the other functions depend on the LCD content or state: send the pending primitives */
+#define ST7796_DLISTSYNC()        ST7796_DListFlush()
+/* (re)initialization: the pending primitives are not valid any more */
+#define ST7796_DLISTDROP()        ST7796_DListDrop()
+#else
+#define ST7796_DLISTRECORD(Type, Xpos, Ypos, Xsize, Ysize, RGBCode, pData)
+#define ST7796_DLISTSYNC()
+#define ST7796_DLISTDROP()
+#endif
+#if ST7796_ASYNC == 1
+#include "st7796_async.h"
+/* the blocking functions must not interleave with the queued transfers */
+#define ST7796_ASYNCWAIT()        ST7796_AsyncWait()
+#else
+#define ST7796_ASYNCWAIT()
+#endif
+#if ST7796_POWER == 1
+#include "st7796_power.h"
+/* only the partial display area is drawn */
+#define ST7796_POWERCLIP(pX, pY, pW, pH) \
+  { if(!ST7796_PowerClip(pX, pY, pW, pH)) return; }
+#else
+#define ST7796_POWERCLIP(pX, pY, pW, pH)
+#endif
+#if ST7796_TRACE == 1
+#include "st7796_trace.h"
+/* per primitive counters and trace events */
+#define ST7796_TRACEBEGIN(Prim, Pixels) ST7796_TraceBegin(Prim, Pixels)
+#define ST7796_TRACEEND()         ST7796_TraceEnd()
+#define ST7796_TRACEBUS(Cmd, Bytes) ST7796_TraceBus(Cmd, Bytes)
+#else
+#define ST7796_TRACEBEGIN(Prim, Pixels)
+#define ST7796_TRACEEND()
+#define ST7796_TRACEBUS(Cmd, Bytes)
+#endif
 
 LCD_DrvTypeDef st7796_drv = {
-		st7796_Init,
-		st7796_ReadID,
-		st7796_DisplayOn,
-		st7796_DisplayOff,
-		st7796_SetCursor,
-		st7796_WritePixel,
-		st7796_ReadPixel,
-		st7796_SetDisplayWindow,
-		st7796_DrawHLine,
-		st7796_DrawVLine,
-		st7796_GetLcdPixelWidth,
-		st7796_GetLcdPixelHeight,
-		st7796_DrawBitmap,
-		st7796_DrawRGBImage,
-		st7796_FillRect,
-		st7796_ReadRGBImage,
-		st7796_Scroll,
-		st7796_UserCommand
+		ST7796_Init,
+		ST7796_ReadID,
+		ST7796_DisplayOn,
+		ST7796_DisplayOff,
+		ST7796_SetCursor,
+		ST7796_WritePixel,
+		ST7796_ReadPixel,
+		ST7796_SetDisplayWindow,
+		ST7796_DrawHLine,
+		ST7796_DrawVLine,
+		ST7796_GetLcdPixelWidth,
+		ST7796_GetLcdPixelHeight,
+		ST7796_DrawBitmap,
+		ST7796_DrawRGBImage,
+		ST7796_FillRect,
+		ST7796_ReadRGBImage,
+		ST7796_Scroll,
+		ST7796_UserCommand
 };
 
-#define TRANSDATAMAXSIZE  4
-union {
-	char c[TRANSDATAMAXSIZE];
-	uint8_t d8[TRANSDATAMAXSIZE];
-	uint16_t d16[TRANSDATAMAXSIZE / 2];
-} transdata;
-
-int32_t ST7796_Init(void) {
-	if ((Is_st7796_Initialized & st7796_LCD_INITIALIZED) == 0) {
-		Is_st7796_Initialized |= st7796_LCD_INITIALIZED;
-		if ((Is_st7796_Initialized & st7796_IO_INITIALIZED) == 0)
-			LCD_IO_Init();
-		Is_st7796_Initialized |= st7796_IO_INITIALIZED;
-	}
-
-	LCD_Delay(120);
-
-	/* software reset, 0 arguments, no delay */
-	LCD_IO_WriteCmd8MultipleData8(ST7796_SW_RESET, NULL, 0);
-	LCD_Delay(120);
-
-	/* color mode (16 or 24 bit) */
-#if ST7796_WRITEBITDEPTH == 16
-	LCD_IO_WriteCmd8MultipleData8(ST7796_COLOR_MODE, (uint8_t*) "\x55", 1);
-#elif ST7796_WRITEBITDEPTH == 24
-		LCD_IO_WriteCmd8MultipleData8(ST7796_COLOR_MODE, (uint8_t *)"\x66", 1);
-	#endif
-	LCD_Delay(50);
-
-	LCD_IO_WriteCmd8MultipleData8(ST7796_VERT_SCROLLING_ADDR, (uint8_t*) "\x00",
-			1);
-	LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-
-	/* Out of sleep mode, 0 arguments, no delay */
-	LCD_IO_WriteCmd8MultipleData8(ST7796_SLEEP_OUT, NULL, 0);
-	LCD_Delay(120);
-
-	/* Enable extension command 2, 2 arguments, no delay*/
-	LCD_IO_WriteCmd8MultipleData8(ST7796_COM_SET_CTRL, (uint8_t*) "\xC3\x96",
-			2);
-
-	/* Memory Data Access Control, 1 arguments, no delay  */
-	/*	MX = 0, MY = 0: (0,0) is top left,  (319, 479) is bottom right
-	 * RGB = 0 data is sent in RGB order
-	 **/
-	LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-
-	/* Display Inversion Control, 1 arguments, no delay */
-	/* set 1-dot inversion reduces flicker */
-	LCD_IO_WriteCmd8MultipleData8(ST7796_INV_CTRL, (uint8_t*) "\x01", 1);
-
-	/* Display Function Control, 3 arguments, no delay */
-	// Bypass
-	//Source Output Scan from S1 to S960, Gate Output scan from G1 to G480, scan cycle=2
-	// LCD Drive Line = 8*(59+1)
-	LCD_IO_WriteCmd8MultipleData8(ST7796_DISPLAY_SETTING,
-			(uint8_t*) "\x80\x02\x3B", 3);
+/* lcd_io transport of the single panel interface panel */
+static void LcdIoInit(void *pParam) {
+	(void) pParam;
+	LCD_IO_Init();
+}
+static void LcdIoDelay(void *pParam, uint32_t Delay) {
+	(void) pParam;
+	LCD_Delay(Delay);
+}
+static void LcdIoBlOnOff(void *pParam, uint8_t Bl) {
+	(void) pParam;
+	LCD_IO_Bl_OnOff(Bl);
+}
+static void LcdIoWriteCmd8DataFill16(void *pParam, uint8_t Cmd, uint16_t Data,
+		uint32_t Size) {
+	(void) pParam;
+	ST7796_TRACEBUS(Cmd, Size * 2);
+	LCD_IO_WriteCmd8DataFill16(Cmd, Data, Size);
+}
+static void LcdIoWriteCmd8MultipleData8(void *pParam, uint8_t Cmd,
+		uint8_t *pData, uint32_t Size) {
+	(void) pParam;
+	ST7796_TRACEBUS(Cmd, Size);
+	LCD_IO_WriteCmd8MultipleData8(Cmd, pData, Size);
+}
+static void LcdIoWriteCmd8MultipleData16(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size) {
+	(void) pParam;
+	ST7796_TRACEBUS(Cmd, Size * 2);
+	LCD_IO_WriteCmd8MultipleData16(Cmd, pData, Size);
+}
+static void LcdIoReadCmd8MultipleData8(void *pParam, uint8_t Cmd,
+		uint8_t *pData, uint32_t Size, uint32_t DummySize) {
+	(void) pParam;
+	ST7796_TRACEBUS(Cmd, Size + DummySize);
+	LCD_IO_ReadCmd8MultipleData8(Cmd, pData, Size, DummySize);
+}
+static void LcdIoReadCmd8MultipleData16(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size, uint32_t DummySize) {
+	(void) pParam;
+	ST7796_TRACEBUS(Cmd, Size * 2 + DummySize);
+	LCD_IO_ReadCmd8MultipleData16(Cmd, pData, Size, DummySize);
+}
+#if (ST7796_WRITEBITDEPTH == 24) || (ST7796_READBITDEPTH == 24)
+/* the 24 bit pixels are converted by the st7796_conv kernels through a line
+   buffer and sent with the 8 bit transfers, the next lines continue the
+   memory access */
+#define LCDIO_LINE    64
+static uint8_t lcdioline[LCDIO_LINE * 3];
+#endif
+#if ST7796_WRITEBITDEPTH == 24
+static void LcdIoWriteCmd8DataFill16to24(void *pParam, uint8_t Cmd,
+		uint16_t Data, uint32_t Size) {
+	uint32_t i, n;
+	(void) pParam;
+	ST7796_TRACEBUS(Cmd, Size * 3);
+	ST7796_Conv16to24(&Data, lcdioline, 1);
+	for (i = 3; i < sizeof(lcdioline); i++)
+		lcdioline[i] = lcdioline[i - 3];
+	do {
+		n = (Size > LCDIO_LINE) ? LCDIO_LINE : Size;
+		LCD_IO_WriteCmd8MultipleData8(Cmd, lcdioline, n * 3);
+		Cmd = ST7796_WRITE_RAM_CONT;
+		Size -= n;
+	} while (Size);
+}
+static void LcdIoWriteCmd8MultipleData16to24(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size) {
+	uint32_t n;
+	(void) pParam;
+	ST7796_TRACEBUS(Cmd, Size * 3);
+	do {
+		n = (Size > LCDIO_LINE) ? LCDIO_LINE : Size;
+		ST7796_Conv16to24(pData, lcdioline, n);
+		LCD_IO_WriteCmd8MultipleData8(Cmd, lcdioline, n * 3);
+		Cmd = ST7796_WRITE_RAM_CONT;
+		pData += n;
+		Size -= n;
+	} while (Size);
+}
+#else
+#define LcdIoWriteCmd8DataFill16to24      NULL
+#define LcdIoWriteCmd8MultipleData16to24  NULL
+#endif
+#if ST7796_READBITDEPTH == 24
+static void LcdIoReadCmd8MultipleData24to16(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size, uint32_t DummySize) {
+	uint32_t n;
+	(void) pParam;
+	/* every line is a read command with its dummy bytes */
+	ST7796_TRACEBUS(Cmd, Size * 3 + DummySize * ((Size + LCDIO_LINE - 1) / LCDIO_LINE));
+	do {
+		n = (Size > LCDIO_LINE) ? LCDIO_LINE : Size;
+		LCD_IO_ReadCmd8MultipleData8(Cmd, lcdioline, n * 3, DummySize);
+		ST7796_Conv24to16(lcdioline, pData, n);
+		Cmd = ST7796_READ_RAM_CONT;
+		pData += n;
+		Size -= n;
+	} while (Size);
+}
+#else
+#define LcdIoReadCmd8MultipleData24to16   NULL
+#endif
 
-	/* Display Output Control Adjust, 7 arguments, no delay*/
-	LCD_IO_WriteCmd8MultipleData8(ST7796_DISP_CTRL_ADJ,
-			(uint8_t*) "\x40\x8A\x00\x29\x19\xA5\x33", 8)
+const ST7796_PanelIoTypeDef ST7796_LcdIo = {
+		LcdIoInit,
+		LcdIoDelay,
+		LcdIoBlOnOff,
+		LcdIoWriteCmd8DataFill16,
+		LcdIoWriteCmd8MultipleData8,
+		LcdIoWriteCmd8MultipleData16,
+		LcdIoReadCmd8MultipleData8,
+		LcdIoReadCmd8MultipleData16,
+		LcdIoWriteCmd8DataFill16to24,
+		LcdIoWriteCmd8MultipleData16to24,
+		LcdIoReadCmd8MultipleData24to16
+};
 
-	/* Power Control 2, 1 arguments, no delay */
-	//VAP(GVDD)=3.85+( vcom+vcom offset), VAN(GVCL)=-3.85+( vcom+vcom offset)
-	LCD_IO_WriteCmd8MultipleData8(ST7796_PWR_CTRL2, (uint8_t*) "\x06", 1);
+/* the panel of the single panel interface */
+ST7796_PanelTypeDef hst7796 = ST7796_PANEL_INIT(&ST7796_LcdIo, NULL);
 
-	/* Power Control 3, 1 arguments, no delay */
-	// Source driving current level=low, Gamma driving current level=High
-	LCD_IO_WriteCmd8MultipleData8(ST7796_PWR_CTRL3, (uint8_t*) "\xA7", 1);
+/* drawing directions of the orientations (index: Orientation) */
+const uint8_t ST7796_MadRightThenUp[4] = { ST7796_MAD_RIGHT_THEN_UP_0,
+		ST7796_MAD_RIGHT_THEN_UP_1, ST7796_MAD_RIGHT_THEN_UP_2,
+		ST7796_MAD_RIGHT_THEN_UP_3 };
+const uint8_t ST7796_MadRightThenDown[4] = { ST7796_MAD_RIGHT_THEN_DOWN_0,
+		ST7796_MAD_RIGHT_THEN_DOWN_1, ST7796_MAD_RIGHT_THEN_DOWN_2,
+		ST7796_MAD_RIGHT_THEN_DOWN_3 };
 
-	/* VCOM Control 1, 1 arguments, no delay */
-	// VCOM=0.9
-	LCD_IO_WriteCmd8MultipleData8(ST7796_VCOMH_VCOML_CTRL1, (uint8_t*) "\x18",
-			1);
+/* call a transport function of a panel */
+#define PANEL_IO(h, Func, ...)    (h)->pIo->Func((h)->pIoParam, __VA_ARGS__)
 
-	LCD_Delay(120);
+/* set the drawing direction (an ST7796_MadRightThen* entry) when it differs
+   from the last set one */
+#define PANEL_SETENTRY(h, Mad) \
+  { if((h)->LastEntry != (Mad)) \
+    { (h)->LastEntry = (Mad); \
+      PANEL_IO(h, WriteCmd8MultipleData8, ST7796_MADCTL, (uint8_t *)&(Mad), 1); } }
 
-	/* Magical unicorn dust, 14 args, no delay */
-	// ST7796 Gamma Sequence
-	LCD_IO_WriteCmd8MultipleData8(ST7796_PV_GAMMA_CTRL,
-			(uint8_t*) "\xF0\x09\x0B\x06\x04\x15\x2F\x54\x42\x3C\x17\x14\x18\x1B",
-			14);
-	LCD_IO_WriteCmd8MultipleData8(ST7796_NV_GAMMA_CTRL,
-			(uint8_t*) "\xE0\x09\x0B\x06\x04\x03\x2B\x43\x42\x3B\x16\x14\x17\x1B",
-			14);
-	LCD_Delay(120);
+/* Default init sequence (format: see ST7796_INIT_WAIT) */
+const uint8_t ST7796_InitTable[] = {
+	/* software reset, 0 arguments */
+	ST7796_SW_RESET, ST7796_INIT_WAIT | 0, 120,
+	/* color mode (16 or 24 bit) */
+#if ST7796_WRITEBITDEPTH == 16
+	ST7796_COLOR_MODE, ST7796_INIT_DELAY | 1, 0x55, 50,
+#elif ST7796_WRITEBITDEPTH == 24
+	ST7796_COLOR_MODE, ST7796_INIT_DELAY | 1, 0x66, 50,
+#endif
+	ST7796_VERT_SCROLLING_ADDR, 1, 0x00,
+	ST7796_MADCTL, 0,
+	/* Out of sleep mode, 0 arguments */
+	ST7796_SLEEP_OUT, ST7796_INIT_WAIT | 0, 120,
+	/* Enable extension command 2, 2 arguments */
+	ST7796_COM_SET_CTRL, 2, 0xC3, 0x96,
+	/* Memory Data Access Control: the orientation */
+	ST7796_MADCTL, 0,
+	/* Display Inversion Control, 1 arguments: 1-dot inversion reduces flicker */
+	ST7796_INV_CTRL, 1, 0x01,
+	/* Display Function Control, 3 arguments: bypass, source output scan from
+	   S1 to S960, gate output scan from G1 to G480, scan cycle = 2,
+	   LCD drive line = 8 * (59 + 1) */
+	ST7796_DISPLAY_SETTING, 3, 0x80, 0x02, 0x3B,
+	/* Display Output Control Adjust, 8 arguments */
+	ST7796_DISP_CTRL_ADJ, 8, 0x40, 0x8A, 0x00, 0x00, 0x29, 0x19, 0xA5, 0x33,
+	/* Power Control 2, 1 arguments: VAP(GVDD) = 3.85 + (vcom + vcom offset),
+	   VAN(GVCL) = -3.85 + (vcom + vcom offset) */
+	ST7796_PWR_CTRL2, 1, 0x06,
+	/* Power Control 3, 1 arguments: source driving current level = low,
+	   gamma driving current level = high */
+	ST7796_PWR_CTRL3, 1, 0xA7,
+	/* VCOM Control 1, 1 arguments: VCOM = 0.9 */
+	ST7796_VCOMH_VCOML_CTRL1, ST7796_INIT_DELAY | 1, 0x18, 120,
+	/* ST7796 Gamma Sequence, 14 arguments */
+	ST7796_PV_GAMMA_CTRL, 14, 0xF0, 0x09, 0x0B, 0x06, 0x04, 0x15, 0x2F, 0x54,
+			0x42, 0x3C, 0x17, 0x14, 0x18, 0x1B,
+	ST7796_NV_GAMMA_CTRL, ST7796_INIT_DELAY | 14, 0xE0, 0x09, 0x0B, 0x06, 0x04,
+			0x03, 0x2B, 0x43, 0x42, 0x3B, 0x16, 0x14, 0x17, 0x1B, 120,
+	/* Command Set Control, 1 arguments */
+	ST7796_COM_SET_CTRL, 1, 0x3C,
+	ST7796_COM_SET_CTRL, ST7796_INIT_DELAY | 1, 0x69, 120,
+	/* Normal display on, no args */
+	ST7796_NORMAL_DISPLAY_OFF, 0,
+	/* Main screen turn on, no args */
+	ST7796_DISPLAY_ON, 0,
+	ST7796_INIT_END
+};
 
-	/* Command Set Control, 1 arguments, no delay */
-	LCD_IO_WriteCmd8MultipleData8(ST7796_COM_SET_CTRL, (uint8_t*) "\x3C", 1);
-	LCD_IO_WriteCmd8MultipleData8(ST7796_COM_SET_CTRL, (uint8_t*) "\x69", 1);
+//-----------------------------------------------------------------------------
+/* Init delay, the boot work callback runs in it */
+static void PanelBootWait(ST7796_PanelTypeDef *hpanel, uint32_t Ms) {
+	uint32_t done = 0;
+	if (hpanel->pBootWork)
+		done = hpanel->pBootWork(Ms);
+	if (done < Ms)
+		PANEL_IO(hpanel, Delay, Ms - done);
+}
 
-	LCD_Delay(pObj, 120);
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Initialize the ST7796 LCD.
+ * @param  hpanel: panel handle
+ * @retval None
+ * @brief  The commands are sent from hpanel->pInitTable (NULL: ST7796_InitTable)
+ */
+void ST7796_Panel_Init(ST7796_PanelTypeDef *hpanel) {
+	const uint8_t *p = hpanel->pInitTable ? hpanel->pInitTable : ST7796_InitTable;
+	uint8_t cmd, n, delay;
+	if ((hpanel->Initialized & ST7796_LCD_INITIALIZED) == 0) {
+		hpanel->Initialized |= ST7796_LCD_INITIALIZED;
+		if ((hpanel->Initialized & ST7796_IO_INITIALIZED) == 0)
+			hpanel->pIo->Init(hpanel->pIoParam);
+		hpanel->Initialized |= ST7796_IO_INITIALIZED;
+	}
 
-	/* Display On, 1 arguments, no delay */
-	/* Normal display on, no args, no delay */
-	LCD_IO_WriteCmd8MultipleData8(ST7796_NORMAL_DISPLAY_OFF, NULL, 0);
+#if ST7796_FASTBOOT == 0
+	PanelBootWait(hpanel, 120);
+#endif
 
-	/* Main screen turn on, no delay */
-	LCD_IO_WriteCmd8MultipleData8(ST7796_DISPLAY_ON, NULL, 0);
+	/* the software reset clears the window */
+	ST7796_PANEL_INVALIDATEWINDOW(hpanel);
+	while ((cmd = *p++) != ST7796_INIT_END) {
+		n = *p & ST7796_INIT_ARGS;
+		delay = *p++ & (ST7796_INIT_WAIT | ST7796_INIT_DELAY);
+		if ((cmd == ST7796_MADCTL) && (n == 0)) {
+			hpanel->LastEntry = ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel);
+			PANEL_IO(hpanel, WriteCmd8MultipleData8, ST7796_MADCTL,
+					&hpanel->LastEntry, 1);
+		} else
+			PANEL_IO(hpanel, WriteCmd8MultipleData8, cmd, (uint8_t*) p, n);
+		p += n;
+		if (delay) {
+#if ST7796_FASTBOOT == 1
+			if (delay & ST7796_INIT_WAIT)
+#endif
+				PanelBootWait(hpanel, *p);
+			p++;
+		}
+	}
+#if ST7796_WRITEBITDEPTH != ST7796_READBITDEPTH
+	hpanel->LastDir = 0;
+#endif
 
-#if st7796_INITCLEAR == 1
-		st7796_FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
-		LCD_Delay(10);
-	#endif
+#if ST7796_INITCLEAR == 1
+	ST7796_Panel_FillRect(hpanel, 0, 0, ST7796_PANEL_SIZE_X(hpanel),
+			ST7796_PANEL_SIZE_Y(hpanel), 0x0000);
+#if ST7796_FASTBOOT == 0
+	PANEL_IO(hpanel, Delay, 10);
+#endif
+#endif
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Enables the Display.
- * @param  None
+ * @param  hpanel: panel handle
  * @retval None
  */
-void ST7796_DisplayOn(void) {
-	LCD_IO_Bl_OnOff(1);
-	LCD_IO_WriteCmd8MultipleData8(ST7796_SLEEP_OUT, NULL, 0); /* Exit Sleep */
+void ST7796_Panel_DisplayOn(ST7796_PanelTypeDef *hpanel) {
+	PANEL_IO(hpanel, Bl_OnOff, 1);
+	PANEL_IO(hpanel, WriteCmd8MultipleData8, ST7796_SLEEP_OUT, NULL, 0); /* Exit Sleep */
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Disables the Display.
- * @param  None
+ * @param  hpanel: panel handle
  * @retval None
  */
-void ST7796_DisplayOff(void) {
-	LCD_IO_WriteCmd8MultipleData8(ST7796_SLEEP_IN, NULL, 0); /* Sleep */
-	LCD_IO_Bl_OnOff(0);
+void ST7796_Panel_DisplayOff(ST7796_PanelTypeDef *hpanel) {
+	PANEL_IO(hpanel, WriteCmd8MultipleData8, ST7796_SLEEP_IN, NULL, 0); /* Sleep */
+	PANEL_IO(hpanel, Bl_OnOff, 0);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Get the LCD pixel Width.
- * @param  None
+ * @param  hpanel: panel handle
  * @retval The Lcd Pixel Width
  */
-uint16_t ST7796_GetLcdPixelWidth(void) {
-	return ST7796_SIZE_X;
+uint16_t ST7796_Panel_GetLcdPixelWidth(ST7796_PanelTypeDef *hpanel) {
+	return ST7796_PANEL_SIZE_X(hpanel);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Get the LCD pixel Height.
- * @param  None
+ * @param  hpanel: panel handle
  * @retval The Lcd Pixel Height
  */
-uint16_t ST7796_GetLcdPixelHeight(void) {
-	return ST7796_SIZE_Y;
+uint16_t ST7796_Panel_GetLcdPixelHeight(ST7796_PanelTypeDef *hpanel) {
+	return ST7796_PANEL_SIZE_Y(hpanel);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Get the ST7796 ID.
- * @param  None
+ * @param  hpanel: panel handle
  * @retval The ST7796 ID
  */
-uint32_t ST7796_ReadID(void) {
+uint32_t ST7796_Panel_ReadID(ST7796_PanelTypeDef *hpanel) {
 	uint32_t dt = 0;
-	LCD_IO_ReadCmd8MultipleData8(ST7796_READ_ID, (uint8_t*) &dt, 3, 1);
+	PANEL_IO(hpanel, ReadCmd8MultipleData8, ST7796_READ_ID, (uint8_t*) &dt, 3, 1);
 	return dt;
 }
 //-----------------------------------------------------------------------------
 /**
  * @brief  Set Cursor position.
+ * @param  hpanel: panel handle
  * @param  Xpos: specifies the X position.
  * @param  Ypos: specifies the Y position.
  * @retval None
  */
-void ST7796_SetCursor(uint16_t Xpos, uint16_t Ypos) {
-	ST7796_SETCURSOR(Xpos, Ypos);
+void ST7796_Panel_SetCursor(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos) {
+	ST7796_PANEL_SETCURSOR(hpanel, Xpos, Ypos);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Write pixel.
+ * @param  hpanel: panel handle
  * @param  Xpos: specifies the X position.
  * @param  Ypos: specifies the Y position.
  * @param  RGBCode: the RGB pixel color
  * @retval None
  */
-void ST7796_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode) {
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_DOWN) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-	}
-	ST7796_SETCURSOR(Xpos, Ypos);
-	LCD_IO_DrawFill(RGBCode, 1);
+void ST7796_Panel_WritePixel(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_PANEL_SETCURSOR(hpanel, Xpos, Ypos);
+	ST7796_PANEL_DRAWFILL(hpanel, RGBCode, 1);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Read pixel.
- * @param  None
+ * @param  hpanel: panel handle
  * @retval the RGB pixel color
  */
-uint16_t ST7796_ReadPixel(uint16_t Xpos, uint16_t Ypos) {
+uint16_t ST7796_Panel_ReadPixel(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos) {
 	uint16_t ret;
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_DOWN) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-	}
-	ST7796_SETCURSOR(Xpos, Ypos);
-	LCD_IO_ReadBitmap(&ret, 1);
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_PANEL_SETCURSOR(hpanel, Xpos, Ypos);
+	ST7796_PANEL_READBITMAP(hpanel, &ret, 1);
 	return (ret);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Sets a display window
+ * @param  hpanel: panel handle
  * @param  Xpos:   specifies the X bottom left position.
  * @param  Ypos:   specifies the Y bottom left position.
  * @param  Height: display window height.
  * @param  Width:  display window width.
  * @retval None
  */
-void ST7796_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width,
-		uint16_t Height) {
-	yStart = Ypos;
-	yEnd = Ypos + Height - 1;
-	ST7796_SETWINDOW(Xpos, Xpos + Width - 1, Ypos, Ypos + Height - 1);
+void ST7796_Panel_SetDisplayWindow(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height) {
+	hpanel->yStart = Ypos;
+	hpanel->yEnd = Ypos + Height - 1;
+	ST7796_PANEL_SETWINDOW(hpanel, Xpos, Xpos + Width - 1, Ypos, Ypos + Height - 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the right then down drawing direction and the display window
+ *         (for the driver modules: no display list and asynchronous waiting)
+ * @param  hpanel: panel handle
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Xsize:  specifies the X size
+ * @param  Ysize:  specifies the Y size
+ * @retval None
+ */
+void ST7796_Panel_SetWriteWindow(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_PANEL_SETWINDOW(hpanel, Xpos, Xpos + Xsize - 1, Ypos, Ypos + Ysize - 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the right then up drawing direction and the display window
+ *         (the first written row is the bottom row of the window)
+ * @param  hpanel: panel handle
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Xsize:  specifies the X size
+ * @param  Ysize:  specifies the Y size
+ * @retval None
+ */
+void ST7796_Panel_SetWriteWindowUp(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_UP(hpanel));
+	/* the row addresses are mirrored in this direction */
+	ST7796_PANEL_SETWINDOW(hpanel, Xpos, Xpos + Xsize - 1, ST7796_PANEL_SIZE_Y(hpanel) - Ypos - Ysize,
+			ST7796_PANEL_SIZE_Y(hpanel) - 1 - Ypos);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Draw vertical line.
+ * @param  hpanel: panel handle
  * @param  RGBCode: Specifies the RGB color
  * @param  Xpos:     specifies the X position.
  * @param  Ypos:     specifies the Y position.
  * @param  Length:   specifies the Line length.
  * @retval None
  */
-void ST7796_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos,
-		uint16_t Length) {
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_DOWN) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-	}
-	ST7796_SETWINDOW(Xpos, Xpos + Length - 1, Ypos, Ypos);
-	LCD_IO_DrawFill(RGBCode, Length);
+void ST7796_Panel_DrawHLine(ST7796_PanelTypeDef *hpanel,
+		uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_PANEL_SETWINDOW(hpanel, Xpos, Xpos + Length - 1, Ypos, Ypos);
+	ST7796_PANEL_DRAWFILL(hpanel, RGBCode, Length);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Draw vertical line.
+ * @param  hpanel: panel handle
  * @param  RGBCode: Specifies the RGB color
  * @param  Xpos:     specifies the X position.
  * @param  Ypos:     specifies the Y position.
  * @param  Length:   specifies the Line length.
  * @retval None
  */
-void ST7796_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos,
-		uint16_t Length) {
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_DOWN) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-	}
-	ST7796_SETWINDOW(Xpos, Xpos, Ypos, Ypos + Length - 1);
-	LCD_IO_DrawFill(RGBCode, Length);
+void ST7796_Panel_DrawVLine(ST7796_PanelTypeDef *hpanel,
+		uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_PANEL_SETWINDOW(hpanel, Xpos, Xpos, Ypos, Ypos + Length - 1);
+	ST7796_PANEL_DRAWFILL(hpanel, RGBCode, Length);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Draw Filled rectangle
+ * @param  hpanel: panel handle
  * @param  Xpos:     specifies the X position.
  * @param  Ypos:     specifies the Y position.
  * @param  Xsize:    specifies the X size
@@ -303,27 +524,30 @@ void ST7796_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos,
  * @param  RGBCode:  specifies the RGB color
  * @retval None
  */
-void ST7796_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
-		uint16_t Ysize, uint16_t RGBCode) {
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_DOWN) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-	}
-	ST7796_SETWINDOW(Xpos, Xpos + Xsize - 1, Ypos, Ypos + Ysize - 1);
-	LCD_IO_DrawFill(RGBCode, Xsize * Ysize);
+void ST7796_Panel_FillRect(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize,
+		uint16_t RGBCode) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_PANEL_SETWINDOW(hpanel, Xpos, Xpos + Xsize - 1, Ypos, Ypos + Ysize - 1);
+	ST7796_PANEL_DRAWFILL(hpanel, RGBCode, Xsize * Ysize);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Displays a 16bit bitmap picture..
+ * @param  hpanel: panel handle
  * @param  BmpAddress: Bmp picture address.
  * @param  Xpos:  Bmp X position in the LCD
  * @param  Ypos:  Bmp Y position in the LCD
  * @retval None
  * @brief  Draw direction: right then up
  */
-void ST7796_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp) {
+void ST7796_Panel_DrawBitmap(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp) {
 	uint32_t index, size;
+	/* the bitmap is drawn into the display window */
+	(void) Xpos;
+	(void) Ypos;
 	/* Read bitmap size */
 	size = ((BITMAPSTRUCT*) pbmp)->fileHeader.bfSize;
 	/* Get bitmap data address offset */
@@ -331,19 +555,20 @@ void ST7796_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp) {
 	size = (size - index) / 2;
 	pbmp += index;
 
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_UP) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_UP;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenUp, 1);
-	}
-	transdata.d16[0] = __REVSH(ST7796_SIZE_Y - 1 - yEnd);
-	transdata.d16[1] = __REVSH(ST7796_SIZE_Y - 1 - yStart);
-	LCD_IO_WriteCmd8MultipleData8(ST7796_RASET, &transdata, 4);
-	LCD_IO_DrawBitmap(pbmp, size);
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_UP(hpanel));
+	/* raw RASET write (mirrored rows): keep the window cache in sync */
+	hpanel->LastWindow[2] = ST7796_PANEL_SIZE_Y(hpanel) - 1 - hpanel->yEnd;
+	hpanel->LastWindow[3] = ST7796_PANEL_SIZE_Y(hpanel) - 1 - hpanel->yStart;
+	hpanel->TransData.d16[0] = __REVSH(hpanel->LastWindow[2]);
+	hpanel->TransData.d16[1] = __REVSH(hpanel->LastWindow[3]);
+	PANEL_IO(hpanel, WriteCmd8MultipleData8, ST7796_RASET, hpanel->TransData.d8, 4);
+	ST7796_PANEL_DRAWBITMAP(hpanel, (uint16_t*) pbmp, size);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Displays 16bit/pixel picture..
+ * @param  hpanel: panel handle
  * @param  pdata: picture address.
  * @param  Xpos:  Image X position in the LCD
  * @param  Ypos:  Image Y position in the LCD
@@ -352,19 +577,18 @@ void ST7796_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp) {
  * @retval None
  * @brief  Draw direction: right then down
  */
-void ST7796_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
-		uint16_t Ysize, uint16_t *pData) {
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_DOWN) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-	}
-	ST7796_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
-	LCD_IO_DrawBitmap(pData, Xsize * Ysize);
+void ST7796_Panel_DrawRGBImage(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize,
+		uint16_t *pData) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_Panel_SetDisplayWindow(hpanel, Xpos, Ypos, Xsize, Ysize);
+	ST7796_PANEL_DRAWBITMAP(hpanel, pData, Xsize * Ysize);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Read 16bit/pixel picture from Lcd and store to RAM
+ * @param  hpanel: panel handle
  * @param  pdata: picture address.
  * @param  Xpos:  Image X position in the LCD
  * @param  Ypos:  Image Y position in the LCD
@@ -373,107 +597,440 @@ void ST7796_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
  * @retval None
  * @brief  Draw direction: right then down
  */
-void ST7796_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
-		uint16_t Ysize, uint16_t *pData) {
-	if (LastEntry != ST7796_MAD_DATA_RIGHT_THEN_DOWN) {
-		LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
-		LCD_IO_WriteCmd8MultipleData8(ST7796_MADCTL, &EntryRightThenDown, 1);
-	}
-	ST7796_SetDisplayWindow(Xpos, Ypos, Xsize, Ysize);
-	LCD_IO_ReadBitmap(pData, Xsize * Ysize);
+void ST7796_Panel_ReadRGBImage(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize,
+		uint16_t *pData) {
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+	ST7796_Panel_SetDisplayWindow(hpanel, Xpos, Ypos, Xsize, Ysize);
+	ST7796_PANEL_READBITMAP(hpanel, pData, Xsize * Ysize);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  Set display scroll parameters
+ * @param  hpanel: panel handle
  * @param  Scroll    : Scroll size [pixel]
  * @param  TopFix    : Top fix size [pixel]
  * @param  BottonFix : Botton fix size [pixel]
  * @retval None
  */
-void ST7796_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix) {
-	static uint16_t scrparam[4] = { 0, 0, 0, 0 };
-#if (ST7796_ORIENTATION == 0)
-	if ((TopFix != __REVSH(scrparam[1]))
-			|| (BottonFix != __REVSH(scrparam[3]))) {
-		scrparam[3] = __REVSH(TopFix);
-		scrparam[1] = __REVSH(BottonFix);
-		scrparam[2] = __REVSH(ST7796_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-		LCD_IO_WriteCmd8MultipleData8(ST7796_VERT_SCROLLING_DEF, &scrparam[1],
-				6);
+void ST7796_Panel_Scroll(ST7796_PanelTypeDef *hpanel,
+		int16_t Scroll, uint16_t TopFix, uint16_t BottonFix) {
+	uint8_t mad, top;
+	ST7796_PANEL_INVALIDATEWINDOW(hpanel);
+	/* the first gate line (TFA) is the bottom (landscape: right) screen
+	   line when MY is set, a positive scroll moves the content up (landscape:
+	   to the right) */
+	mad = ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel);
+	top = (mad & ST7796_MAD_Y_DOWN) ? 3 : 1;
+	if ((TopFix != __REVSH(hpanel->ScrParam[top]))
+			|| (BottonFix != __REVSH(hpanel->ScrParam[4 - top])) || (hpanel->ScrParam[2] == 0)) {
+		hpanel->ScrParam[top] = __REVSH(TopFix);
+		hpanel->ScrParam[4 - top] = __REVSH(BottonFix);
+		hpanel->ScrParam[2] = __REVSH(ST7796_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
+		PANEL_IO(hpanel, WriteCmd8MultipleData8, ST7796_VERT_SCROLLING_DEF,
+				(uint8_t*) &hpanel->ScrParam[1], 6);
 	}
-	Scroll = (0 - Scroll) % __REVSH(scrparam[2]);
+	if (((mad & ST7796_MAD_Y_DOWN) != 0) != ((mad & ST7796_MAD_VERTICAL) != 0))
+		Scroll = (0 - Scroll) % __REVSH(hpanel->ScrParam[2]);
+	else
+		Scroll %= __REVSH(hpanel->ScrParam[2]);
 	if (Scroll < 0)
-		Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
+		Scroll = __REVSH(hpanel->ScrParam[2]) + Scroll + __REVSH(hpanel->ScrParam[1]);
 	else
-		Scroll = Scroll + __REVSH(scrparam[1]);
-#elif (ST7796_ORIENTATION == 1)
-  if((TopFix != __REVSH(scrparam[3])) || (BottonFix != __REVSH(scrparam[1])))
-  {
-    scrparam[3] = __REVSH(TopFix);
-    scrparam[1] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ST7796_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ST7796_VERT_SCROLLING_DEF, &scrparam[1], 6);
-  }
-  Scroll %= __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #elif (ST7796_ORIENTATION == 2)
-  if((TopFix != __REVSH(scrparam[1])) || (BottonFix != __REVSH(scrparam[3])))
-  {
-    scrparam[1] = __REVSH(TopFix);
-    scrparam[3] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ST7796_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ST7796_VERT_SCROLLING_DEF, &scrparam[1], 6);
-  }
-  Scroll %= __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #elif (ST7796_ORIENTATION == 3)
-  if((TopFix != __REVSH(scrparam[1])) || (BottonFix != __REVSH(scrparam[3])))
-  {
-    scrparam[1] = __REVSH(TopFix);
-    scrparam[3] = __REVSH(BottonFix);
-    scrparam[2] = __REVSH(ST7796_LCD_PIXEL_HEIGHT - TopFix - BottonFix);
-    LCD_IO_WriteCmd8MultipleData8(ST7796_VERT_SCROLLING_DEF, &scrparam[1], 6);
-  }
-  Scroll = (0 - Scroll) % __REVSH(scrparam[2]);
-  if(Scroll < 0)
-    Scroll = __REVSH(scrparam[2]) + Scroll + __REVSH(scrparam[1]);
-  else
-    Scroll = Scroll + __REVSH(scrparam[1]);
-  #endif
-	if (Scroll != __REVSH(scrparam[0])) {
-		scrparam[0] = __REVSH(Scroll);
-		LCD_IO_WriteCmd8MultipleData8(ST7796_VERT_SCROLLING_ADDR, &scrparam[0],
-				2);
+		Scroll = Scroll + __REVSH(hpanel->ScrParam[1]);
+	if (Scroll != __REVSH(hpanel->ScrParam[0])) {
+		hpanel->ScrParam[0] = __REVSH(Scroll);
+		PANEL_IO(hpanel, WriteCmd8MultipleData8, ST7796_VERT_SCROLLING_ADDR,
+				(uint8_t*) &hpanel->ScrParam[0], 2);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the orientation
+ * @param  hpanel: panel handle
+ * @param  Orientation: 0 .. 3 (see ST7796_ORIENTATION)
+ * @retval None
+ * @brief  The GRAM is not changed, only the next drawings use the new
+ *         coordinate system: the content that is symmetric to the rotation
+ *         does not have to be redrawn. The scroll area is defined in gate
+ *         lines, call ST7796_Scroll again after a change.
+ */
+void ST7796_Panel_SetOrientation(ST7796_PanelTypeDef *hpanel,
+		uint8_t Orientation) {
+	/* the window cache holds the raw CASET / RASET values, it remains valid */
+	hpanel->Orientation = Orientation & 3;
+	PANEL_SETENTRY(hpanel, ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel));
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the orientation
+ * @param  hpanel: panel handle
+ * @retval Orientation (0 .. 3)
+ */
+uint8_t ST7796_Panel_GetOrientation(ST7796_PanelTypeDef *hpanel) {
+	return hpanel->Orientation;
+}
+
+//-----------------------------------------------------------------------------
+/* Address (Step = 0) or address step (Step = 1) of a MADCTL coordinate system
+   -> physical GRAM column and row */
+static void MadToGram(uint8_t Mad, int16_t *pX, int16_t *pY, uint8_t Step) {
+	int16_t a = *pX, b = *pY;
+	if (Mad & ST7796_MAD_VERTICAL) {
+		a = *pY;
+		b = *pX;
+	}
+	if (Mad & ST7796_MAD_X_RIGHT)
+		a = Step ? -a : (int16_t) ST7796_LCD_PIXEL_WIDTH - 1 - a;
+	if (Mad & ST7796_MAD_Y_DOWN)
+		b = Step ? -b : (int16_t) ST7796_LCD_PIXEL_HEIGHT - 1 - b;
+	*pX = a;
+	*pY = b;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Displays a rotated and / or mirrored 16bit/pixel picture
+ * @param  hpanel: panel handle
+ * @param  Xpos:      Image X position in the LCD (left side of the drawn image)
+ * @param  Ypos:      Image Y position in the LCD (top side of the drawn image)
+ * @param  Xsize:     Picture X size (before the transform)
+ * @param  Ysize:     Picture Y size (before the transform)
+ * @param  pData:     picture address (Xsize * Ysize pixels, row by row)
+ * @param  Transform: ST7796_ROT_0 .. ST7796_ROT_270 (clockwise) and optional
+ *                    ST7796_FLIP_X (mirrored before the rotation)
+ * @retval None
+ * @brief  The MADCTL address generator does the transform: the picture is
+ *         sent in its original order at the speed of ST7796_DrawRGBImage.
+ *         The drawn image is Ysize x Xsize pixels with ST7796_ROT_90 and
+ *         ST7796_ROT_270 and must be on the screen.
+ */
+void ST7796_Panel_DrawRGBImageTransform(ST7796_PanelTypeDef *hpanel,
+		uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize,
+		uint16_t *pData, uint8_t Transform) {
+	/* screen position of the first pixel, steps of the column and the row */
+	static const int8_t rot[4][6] = { { 0, 0, 1, 0, 0, 1 }, { 1, 0, 0, 1, -1, 0 },
+			{ 1, 1, -1, 0, 0, -1 }, { 0, 1, 0, -1, 1, 0 } };
+	const int8_t *r = rot[Transform & 3];
+	int16_t x, y, cx = r[2], cy = r[3], rx = r[4], ry = r[5];
+	uint8_t mad;
+	if ((Xsize == 0) || (Ysize == 0))
+		return;
+	if (Transform & 1) {
+		x = Xpos + r[0] * (Ysize - 1);
+		y = Ypos + r[1] * (Xsize - 1);
+	} else {
+		x = Xpos + r[0] * (Xsize - 1);
+		y = Ypos + r[1] * (Ysize - 1);
+	}
+	if (Transform & ST7796_FLIP_X) {
+		x += cx * (Xsize - 1);
+		y += cy * (Xsize - 1);
+		cx = -cx;
+		cy = -cy;
+	}
+
+	/* the same in GRAM addresses */
+	MadToGram(ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel), &x, &y, 0);
+	MadToGram(ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel), &cx, &cy, 1);
+	MadToGram(ST7796_PANEL_MAD_RIGHT_THEN_DOWN(hpanel), &rx, &ry, 1);
+
+	/* the drawing direction in which the picture columns and rows are the
+	   address columns and rows */
+	mad = ST7796_MAD_COLORMODE;
+	if (cx == 0) {
+		mad |= ST7796_MAD_VERTICAL;
+		if (cy < 0)
+			mad |= ST7796_MAD_Y_DOWN;
+		if (rx < 0)
+			mad |= ST7796_MAD_X_RIGHT;
+	} else {
+		if (cx < 0)
+			mad |= ST7796_MAD_X_RIGHT;
+		if (ry < 0)
+			mad |= ST7796_MAD_Y_DOWN;
 	}
+	/* GRAM -> address: mirror, then exchange */
+	if (mad & ST7796_MAD_X_RIGHT)
+		x = ST7796_LCD_PIXEL_WIDTH - 1 - x;
+	if (mad & ST7796_MAD_Y_DOWN)
+		y = ST7796_LCD_PIXEL_HEIGHT - 1 - y;
+	if (mad & ST7796_MAD_VERTICAL) {
+		cx = x;
+		x = y;
+		y = cx;
+	}
+
+	if (hpanel->LastEntry != mad) {
+		hpanel->LastEntry = mad;
+		PANEL_IO(hpanel, WriteCmd8MultipleData8, ST7796_MADCTL, &hpanel->LastEntry, 1);
+	}
+	ST7796_PANEL_SETWINDOW(hpanel, x, x + Xsize - 1, y, y + Ysize - 1);
+	ST7796_PANEL_DRAWBITMAP(hpanel, pData, Xsize * Ysize);
 }
 
 //-----------------------------------------------------------------------------
 /**
  * @brief  User command
+ * @param  hpanel: panel handle
  * @param  Command   : Lcd command
  * @param  pData     : data pointer
  * @param  Size      : data number
  * @param  Mode      : 0=write 8bits datas, 1=0=write 16bits datas, 2=read 8bits datas, 3=read 16bits datas
  * @retval None
  */
-void ST7796_UserCommand(uint16_t Command, uint8_t *pData, uint32_t Size,
-		uint8_t Mode) {
+void ST7796_Panel_UserCommand(ST7796_PanelTypeDef *hpanel,
+		uint16_t Command, uint8_t *pData, uint32_t Size, uint8_t Mode) {
+	/* the command may change the address window (CASET, RASET, SWRESET ...) */
+	ST7796_PANEL_INVALIDATEWINDOW(hpanel);
 	if (Mode == 0)
-		LCD_IO_WriteCmd8MultipleData8((uint8_t) Command, pData, Size);
+		PANEL_IO(hpanel, WriteCmd8MultipleData8, (uint8_t) Command, pData, Size);
 	else if (Mode == 1)
-		LCD_IO_WriteCmd8MultipleData16((uint8_t) Command, pData, Size);
+		PANEL_IO(hpanel, WriteCmd8MultipleData16, (uint8_t) Command, (uint16_t*) pData, Size);
 	else if (Mode == 2)
-		LCD_IO_ReadCmd8MultipleData8((uint8_t) Command, pData, Size, 1);
+		PANEL_IO(hpanel, ReadCmd8MultipleData8, (uint8_t) Command, pData, Size, 1);
 	else if (Mode == 3)
-		LCD_IO_ReadCmd8MultipleData16((uint8_t) Command, pData, Size, 1);
+		PANEL_IO(hpanel, ReadCmd8MultipleData16, (uint8_t) Command, (uint16_t*) pData, Size, 1);
 }
 
-/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+/* Single panel interface (st7796_drv and the driver modules): the hst7796
+   panel with the display list, the asynchronous drawing and the trace hooks */
+
+//-----------------------------------------------------------------------------
+void ST7796_Init(void) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTDROP();
+	ST7796_TRACEBEGIN(ST7796_TR_INIT, 0);
+	ST7796_Panel_Init(&hst7796);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_DisplayOn(void) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_COMMAND, 0);
+	ST7796_Panel_DisplayOn(&hst7796);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_DisplayOff(void) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_COMMAND, 0);
+	ST7796_Panel_DisplayOff(&hst7796);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+uint16_t ST7796_GetLcdPixelWidth(void) {
+	return ST7796_Panel_GetLcdPixelWidth(&hst7796);
+}
+
+//-----------------------------------------------------------------------------
+uint16_t ST7796_GetLcdPixelHeight(void) {
+	return ST7796_Panel_GetLcdPixelHeight(&hst7796);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t ST7796_ReadID(void) {
+	uint32_t id;
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_COMMAND, 0);
+	id = ST7796_Panel_ReadID(&hst7796);
+	ST7796_TRACEEND();
+	return id;
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_SetCursor(uint16_t Xpos, uint16_t Ypos) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_COMMAND, 0);
+	ST7796_Panel_SetCursor(&hst7796, Xpos, Ypos);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode) {
+	ST7796_POWERCLIP(&Xpos, &Ypos, NULL, NULL);
+	ST7796_DLISTRECORD(ST7796_DL_FILL, Xpos, Ypos, 1, 1, RGBCode, NULL);
+	ST7796_ASYNCWAIT();
+	ST7796_TRACEBEGIN(ST7796_TR_WRITEPIXEL, 1);
+	ST7796_Panel_WritePixel(&hst7796, Xpos, Ypos, RGBCode);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+uint16_t ST7796_ReadPixel(uint16_t Xpos, uint16_t Ypos) {
+	uint16_t ret;
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_READPIXEL, 1);
+	ret = ST7796_Panel_ReadPixel(&hst7796, Xpos, Ypos);
+	ST7796_TRACEEND();
+	return ret;
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width,
+		uint16_t Height) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_COMMAND, 0);
+	ST7796_Panel_SetDisplayWindow(&hst7796, Xpos, Ypos, Width, Height);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Bring the LCD up to date (send the display list, wait for the
+ *         asynchronous transfers) before a driver module uses the bus
+ * @param  None
+ * @retval None
+ */
+void ST7796_Sync(void) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+}
 
+//-----------------------------------------------------------------------------
+void ST7796_SetWriteWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	ST7796_Panel_SetWriteWindow(&hst7796, Xpos, Ypos, Xsize, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_SetWriteWindowUp(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	ST7796_Panel_SetWriteWindowUp(&hst7796, Xpos, Ypos, Xsize, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Length) {
+	ST7796_POWERCLIP(&Xpos, &Ypos, &Length, NULL);
+	ST7796_DLISTRECORD(ST7796_DL_FILL, Xpos, Ypos, Length, 1, RGBCode, NULL);
+	ST7796_ASYNCWAIT();
+	ST7796_TRACEBEGIN(ST7796_TR_HLINE, Length);
+	ST7796_Panel_DrawHLine(&hst7796, RGBCode, Xpos, Ypos, Length);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Length) {
+	ST7796_POWERCLIP(&Xpos, &Ypos, NULL, &Length);
+	ST7796_DLISTRECORD(ST7796_DL_FILL, Xpos, Ypos, 1, Length, RGBCode, NULL);
+	ST7796_ASYNCWAIT();
+	ST7796_TRACEBEGIN(ST7796_TR_VLINE, Length);
+	ST7796_Panel_DrawVLine(&hst7796, RGBCode, Xpos, Ypos, Length);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode) {
+	ST7796_POWERCLIP(&Xpos, &Ypos, &Xsize, &Ysize);
+	ST7796_DLISTRECORD(ST7796_DL_FILL, Xpos, Ypos, Xsize, Ysize, RGBCode, NULL);
+	ST7796_ASYNCWAIT();
+	ST7796_TRACEBEGIN(ST7796_TR_FILLRECT, (uint32_t) Xsize * Ysize);
+	ST7796_Panel_FillRect(&hst7796, Xpos, Ypos, Xsize, Ysize, RGBCode);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_BITMAP, (((BITMAPSTRUCT*) pbmp)->fileHeader.bfSize
+			- ((BITMAPSTRUCT*) pbmp)->fileHeader.bfOffBits) / 2);
+	ST7796_Panel_DrawBitmap(&hst7796, Xpos, Ypos, pbmp);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t *pData) {
+#if ST7796_POWER == 1
+	uint16_t x = Xpos, y = Ypos, w = Xsize, h = Ysize;
+	if (!ST7796_PowerClip(&x, &y, &w, &h))
+		return;
+	pData += (y - Ypos) * Xsize + (x - Xpos);
+	if (w != Xsize) {
+		/* clipped columns: one row / image */
+		for (; h; h--, y++, pData += Xsize)
+			ST7796_DrawRGBImage(x, y, w, 1, pData);
+		return;
+	}
+	Ypos = y;
+	Ysize = h;
+#endif
+	ST7796_DLISTRECORD(ST7796_DL_IMAGE, Xpos, Ypos, Xsize, Ysize, 0, pData);
+	ST7796_ASYNCWAIT();
+	ST7796_TRACEBEGIN(ST7796_TR_RGBIMAGE, (uint32_t) Xsize * Ysize);
+	ST7796_Panel_DrawRGBImage(&hst7796, Xpos, Ypos, Xsize, Ysize, pData);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t *pData) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_READIMAGE, (uint32_t) Xsize * Ysize);
+	ST7796_Panel_ReadRGBImage(&hst7796, Xpos, Ypos, Xsize, Ysize, pData);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_SCROLL, 0);
+	ST7796_Panel_Scroll(&hst7796, Scroll, TopFix, BottonFix);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_SetOrientation(uint8_t Orientation) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_COMMAND, 0);
+	ST7796_Panel_SetOrientation(&hst7796, Orientation);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+uint8_t ST7796_GetOrientation(void) {
+	return ST7796_Panel_GetOrientation(&hst7796);
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_DrawRGBImageTransform(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t *pData, uint8_t Transform) {
+	if ((Xsize == 0) || (Ysize == 0))
+		return;
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_TRANSFORM, (uint32_t) Xsize * Ysize);
+	ST7796_Panel_DrawRGBImageTransform(&hst7796, Xpos, Ypos, Xsize, Ysize, pData, Transform);
+	ST7796_TRACEEND();
+}
+
+//-----------------------------------------------------------------------------
+void ST7796_UserCommand(uint16_t Command, uint8_t *pData, uint32_t Size,
+		uint8_t Mode) {
+	ST7796_ASYNCWAIT();
+	ST7796_DLISTSYNC();
+	ST7796_TRACEBEGIN(ST7796_TR_COMMAND, 0);
+	ST7796_Panel_UserCommand(&hst7796, Command, pData, Size, Mode);
+	ST7796_TRACEEND();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
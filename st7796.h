@@ -22,7 +22,7 @@
 #ifndef ST7796_H
 #define ST7796_H
 
-/* Orientation
+/* Orientation after power on (ST7796_SetOrientation changes it at runtime)
  - 0: 240x320 portrait (plug in top)
  - 1: 320x240 landscape (plug in left)
  - 2: 240x320 portrait (plug in bottom)
@@ -34,6 +34,11 @@
  - 1: clear */
 #define  ST7796_INITCLEAR               1
 
+/* Boot delays (see ST7796_InitTable)
+ - 0: every delay of the init table and the power on wait
+ - 1: fast boot, only the mandatory waits after SWRESET and SLPOUT */
+#define  ST7796_FASTBOOT                0
+
 /* Color order (0 = RGB, 1 = BGR) */
 #define  ST7796_COLORMODE               0
 
@@ -42,114 +47,378 @@
 #define  ST7796_WRITEBITDEPTH           16
 #define  ST7796_READBITDEPTH            24
 
+/* Display list (deferred drawing, see st7796_dlist.h)
+ - 0: disabled (every primitive goes directly to the bus)
+ - 1: enabled */
+#define  ST7796_DLIST                   0
+
+/* Display list size (number of recorded primitives before an automatic flush) */
+#define  ST7796_DLIST_SIZE              256
+
+/* Asynchronous (DMA) drawing, see st7796_async.h
+ - 0: disabled
+ - 1: enabled (the blocking functions wait for the queued transfers) */
+#define  ST7796_ASYNC                   0
+
+/* Asynchronous transfer queue size */
+#define  ST7796_ASYNC_QUEUE             4
+
+/* Shadow framebuffer (dirty tiles, see st7796_shadow.h)
+ - ST7796_SHADOW_TILE:  tile width and height [pixel]
+ - ST7796_SHADOW_MERGE: 0 = one window / tile, 1 = horizontal tile runs,
+                        2 = horizontal runs merged with the next tile rows
+ - ST7796_SHADOW_GAP:   clean tiles sent to join two dirty runs (0 = none) */
+#define  ST7796_SHADOW_TILE             16
+#define  ST7796_SHADOW_MERGE            2
+#define  ST7796_SHADOW_GAP              1
+
+/* Band renderer strip height [line] (see st7796_band.h, buffer size:
+   ST7796_SIZE_X * ST7796_BAND_LINES pixels / band buffer) */
+#define  ST7796_BAND_LINES              16
+
+/* Tearing effect synchronized presentation (see st7796_te.h)
+ - ST7796_TE_FRMCTR1: FRAME_RATE_CTRL1 parameters written by ST7796_TeInit
+ - ST7796_TE_FRAMEUS: refresh period of this frame rate setting [us]
+                      (only the start value, the measured TE period is used)
+ - ST7796_TE_PORCH:   front + back porch [line] */
+#define  ST7796_TE_FRMCTR1              "\xA0\x10"
+#define  ST7796_TE_FRAMEUS              16667
+#define  ST7796_TE_PORCH                4
+
+/* Compressed images (see st7796_cimg.h)
+ - ST7796_CIMG_BUFFER:  decode buffer [pixel] (halved into two chunks with ST7796_ASYNC)
+ - ST7796_CIMG_MINFILL: shortest run sent as a fill instead of buffered pixels */
+#define  ST7796_CIMG_BUFFER             256
+#define  ST7796_CIMG_MINFILL            16
+
+/* Streaming BMP decoder color reduction of the RGB888 (24/32 bit and palette) pixels
+ - 0: truncation to RGB565
+ - 1: 4x4 ordered (Bayer) dithering */
+#define  ST7796_BMP_DITHER              0
+
+/* Font renderer (see st7796_font.h)
+ - ST7796_FONT_CACHE:       expanded RGB565 glyph cache entries (0: no cache)
+ - ST7796_FONT_CACHEPIXELS: largest cached glyph cell (Advance * Height) [pixel]
+ - ST7796_FONT_MINFILL:     shortest uncached span sent as a fill instead of pixels */
+#define  ST7796_FONT_CACHE              8
+#define  ST7796_FONT_CACHEPIXELS        384
+#define  ST7796_FONT_MINFILL            16
+
+/* Alpha blending background (see st7796_blend.h)
+ - 0: read back from the display memory
+ - 1: the st7796_shadow buffer when it is set (no readback, the blended
+      area is marked dirty, drawn at the next ST7796_ShadowFlush) */
+#define  ST7796_BLEND_SHADOW            0
+
+/* Power profile (partial display and idle mode, see st7796_power.h)
+ - ST7796_POWER:        0 = disabled, 1 = the st7796_drv drawing functions
+                        only draw into the partial display area
+ - ST7796_POWER_FRMCTR: FRAME_RATE_CTRL2 / 3 (idle / partial mode) parameters
+                        of the reduced frame rate (ST7796_TE_FRMCTR1 with the
+                        oscillator divided by 2) */
+#define  ST7796_POWER                   0
+#define  ST7796_POWER_FRMCTR            "\xA1\x10"
+
+/* Adaptive frame rate (see st7796_rate.h)
+ - ST7796_RATE_STEPS:    refresh rate steps, slowest first, 3 bytes / step:
+                         FRAME_RATE_CTRL1 (2) and INV_CTRL (1) parameters
+                         (ST7796_TE_FRMCTR1 with the oscillator divided by 4,
+                         2 and 1; 1 dot inversion against the flicker of the
+                         slow steps, column inversion at the full rate)
+ - ST7796_RATE_HZ:       refresh rates of the steps [Hz]
+ - ST7796_RATE_UP:       faster step when the presented frames are above this
+                         share of the refresh rate [%]
+ - ST7796_RATE_DOWN:     slower step when the presented frames are below this
+                         share of the slower refresh rate [%] ...
+ - ST7796_RATE_HOLD:     ... in this number of consecutive windows
+ - ST7796_RATE_WINDOWMS: measurement window [ms] */
+#define  ST7796_RATE_STEPS              "\xA2\x10\x01" "\xA1\x10\x01" "\xA0\x10\x00"
+#define  ST7796_RATE_HZ                 15, 30, 60
+#define  ST7796_RATE_UP                 80
+#define  ST7796_RATE_DOWN               70
+#define  ST7796_RATE_HOLD               4
+#define  ST7796_RATE_WINDOWMS           250
+
+/* Instrumentation (see st7796_trace.h)
+ - ST7796_TRACE:      0 = disabled (no code), 1 = per primitive counters and
+                      timestamped events of the single panel interface
+ - ST7796_TRACE_RING: event ring buffer size (power of 2) [event] */
+#define  ST7796_TRACE                   0
+#define  ST7796_TRACE_RING              64
+
+/* Indexed color framebuffer (see st7796_index.h)
+ - 8: 256 color palette, 1 pixel / byte
+ - 4: 16 color palette, 2 pixels / byte */
+#define  ST7796_INDEX_BPP               8
+
+/* Generator fills (see st7796_fill.h)
+ - ST7796_FILL_BUFFER:  pixel chunk buffer [pixel] (halved into two chunks with ST7796_ASYNC)
+ - ST7796_FILL_MINFILL: shortest run of one color sent as a fill instead of buffered pixels */
+#define  ST7796_FILL_BUFFER             256
+#define  ST7796_FILL_MINFILL            16
+
+/* Shape rasterizer (see st7796_shape.h)
+ - ST7796_SHAPE_AA:      0 = aliased edges, 1 = anti-aliased edges (the edge pixels are
+                         blended by their coverage with st7796_blend)
+ - ST7796_SHAPE_PENDING: open rectangles collecting the spans of a shape */
+#define  ST7796_SHAPE_AA                0
+#define  ST7796_SHAPE_PENDING           4
+
+/* Scatter pixels (see st7796_scatter.h)
+ - ST7796_SCATTER_BUFFER: pixel chunk buffer [pixel] (halved into two chunks with ST7796_ASYNC) */
+#define  ST7796_SCATTER_BUFFER          128
+
 // ILI9341 physic resolution (in 0 orientation)
 #define  ST7796_LCD_PIXEL_WIDTH         320U
 #define  ST7796_LCD_PIXEL_HEIGHT        480U
 
-#define ST7796_SETWINDOW(x1, x2, y1, y2) \
-  { transdata.d16[0] = __REVSH(x1); transdata.d16[1] = __REVSH(x2); LCD_IO_WriteCmd8MultipleData8(ST7796_CASET, &transdata, 4); \
-    transdata.d16[0] = __REVSH(y1); transdata.d16[1] = __REVSH(y2); LCD_IO_WriteCmd8MultipleData8(ST7796_PASET, &transdata, 4); }
-
-#define ST7796_SETCURSOR(x, y)            ST7796_SETWINDOW(x, x, y, y)
-
 //-----------------------------------------------------------------------------
 #define ST7796_LCD_INITIALIZED    0x01
 #define ST7796_IO_INITIALIZED     0x02
-static uint8_t Is_ST7796_Initialized = 0;
 
-const uint8_t EntryRightThenUp = ST7796_MAD_DATA_RIGHT_THEN_UP;
-const uint8_t EntryRightThenDown = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
+/**
+ * @brief  Panel transport (bus and chip select of one panel). The functions
+ *         work like the lcd_io functions of the same name, pParam is the
+ *         pIoParam of the panel (e.g. the SPI and DMA handles of the bus).
+ */
+typedef struct {
+	void (*Init)(void *pParam);
+	void (*Delay)(void *pParam, uint32_t Delay);
+	void (*Bl_OnOff)(void *pParam, uint8_t Bl);
+	void (*WriteCmd8DataFill16)(void *pParam, uint8_t Cmd, uint16_t Data, uint32_t Size);
+	void (*WriteCmd8MultipleData8)(void *pParam, uint8_t Cmd, uint8_t *pData, uint32_t Size);
+	void (*WriteCmd8MultipleData16)(void *pParam, uint8_t Cmd, uint16_t *pData, uint32_t Size);
+	void (*ReadCmd8MultipleData8)(void *pParam, uint8_t Cmd, uint8_t *pData, uint32_t Size, uint32_t DummySize);
+	void (*ReadCmd8MultipleData16)(void *pParam, uint8_t Cmd, uint16_t *pData, uint32_t Size, uint32_t DummySize);
+	void (*WriteCmd8DataFill16to24)(void *pParam, uint8_t Cmd, uint16_t Data, uint32_t Size);
+	void (*WriteCmd8MultipleData16to24)(void *pParam, uint8_t Cmd, uint16_t *pData, uint32_t Size);
+	void (*ReadCmd8MultipleData24to16)(void *pParam, uint8_t Cmd, uint16_t *pData, uint32_t Size, uint32_t DummySize);
+} ST7796_PanelIoTypeDef;
+
+/* Init table: command, argument count, arguments, [delay [ms]] ... ST7796_INIT_END
+   - argument count | ST7796_INIT_WAIT:  mandatory delay byte after the arguments
+   - argument count | ST7796_INIT_DELAY: delay byte, skipped with ST7796_FASTBOOT
+   - MADCTL without argument: the drawing direction of the panel orientation */
+#define ST7796_INIT_WAIT          0x80
+#define ST7796_INIT_DELAY         0x40
+#define ST7796_INIT_ARGS          0x3F
+#define ST7796_INIT_END           0x00   /* NOP command: end of the table */
+
+/* Boot work callback: CPU side work (e.g. splash decoding, no drawing)
+   overlapped with a WaitMs delay of the init, returns the elapsed time [ms] */
+typedef uint32_t (*ST7796_BootWorkCallback)(uint32_t WaitMs);
+
+/**
+ * @brief  Panel instance: transport and driver state. The ST7796_Panel_*
+ *         functions only use the state of their panel, the panels on
+ *         different buses can be driven from different tasks at the same time.
+ */
+typedef struct {
+	const ST7796_PanelIoTypeDef *pIo;
+	void *pIoParam;
+	uint8_t Initialized;           /* ST7796_LCD_INITIALIZED, ST7796_IO_INITIALIZED */
+	uint8_t Orientation;           /* 0 .. 3 (see ST7796_ORIENTATION) */
+	uint8_t LastEntry;             /* the last set drawing direction (0xFF: unknown) */
+	uint8_t LastDir;               /* the last set interface pixel format direction (0 = write, 1 = read) */
+	uint16_t LastWindow[4];        /* the last programmed column and row ranges */
+	uint16_t yStart, yEnd;         /* rows of the last ST7796_Panel_SetDisplayWindow */
+	uint16_t ScrParam[4];          /* VSCRSADD, VSCRDEF TFA, VSA, BFA (big endian) */
+	union {
+		uint8_t d8[4];
+		uint16_t d16[2];
+	} TransData;
+	const uint8_t *pInitTable;     /* panel variant init table (NULL: ST7796_InitTable) */
+	ST7796_BootWorkCallback pBootWork; /* called in the init delays (NULL: none) */
+} ST7796_PanelTypeDef;
+
+/* Static initializer of a panel: ST7796_PanelTypeDef hpanel = ST7796_PANEL_INIT(&io, &bus); */
+#define ST7796_PANEL_INIT(pIo, pIoParam) \
+  { pIo, pIoParam, 0, ST7796_ORIENTATION, 0xFF, 0, \
+    { ST7796_WINDOW_INVALID, ST7796_WINDOW_INVALID, ST7796_WINDOW_INVALID, ST7796_WINDOW_INVALID }, \
+    0, 0, { 0, 0, 0, 0 }, { { 0, 0, 0, 0 } }, 0, 0 }
+
+/* The single panel interface (ST7796_* functions, st7796_drv and the driver
+   modules) draws to this panel, its transport is the lcd_io layer */
+extern ST7796_PanelTypeDef hst7796;
+extern const ST7796_PanelIoTypeDef ST7796_LcdIo;
+extern const uint8_t ST7796_InitTable[];
 
-/* the last set drawing direction is stored here */
-uint8_t LastEntry = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
+/* CASET / RASET are only sent when the column or the row range differs from
+   the last programmed one (LastWindow: x1, x2, y1, y2) */
+#define ST7796_WINDOW_INVALID           0xFFFF
+#define ST7796_PANEL_SETWINDOW(h, x1, x2, y1, y2) \
+  { if(((x1) != (h)->LastWindow[0]) || ((x2) != (h)->LastWindow[1])) \
+    { (h)->LastWindow[0] = (x1); (h)->LastWindow[1] = (x2); \
+      (h)->TransData.d16[0] = __REVSH((h)->LastWindow[0]); (h)->TransData.d16[1] = __REVSH((h)->LastWindow[1]); \
+      (h)->pIo->WriteCmd8MultipleData8((h)->pIoParam, ST7796_CASET, (h)->TransData.d8, 4); } \
+    if(((y1) != (h)->LastWindow[2]) || ((y2) != (h)->LastWindow[3])) \
+    { (h)->LastWindow[2] = (y1); (h)->LastWindow[3] = (y2); \
+      (h)->TransData.d16[0] = __REVSH((h)->LastWindow[2]); (h)->TransData.d16[1] = __REVSH((h)->LastWindow[3]); \
+      (h)->pIo->WriteCmd8MultipleData8((h)->pIoParam, ST7796_RASET, (h)->TransData.d8, 4); } }
 
-static uint16_t yStart, yEnd;
+/* forget the last programmed window (the next ST7796_PANEL_SETWINDOW sends both CASET and RASET) */
+#define ST7796_PANEL_INVALIDATEWINDOW(h) \
+  { (h)->LastWindow[0] = (h)->LastWindow[1] = (h)->LastWindow[2] = (h)->LastWindow[3] = ST7796_WINDOW_INVALID; }
+
+#define ST7796_PANEL_SETCURSOR(h, x, y)   ST7796_PANEL_SETWINDOW(h, x, x, y, y)
+
+/* the same on the single panel interface panel */
+#define ST7796_SETWINDOW(x1, x2, y1, y2)  ST7796_PANEL_SETWINDOW(&hst7796, x1, x2, y1, y2)
+#define ST7796_INVALIDATEWINDOW()         ST7796_PANEL_INVALIDATEWINDOW(&hst7796)
+#define ST7796_SETCURSOR(x, y)            ST7796_PANEL_SETCURSOR(&hst7796, x, y)
+
+//-----------------------------------------------------------------------------
+/* Pixel draw and read functions (single panel interface) */
+
+void ST7796_Init(void);
+uint32_t ST7796_ReadID(void);
+void ST7796_DisplayOn(void);
+void ST7796_DisplayOff(void);
+void ST7796_SetCursor(uint16_t Xpos, uint16_t Ypos);
+void ST7796_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGB_Code);
+uint16_t ST7796_ReadPixel(uint16_t Xpos, uint16_t Ypos);
+void ST7796_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width,uint16_t Height);
+void ST7796_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
+uint16_t ST7796_GetLcdPixelWidth(void);
+uint16_t ST7796_GetLcdPixelHeight(void);
+void ST7796_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp);
+void ST7796_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
+void ST7796_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
+void ST7796_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
+void ST7796_UserCommand(uint16_t Command, uint8_t *pData, uint32_t Size, uint8_t Mode);
+
+/* Runtime orientation and transformed pictures (the screen size, the
+   shadow, band and console modules follow the orientation after their
+   next init) */
+#define ST7796_ROT_0              0
+#define ST7796_ROT_90             1
+#define ST7796_ROT_180            2
+#define ST7796_ROT_270            3
+#define ST7796_FLIP_X             4
+#define ST7796_FLIP_Y             (ST7796_FLIP_X | ST7796_ROT_180)
+void ST7796_SetOrientation(uint8_t Orientation);
+uint8_t ST7796_GetOrientation(void);
+void ST7796_DrawRGBImageTransform(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData, uint8_t Transform);
+
+/* Driver module helpers */
+void ST7796_Sync(void);
+void ST7796_SetWriteWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize);
+void ST7796_SetWriteWindowUp(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize);
 
 //-----------------------------------------------------------------------------
-/* Pixel draw and read functions */
-
-void st7796_Init(void);
-uint32_t st7796_ReadID(void);
-void st7796_DisplayOn(void);
-void st7796_DisplayOff(void);
-void st7796_SetCursor(uint16_t Xpos, uint16_t Ypos);
-void st7796_WritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGB_Code);
-uint16_t st7796_ReadPixel(uint16_t Xpos, uint16_t Ypos);
-void st7796_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width,uint16_t Height);
-void st7796_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
-void st7796_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
-void st7796_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
-uint16_t st7796_GetLcdPixelWidth(void);
-uint16_t st7796_GetLcdPixelHeight(void);
-void st7796_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp);
-void st7796_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
-void st7796_ReadRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
-void st7796_Scroll(int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
-void st7796_UserCommand(uint16_t Command, uint8_t *pData, uint32_t Size, uint8_t Mode);
+/* Panel instance functions (no display list and asynchronous drawing, these
+   belong to the single panel interface) */
+
+void ST7796_Panel_Init(ST7796_PanelTypeDef *hpanel);
+uint32_t ST7796_Panel_ReadID(ST7796_PanelTypeDef *hpanel);
+void ST7796_Panel_DisplayOn(ST7796_PanelTypeDef *hpanel);
+void ST7796_Panel_DisplayOff(ST7796_PanelTypeDef *hpanel);
+void ST7796_Panel_SetCursor(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos);
+void ST7796_Panel_WritePixel(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode);
+uint16_t ST7796_Panel_ReadPixel(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos);
+void ST7796_Panel_SetDisplayWindow(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+void ST7796_Panel_SetWriteWindow(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize);
+void ST7796_Panel_SetWriteWindowUp(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize);
+void ST7796_Panel_DrawHLine(ST7796_PanelTypeDef *hpanel, uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_Panel_DrawVLine(ST7796_PanelTypeDef *hpanel, uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_Panel_FillRect(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
+uint16_t ST7796_Panel_GetLcdPixelWidth(ST7796_PanelTypeDef *hpanel);
+uint16_t ST7796_Panel_GetLcdPixelHeight(ST7796_PanelTypeDef *hpanel);
+void ST7796_Panel_DrawBitmap(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp);
+void ST7796_Panel_DrawRGBImage(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
+void ST7796_Panel_ReadRGBImage(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
+void ST7796_Panel_Scroll(ST7796_PanelTypeDef *hpanel, int16_t Scroll, uint16_t TopFix, uint16_t BottonFix);
+void ST7796_Panel_UserCommand(ST7796_PanelTypeDef *hpanel, uint16_t Command, uint8_t *pData, uint32_t Size, uint8_t Mode);
+void ST7796_Panel_SetOrientation(ST7796_PanelTypeDef *hpanel, uint8_t Orientation);
+uint8_t ST7796_Panel_GetOrientation(ST7796_PanelTypeDef *hpanel);
+void ST7796_Panel_DrawRGBImageTransform(ST7796_PanelTypeDef *hpanel, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData, uint8_t Transform);
 
+//-----------------------------------------------------------------------------
 #if ST7796_WRITEBITDEPTH == ST7796_READBITDEPTH
 /* 16/16 and 24/24 bit, no need to change bitdepth data */
-#define SetWriteDir()
-#define SetReadDir()
+#define ST7796_PANEL_SETWRITEDIR(h)
+#define ST7796_PANEL_SETREADDIR(h)
 #else /* #if ST7796_WRITEBITDEPTH == ST7796_READBITDEPTH */
-uint8_t lastdir = 0;
 #if ST7796_WRITEBITDEPTH == 16
 /* 16/24 bit */
-#define SetWriteDir() {                                      \
-  if(lastdir != 0)                                           \
+#define ST7796_PANEL_SETWRITEDIR(h) {                        \
+  if((h)->LastDir != 0)                                      \
   {                                                          \
-    LCD_IO_WriteCmd8MultipleData8(ST7796_COLORMODE, "\55", 1);  \
-    lastdir = 0;                                             \
+    (h)->pIo->WriteCmd8MultipleData8((h)->pIoParam, ST7796_COLOR_MODE, (uint8_t *)"\x55", 1); \
+    (h)->LastDir = 0;                                        \
   }                                                          }
-#define SetReadDir() {                                       \
-  if(lastdir == 0)                                           \
+#define ST7796_PANEL_SETREADDIR(h) {                         \
+  if((h)->LastDir == 0)                                      \
   {                                                          \
-    LCD_IO_WriteCmd8MultipleData8(ST7796_COLORMODE, "\66", 1);  \
-    lastdir = 1;                                             \
+    (h)->pIo->WriteCmd8MultipleData8((h)->pIoParam, ST7796_COLOR_MODE, (uint8_t *)"\x66", 1); \
+    (h)->LastDir = 1;                                        \
   }                                                          }
 #elif ST7796_WRITEBITDEPTH == 24
 /* 24/16 bit */
-#define SetWriteDir() {                                      \
-  if(lastdir != 0)                                           \
+#define ST7796_PANEL_SETWRITEDIR(h) {                        \
+  if((h)->LastDir != 0)                                      \
   {                                                          \
-    LCD_IO_WriteCmd8MultipleData8(ST7796_COLORMODE, "\66", 1);  \
-    lastdir = 0;                                             \
+    (h)->pIo->WriteCmd8MultipleData8((h)->pIoParam, ST7796_COLOR_MODE, (uint8_t *)"\x66", 1); \
+    (h)->LastDir = 0;                                        \
   }                                                          }
-#define SetReadDir() {                                       \
-  if(lastdir == 0)                                           \
+#define ST7796_PANEL_SETREADDIR(h) {                         \
+  if((h)->LastDir == 0)                                      \
   {                                                          \
-    LCD_IO_WriteCmd8MultipleData8(ST7796_COLORMODE, "\55", 1);  \
-    lastdir = 1;                                             \
+    (h)->pIo->WriteCmd8MultipleData8((h)->pIoParam, ST7796_COLOR_MODE, (uint8_t *)"\x55", 1); \
+    (h)->LastDir = 1;                                        \
   }                                                          }
 #endif /* #elif ILI9488_WRITEBITDEPTH == 24 */
 #endif /* #else ILI9488_WRITEBITDEPTH == ILI9488_READBITDEPTH */
 
 #if ST7796_WRITEBITDEPTH == 16
-#define  LCD_IO_DrawFill(Color, Size) { \
-  SetWriteDir(); \
-  LCD_IO_WriteCmd8DataFill16(ST7796_WRITE_RAM, Color, Size); }            /* Fill 16 bit pixel(s) */
-#define  LCD_IO_DrawBitmap(pData, Size) { \
-  SetWriteDir(); \
-  LCD_IO_WriteCmd8MultipleData16(ST7796_WRITE_RAM, pData, Size); }        /* Draw 16 bit bitmap */
+#define  ST7796_PANEL_DRAWFILL(h, Color, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8DataFill16((h)->pIoParam, ST7796_WRITE_RAM, Color, Size); }            /* Fill 16 bit pixel(s) */
+#define  ST7796_PANEL_DRAWBITMAP(h, pData, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8MultipleData16((h)->pIoParam, ST7796_WRITE_RAM, pData, Size); }        /* Draw 16 bit bitmap */
+#define  ST7796_PANEL_DRAWBITMAPCONT(h, pData, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8MultipleData16((h)->pIoParam, ST7796_WRITE_RAM_CONT, pData, Size); }   /* Continue 16 bit bitmap at the memory pointer */
+#define  ST7796_PANEL_DRAWFILLCONT(h, Color, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8DataFill16((h)->pIoParam, ST7796_WRITE_RAM_CONT, Color, Size); }       /* Continue 16 bit fill at the memory pointer */
 #elif ST7796_WRITEBITDEPTH == 24
-#define  LCD_IO_DrawFill(Color, Size) { \
-  SetWriteDir(); \
-  LCD_IO_WriteCmd8DataFill16to24(ST7796_WRITE_RAM, Color, Size); }        /* Fill 24 bit pixel(s) from 16 bit color code */
-#define  LCD_IO_DrawBitmap(pData, Size) { \
-  SetWriteDir(); \
-  LCD_IO_WriteCmd8MultipleData16to24(ST7796_WRITE_RAM, pData, Size); }    /* Draw 24 bit Lcd bitmap from 16 bit bitmap data */
+#define  ST7796_PANEL_DRAWFILL(h, Color, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8DataFill16to24((h)->pIoParam, ST7796_WRITE_RAM, Color, Size); }        /* Fill 24 bit pixel(s) from 16 bit color code */
+#define  ST7796_PANEL_DRAWBITMAP(h, pData, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8MultipleData16to24((h)->pIoParam, ST7796_WRITE_RAM, pData, Size); }    /* Draw 24 bit Lcd bitmap from 16 bit bitmap data */
+#define  ST7796_PANEL_DRAWBITMAPCONT(h, pData, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8MultipleData16to24((h)->pIoParam, ST7796_WRITE_RAM_CONT, pData, Size); } /* Continue 24 bit Lcd bitmap at the memory pointer */
+#define  ST7796_PANEL_DRAWFILLCONT(h, Color, Size) { \
+  ST7796_PANEL_SETWRITEDIR(h); \
+  (h)->pIo->WriteCmd8DataFill16to24((h)->pIoParam, ST7796_WRITE_RAM_CONT, Color, Size); }   /* Continue 24 bit fill at the memory pointer */
 #endif /* #elif ST7796_WRITEBITDEPTH == 24 */
 
 #if ST7796_READBITDEPTH == 16
-#define  LCD_IO_ReadBitmap(pData, Size) { \
-  SetReadDir(); \
-  LCD_IO_ReadCmd8MultipleData16(ST7796_READ_RAM, pData, Size, 1); }      /* Read 16 bit LCD */
+#define  ST7796_PANEL_READBITMAP(h, pData, Size) { \
+  ST7796_PANEL_SETREADDIR(h); \
+  (h)->pIo->ReadCmd8MultipleData16((h)->pIoParam, ST7796_READ_RAM, pData, Size, 1); }      /* Read 16 bit LCD */
 #elif ST7796_READBITDEPTH == 24
-#define  LCD_IO_ReadBitmap(pData, Size) { \
-  SetReadDir(); \
-  LCD_IO_ReadCmd8MultipleData24to16(ST7796_READ_RAM, pData, Size, 1); }  /* Read 24 bit Lcd and convert to 16 bit bitmap */
+#define  ST7796_PANEL_READBITMAP(h, pData, Size) { \
+  ST7796_PANEL_SETREADDIR(h); \
+  (h)->pIo->ReadCmd8MultipleData24to16((h)->pIoParam, ST7796_READ_RAM, pData, Size, 1); }  /* Read 24 bit Lcd and convert to 16 bit bitmap */
 #endif /* #elif ST7796_READBITDEPTH == 24 */
 
+/* the same on the single panel interface panel */
+#define SetWriteDir()                       ST7796_PANEL_SETWRITEDIR(&hst7796)
+#define SetReadDir()                        ST7796_PANEL_SETREADDIR(&hst7796)
+#define LCD_IO_DrawFill(Color, Size)        ST7796_PANEL_DRAWFILL(&hst7796, Color, Size)
+#define LCD_IO_DrawBitmap(pData, Size)      ST7796_PANEL_DRAWBITMAP(&hst7796, pData, Size)
+#define LCD_IO_DrawBitmapCont(pData, Size)  ST7796_PANEL_DRAWBITMAPCONT(&hst7796, pData, Size)
+#define LCD_IO_DrawFillCont(Color, Size)    ST7796_PANEL_DRAWFILLCONT(&hst7796, Color, Size)
+#define LCD_IO_ReadBitmap(pData, Size)      ST7796_PANEL_READBITMAP(&hst7796, pData, Size)
+
 #endif /* ST7796_H */
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
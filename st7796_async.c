@@ -0,0 +1,422 @@
+/**
+ ******************************************************************************
+ * @file    st7796_async.c
+ * @author  MCD Application Team
+ * @brief   Asynchronous drawing for the st7796 driver. The transfers are
+ *          queued and executed by a background transport (DMA on the target,
+ *          a thread on the host), the CPU is free to prepare the next buffer
+ *          while the current one is on the wire.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_async.h"
+
+/* Commands before the pixels of a job: MADCTL, CASET, RASET, COLMOD */
+#define ASYNC_CMDS       4
+#if ST7796_WRITEBITDEPTH == 16
+#define ASYNC_COLMOD     0x55
+#elif ST7796_WRITEBITDEPTH == 24
+#define ASYNC_COLMOD     0x66
+#endif
+
+typedef struct {
+	uint8_t Cmd[ASYNC_CMDS];       /* sent before the pixels */
+	uint8_t Param[ASYNC_CMDS][4];
+	uint8_t ParamSize[ASYNC_CMDS];
+	uint8_t CmdCnt;
+	uint8_t PixelCmd;              /* RAMWR or RAMWRC */
+	uint32_t Size;                 /* pixels (0: commands only) */
+	uint16_t Color;
+	uint16_t *pData;               /* NULL: fill with Color */
+	ST7796_AsyncCallback pCallback;
+	void *pParam;
+} AsyncJob;
+
+static const ST7796_AsyncTransportTypeDef *asynctr;
+static AsyncJob asyncjobs[ST7796_ASYNC_QUEUE];
+static volatile uint8_t asynchead = 0;
+static volatile uint8_t asynccnt = 0;
+static volatile uint8_t asyncrun = 0;
+static volatile uint8_t asyncstep = 0; /* transfers started of the first job */
+static uint16_t *asyncbuf[2];
+static uint8_t asyncbufidx = 0;
+static uint8_t asyncnewwin = 0;        /* 1: the next continue job starts the window */
+
+//-----------------------------------------------------------------------------
+/* Wait with the Idle hook of the transport */
+static void AsyncIdle(void) {
+	if (asynctr->Idle)
+		asynctr->Idle();
+}
+
+//-----------------------------------------------------------------------------
+static void AsyncJobInit(AsyncJob *pJob, uint8_t PixelCmd, uint32_t Size,
+		uint16_t Color, uint16_t *pData, ST7796_AsyncCallback pCallback,
+		void *pParam) {
+	pJob->CmdCnt = 0;
+	pJob->PixelCmd = PixelCmd;
+	pJob->Size = Size;
+	pJob->Color = Color;
+	pJob->pData = pData;
+	pJob->pCallback = pCallback;
+	pJob->pParam = pParam;
+}
+
+//-----------------------------------------------------------------------------
+/* Memory write command of a streaming chunk: the first chunk after
+   ST7796_SetWriteWindowAsync starts at the window origin */
+static uint8_t AsyncPixelCmd(void) {
+	uint8_t cmd = asyncnewwin ? ST7796_WRITE_RAM : ST7796_WRITE_RAM_CONT;
+	asyncnewwin = 0;
+	return cmd;
+}
+
+//-----------------------------------------------------------------------------
+/* Add a command to a job */
+static void AsyncCmd(AsyncJob *pJob, uint8_t Cmd, uint16_t P0, uint16_t P1,
+		uint8_t Size) {
+	uint8_t *p = pJob->Param[pJob->CmdCnt];
+	p[0] = (Size == 1) ? P0 : P0 >> 8;
+	p[1] = P0;
+	p[2] = P1 >> 8;
+	p[3] = P1;
+	pJob->ParamSize[pJob->CmdCnt] = Size;
+	pJob->Cmd[pJob->CmdCnt++] = Cmd;
+}
+
+//-----------------------------------------------------------------------------
+/* Set the commands of the drawing direction and the window of a job. The
+   panel caches of hst7796 are updated when the job is queued: the blocking
+   functions wait for the queue, so they see the state after the last job. */
+static void AsyncWindow(AsyncJob *pJob, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Xsize, uint16_t Ysize) {
+	ST7796_PanelTypeDef *h = &hst7796;
+	uint8_t mad = ST7796_PANEL_MAD_RIGHT_THEN_DOWN(h);
+	uint16_t x2 = Xpos + Xsize - 1, y2 = Ypos + Ysize - 1;
+	if (h->LastEntry != mad) {
+		h->LastEntry = mad;
+		AsyncCmd(pJob, ST7796_MADCTL, mad, 0, 1);
+	}
+	if ((Xpos != h->LastWindow[0]) || (x2 != h->LastWindow[1])) {
+		h->LastWindow[0] = Xpos;
+		h->LastWindow[1] = x2;
+		AsyncCmd(pJob, ST7796_CASET, Xpos, x2, 4);
+	}
+	if ((Ypos != h->LastWindow[2]) || (y2 != h->LastWindow[3])) {
+		h->LastWindow[2] = Ypos;
+		h->LastWindow[3] = y2;
+		AsyncCmd(pJob, ST7796_RASET, Ypos, y2, 4);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Write interface pixel format before the pixels of a job */
+static void AsyncWriteDir(AsyncJob *pJob) {
+#if ST7796_WRITEBITDEPTH != ST7796_READBITDEPTH
+	if (hst7796.LastDir != 0) {
+		hst7796.LastDir = 0;
+		AsyncCmd(pJob, ST7796_COLOR_MODE, ASYNC_COLMOD, 0, 1);
+	}
+#else
+	(void) pJob;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/* Start the next transfer of the first job: its commands, then its pixels
+   (only one context owns asyncrun). The transport only starts the transfer,
+   asyncstep is counted before: the end can be signaled at once. */
+static void AsyncStart(void) {
+	AsyncJob *p = &asyncjobs[asynchead];
+	uint8_t step = asyncstep++;
+	if (step < p->CmdCnt)
+		asynctr->WriteCmd8MultipleData8(p->Cmd[step], p->Param[step],
+				p->ParamSize[step]);
+	else if (p->pData)
+		asynctr->WriteCmd8MultipleData(p->PixelCmd, p->pData, p->Size);
+	else
+		asynctr->WriteCmd8DataFill(p->PixelCmd, p->Color, p->Size);
+}
+
+//-----------------------------------------------------------------------------
+/* Every queued job has at least one transfer (a window job without commands
+   is not queued) */
+static void AsyncQueue(AsyncJob *pJob) {
+	uint8_t start;
+	if (pJob->Size)
+		AsyncWriteDir(pJob);
+	else if (!pJob->CmdCnt)
+		return;
+	while (asynccnt >= ST7796_ASYNC_QUEUE)
+		AsyncIdle();
+	asynctr->Lock();
+	asyncjobs[(asynchead + asynccnt) % ST7796_ASYNC_QUEUE] = *pJob;
+	asynccnt++;
+	start = !asyncrun;
+	asyncrun = 1;
+	asynctr->Unlock();
+	if (start)
+		AsyncStart();
+}
+
+//-----------------------------------------------------------------------------
+/* End of a ST7796_AsyncWriteChunk transfer: clear the busy flag */
+static void AsyncChunkCplt(void *pParam) {
+	*(volatile uint8_t *) pParam = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* 1: the buffer is queued or on the wire */
+static uint8_t AsyncBufferUsed(const uint16_t *pBuffer) {
+	uint8_t i, used = 0;
+	asynctr->Lock();
+	for (i = 0; i < asynccnt; i++)
+		if (asyncjobs[(asynchead + i) % ST7796_ASYNC_QUEUE].pData == pBuffer)
+			used = 1;
+	asynctr->Unlock();
+	return used;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the background transport
+ * @param  pTransport: transport functions
+ * @retval None
+ */
+void ST7796_AsyncInit(const ST7796_AsyncTransportTypeDef *pTransport) {
+	asynctr = pTransport;
+	asynchead = 0;
+	asynccnt = 0;
+	asyncrun = 0;
+	asyncstep = 0;
+	asyncnewwin = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Queue a 16bit/pixel picture (waits only if the queue is full)
+ * @param  Xpos:      Image X position in the LCD
+ * @param  Ypos:      Image Y position in the LCD
+ * @param  Xsize:     Image X size in the LCD
+ * @param  Ysize:     Image Y size in the LCD
+ * @param  pData:     picture address (must be unchanged until the callback)
+ * @param  pCallback: completion callback (NULL: none)
+ * @param  pParam:    callback parameter
+ * @retval None
+ */
+void ST7796_DrawRGBImageAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t *pData, ST7796_AsyncCallback pCallback,
+		void *pParam) {
+	AsyncJob j;
+	if ((Xsize == 0) || (Ysize == 0))
+		return;
+	AsyncJobInit(&j, ST7796_WRITE_RAM, Xsize * Ysize, 0, pData, pCallback,
+			pParam);
+	AsyncWindow(&j, Xpos, Ypos, Xsize, Ysize);
+	asyncnewwin = 0;
+	AsyncQueue(&j);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Queue a filled rectangle (waits only if the queue is full)
+ * @param  Xpos:      specifies the X position.
+ * @param  Ypos:      specifies the Y position.
+ * @param  Xsize:     specifies the X size
+ * @param  Ysize:     specifies the Y size
+ * @param  RGBCode:   specifies the RGB color
+ * @param  pCallback: completion callback (NULL: none)
+ * @param  pParam:    callback parameter
+ * @retval None
+ */
+void ST7796_FillRectAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode, ST7796_AsyncCallback pCallback,
+		void *pParam) {
+	AsyncJob j;
+	if ((Xsize == 0) || (Ysize == 0))
+		return;
+	AsyncJobInit(&j, ST7796_WRITE_RAM, Xsize * Ysize, RGBCode, NULL, pCallback,
+			pParam);
+	AsyncWindow(&j, Xpos, Ypos, Xsize, Ysize);
+	asyncnewwin = 0;
+	AsyncQueue(&j);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Queue a display window, the pixels of the following
+ *         ST7796_WriteRGBAsync / ST7796_WriteFillAsync calls follow each other
+ *         in this window
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Xsize:  specifies the X size
+ * @param  Ysize:  specifies the Y size
+ * @retval None
+ */
+void ST7796_SetWriteWindowAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	AsyncJob j;
+	if ((Xsize == 0) || (Ysize == 0))
+		return;
+	AsyncJobInit(&j, 0, 0, 0, NULL, NULL, NULL);
+	AsyncWindow(&j, Xpos, Ypos, Xsize, Ysize);
+	asyncnewwin = 1;
+	AsyncQueue(&j);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Queue 16bit/pixel data for the window of ST7796_SetWriteWindowAsync
+ * @param  pData:     pixel data (must be unchanged until the callback)
+ * @param  Size:      number of pixels
+ * @param  pCallback: completion callback (NULL: none)
+ * @param  pParam:    callback parameter
+ * @retval None
+ */
+void ST7796_WriteRGBAsync(uint16_t *pData, uint32_t Size,
+		ST7796_AsyncCallback pCallback, void *pParam) {
+	AsyncJob j;
+	if (Size == 0)
+		return;
+	AsyncJobInit(&j, AsyncPixelCmd(), Size, 0, pData, pCallback, pParam);
+	AsyncQueue(&j);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Queue pixels of one color for the window of ST7796_SetWriteWindowAsync
+ * @param  RGBCode:   specifies the RGB color
+ * @param  Size:      number of pixels
+ * @param  pCallback: completion callback (NULL: none)
+ * @param  pParam:    callback parameter
+ * @retval None
+ */
+void ST7796_WriteFillAsync(uint16_t RGBCode, uint32_t Size,
+		ST7796_AsyncCallback pCallback, void *pParam) {
+	AsyncJob j;
+	if (Size == 0)
+		return;
+	AsyncJobInit(&j, AsyncPixelCmd(), Size, RGBCode, NULL, pCallback, pParam);
+	AsyncQueue(&j);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Transfer in progress or queued
+ * @param  None
+ * @retval 0: idle, 1: busy
+ */
+uint8_t ST7796_AsyncBusy(void) {
+	uint8_t ret;
+	if (!asynctr)
+		return 0;
+	asynctr->Lock();
+	ret = asynccnt != 0;
+	asynctr->Unlock();
+	return ret;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Wait for the end of every queued transfer
+ * @param  None
+ * @retval None
+ */
+void ST7796_AsyncWait(void) {
+	while (ST7796_AsyncBusy())
+		AsyncIdle();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  End of transfer (called by the transport: DMA interrupt, thread)
+ *         the next queued job is started before the callback is called
+ * @param  None
+ * @retval None
+ */
+void ST7796_AsyncTransferCplt(void) {
+	AsyncJob *p = &asyncjobs[asynchead];
+	ST7796_AsyncCallback cb = NULL;
+	void *param = NULL;
+	uint8_t start = 1;
+	if (asyncstep >= p->CmdCnt + (p->Size != 0)) {
+		/* last transfer of the job */
+		cb = p->pCallback;
+		param = p->pParam;
+		asynctr->Lock();
+		asynchead = (asynchead + 1) % ST7796_ASYNC_QUEUE;
+		asynccnt--;
+		start = asynccnt != 0;
+		asyncrun = start;
+		asyncstep = 0;
+		asynctr->Unlock();
+	}
+	if (start)
+		AsyncStart();
+	if (cb)
+		cb(param);
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Queue one half of a ping-pong pixel buffer of a driver module and
+ *         wait until the transfer of the other half is done
+ * @param  pData: pixel data (half Index of the buffer)
+ * @param  Size:  number of pixels
+ * @param  pBusy: busy flags of the two halves (1: queued or on the wire)
+ * @param  Index: half of pData (0 or 1)
+ * @retval None
+ */
+void ST7796_AsyncWriteChunk(uint16_t *pData, uint32_t Size,
+		volatile uint8_t *pBusy, uint8_t Index) {
+	if (Size) {
+		pBusy[Index] = 1;
+		ST7796_WriteRGBAsync(pData, Size, AsyncChunkCplt, (void *) &pBusy[Index]);
+	}
+	while (pBusy[Index ^ 1])
+		AsyncIdle();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the ping-pong buffers
+ * @param  pBuffer0: first buffer
+ * @param  pBuffer1: second buffer
+ * @retval None
+ */
+void ST7796_AsyncSetBuffers(uint16_t *pBuffer0, uint16_t *pBuffer1) {
+	asyncbuf[0] = pBuffer0;
+	asyncbuf[1] = pBuffer1;
+	asyncbufidx = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the next free ping-pong buffer
+ * @param  None
+ * @retval buffer address
+ */
+uint16_t * ST7796_AsyncGetBuffer(void) {
+	uint16_t *p = asyncbuf[asyncbufidx];
+	while (AsyncBufferUsed(p))
+		AsyncIdle();
+	asyncbufidx ^= 1;
+	return p;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
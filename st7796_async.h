@@ -0,0 +1,85 @@
+/**
+ ******************************************************************************
+ * @file    st7796_async.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 asynchronous
+ *          (DMA driven) drawing functions.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_ASYNC_H
+#define ST7796_ASYNC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Completion callback (called from the transport context: DMA interrupt or
+   transport thread) */
+typedef void (*ST7796_AsyncCallback)(void *pParam);
+
+/**
+ * @brief  Background transport
+ *         The Write functions start the transfer and return immediately, the
+ *         end of the transfer must be signaled with ST7796_AsyncTransferCplt
+ *         (it starts the next transfer, no blocking bus access happens in the
+ *         transport context). The pixel format of WriteCmd8MultipleData and
+ *         WriteCmd8DataFill follows ST7796_WRITEBITDEPTH (like
+ *         LCD_IO_DrawBitmap / LCD_IO_DrawFill), WriteCmd8MultipleData8 sends
+ *         the parameter bytes of the window, MADCTL and COLMOD commands.
+ */
+typedef struct {
+	void (*WriteCmd8MultipleData)(uint8_t Cmd, uint16_t *pData, uint32_t Size);
+	void (*WriteCmd8DataFill)(uint8_t Cmd, uint16_t Data, uint32_t Size);
+	void (*WriteCmd8MultipleData8)(uint8_t Cmd, uint8_t *pData, uint32_t Size);
+	void (*Lock)(void);            /* enter critical section (e.g. __disable_irq) */
+	void (*Unlock)(void);          /* leave critical section */
+	void (*Idle)(void);            /* called while waiting (NULL: busy loop) */
+} ST7796_AsyncTransportTypeDef;
+
+//-----------------------------------------------------------------------------
+void ST7796_AsyncInit(const ST7796_AsyncTransportTypeDef *pTransport);
+void ST7796_DrawRGBImageAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t *pData, ST7796_AsyncCallback pCallback,
+		void *pParam);
+void ST7796_FillRectAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode, ST7796_AsyncCallback pCallback,
+		void *pParam);
+
+/* Streaming: one window, then any number of pixel chunks */
+void ST7796_SetWriteWindowAsync(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize);
+void ST7796_WriteRGBAsync(uint16_t *pData, uint32_t Size,
+		ST7796_AsyncCallback pCallback, void *pParam);
+void ST7796_WriteFillAsync(uint16_t RGBCode, uint32_t Size,
+		ST7796_AsyncCallback pCallback, void *pParam);
+
+uint8_t ST7796_AsyncBusy(void);
+void ST7796_AsyncWait(void);
+void ST7796_AsyncTransferCplt(void);
+
+/* Ping-pong buffer halves of the driver modules: queue half Index and wait
+   until the transfer of the other half is done (the busy flags are set
+   while a half is queued or on the wire) */
+void ST7796_AsyncWriteChunk(uint16_t *pData, uint32_t Size,
+		volatile uint8_t *pBusy, uint8_t Index);
+
+/* Ping-pong buffers: ST7796_AsyncGetBuffer returns the buffer that is not
+   queued or on the wire (waits if both are in use) */
+void ST7796_AsyncSetBuffers(uint16_t *pBuffer0, uint16_t *pBuffer1);
+uint16_t * ST7796_AsyncGetBuffer(void);
+
+#endif /* ST7796_ASYNC_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,155 @@
+/**
+ ******************************************************************************
+ * @file    st7796_band.c
+ * @author  MCD Application Team
+ * @brief   Band renderer for the st7796 driver. The screen is rendered by a
+ *          user callback into ST7796_BAND_LINES high strips, every strip is
+ *          sent with one burst write, so a full screen composited image
+ *          needs only a few KB of RAM instead of a framebuffer.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_band.h"
+#if ST7796_ASYNC == 1
+#include "st7796_async.h"
+#endif
+
+static uint16_t *bandbuf[2];
+
+//-----------------------------------------------------------------------------
+/* Clip a rectangle to the band (0: nothing left) */
+static uint8_t BandClip(const ST7796_BandTypeDef *pBand, uint16_t *pX,
+		uint16_t *pY, uint16_t *pW, uint16_t *pH) {
+	uint32_t y2 = (uint32_t) *pY + *pH;
+	if ((*pX >= ST7796_SIZE_X) || (*pW == 0) || (*pH == 0)
+			|| (*pY >= pBand->Ypos + pBand->Lines) || (y2 <= pBand->Ypos))
+		return 0;
+	if (*pW > ST7796_SIZE_X - *pX)
+		*pW = ST7796_SIZE_X - *pX;
+	if (*pY < pBand->Ypos)
+		*pY = pBand->Ypos;
+	if (y2 > pBand->Ypos + pBand->Lines)
+		y2 = pBand->Ypos + pBand->Lines;
+	*pH = y2 - *pY;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the band buffers
+ * @param  pBuffer0: first buffer (ST7796_SIZE_X * ST7796_BAND_LINES pixels)
+ * @param  pBuffer1: second buffer (NULL: render and transfer do not overlap)
+ * @retval None
+ */
+void ST7796_BandInit(uint16_t *pBuffer0, uint16_t *pBuffer1) {
+	bandbuf[0] = pBuffer0;
+	bandbuf[1] = pBuffer1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Render the full screen band by band
+ *         (asynchronous mode: the last band can still be on the wire)
+ * @param  pRender: render callback
+ * @param  pParam:  callback parameter
+ * @retval None
+ */
+void ST7796_BandRender(ST7796_BandRenderCallback pRender, void *pParam) {
+	ST7796_BandTypeDef band;
+	ST7796_Sync();
+#if ST7796_ASYNC == 1
+	if (bandbuf[1]) {
+		/* two bands in flight: render into the free ping-pong buffer */
+		ST7796_AsyncSetBuffers(bandbuf[0], bandbuf[1]);
+		for (band.Ypos = 0; band.Ypos < ST7796_SIZE_Y; band.Ypos += band.Lines) {
+			band.Lines = ST7796_SIZE_Y - band.Ypos;
+			if (band.Lines > ST7796_BAND_LINES)
+				band.Lines = ST7796_BAND_LINES;
+			band.pBuffer = ST7796_AsyncGetBuffer();
+			pRender(&band, pParam);
+			ST7796_DrawRGBImageAsync(0, band.Ypos, ST7796_SIZE_X, band.Lines,
+					band.pBuffer, NULL, NULL);
+		}
+		return;
+	}
+#endif
+	/* one window for the screen, the memory pointer continues from band to band */
+	ST7796_SetWriteWindow(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y);
+	band.pBuffer = bandbuf[0];
+	for (band.Ypos = 0; band.Ypos < ST7796_SIZE_Y; band.Ypos += band.Lines) {
+		band.Lines = ST7796_SIZE_Y - band.Ypos;
+		if (band.Lines > ST7796_BAND_LINES)
+			band.Lines = ST7796_BAND_LINES;
+		pRender(&band, pParam);
+		if (band.Ypos == 0) {
+			LCD_IO_DrawBitmap(band.pBuffer, ST7796_SIZE_X * band.Lines);
+		} else {
+			LCD_IO_DrawBitmapCont(band.pBuffer, ST7796_SIZE_X * band.Lines);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw Filled rectangle into the band
+ * @param  pBand:    band under rendering
+ * @param  Xpos:     specifies the X position.
+ * @param  Ypos:     specifies the Y position.
+ * @param  Xsize:    specifies the X size
+ * @param  Ysize:    specifies the Y size
+ * @param  RGBCode:  specifies the RGB color
+ * @retval None
+ */
+void ST7796_BandFillRect(const ST7796_BandTypeDef *pBand, uint16_t Xpos,
+		uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode) {
+	uint16_t x, y;
+	uint16_t *p;
+	if (!BandClip(pBand, &Xpos, &Ypos, &Xsize, &Ysize))
+		return;
+	for (y = 0; y < Ysize; y++) {
+		p = &pBand->pBuffer[(Ypos - pBand->Ypos + y) * ST7796_SIZE_X + Xpos];
+		for (x = 0; x < Xsize; x++)
+			*p++ = RGBCode;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw 16bit/pixel picture into the band
+ * @param  pBand: band under rendering
+ * @param  Xpos:  Image X position in the LCD
+ * @param  Ypos:  Image Y position in the LCD
+ * @param  Xsize: Image X size in the LCD
+ * @param  Ysize: Image Y size in the LCD
+ * @param  pData: picture address
+ * @retval None
+ */
+void ST7796_BandDrawRGBImage(const ST7796_BandTypeDef *pBand, uint16_t Xpos,
+		uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData) {
+	uint16_t y, y0 = Ypos, w = Xsize;
+	if (!BandClip(pBand, &Xpos, &Ypos, &w, &Ysize))
+		return;
+	pData += (Ypos - y0) * Xsize;
+	for (y = 0; y < Ysize; y++, pData += Xsize)
+		memcpy(&pBand->pBuffer[(Ypos - pBand->Ypos + y) * ST7796_SIZE_X + Xpos],
+				pData, w * 2);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
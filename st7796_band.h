@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @file    st7796_band.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 band renderer
+ *          (full screen drawing through ST7796_BAND_LINES high strips).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_BAND_H
+#define ST7796_BAND_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/**
+ * @brief  Band under rendering
+ *         pBuffer[0] is the (0, Ypos) screen pixel, the row pitch is
+ *         ST7796_SIZE_X pixels
+ */
+typedef struct {
+	uint16_t *pBuffer;
+	uint16_t Ypos;                 /* first screen line of the band */
+	uint16_t Lines;                /* number of lines (the last band can be shorter) */
+} ST7796_BandTypeDef;
+
+/* Render callback: draw every pixel of the band */
+typedef void (*ST7796_BandRenderCallback)(const ST7796_BandTypeDef *pBand,
+		void *pParam);
+
+//-----------------------------------------------------------------------------
+/* Band buffers: ST7796_SIZE_X * ST7796_BAND_LINES pixels. With two buffers
+   and ST7796_ASYNC == 1 the next band is rendered while the previous is on
+   the wire (the st7796_async ping-pong buffers are replaced). */
+void ST7796_BandInit(uint16_t *pBuffer0, uint16_t *pBuffer1);
+void ST7796_BandRender(ST7796_BandRenderCallback pRender, void *pParam);
+
+/* Render helpers (screen coordinates, clipped to the band) */
+void ST7796_BandFillRect(const ST7796_BandTypeDef *pBand, uint16_t Xpos,
+		uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
+void ST7796_BandDrawRGBImage(const ST7796_BandTypeDef *pBand, uint16_t Xpos,
+		uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
+
+#endif /* ST7796_BAND_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,569 @@
+/**
+ ******************************************************************************
+ * @file    st7796_bench.c
+ * @author  MCD Application Team
+ * @brief   Bus cost benchmark of the st7796_drv primitives. The workloads run
+ *          on the host against the st7796_sim panel emulator, the report is
+ *          a CSV table (one line / workload / bus) so two builds can be
+ *          compared with diff.
+ *          Build with ST7796_BENCH_MAIN defined to get a command line tool
+ *          (the text workloads need st7796_font.c and st7796_font_conv.c,
+ *          the alpha workload st7796_blend.c, the shape workloads
+ *          st7796_shape.c, the scatter workload st7796_scatter.c):
+ *          st7796_bench [spi=Hz] [p8=Hz] [p16=Hz] [boot] [panels=N]
+ *          boot:     instead of the workload table, the boot time split into
+ *                    init delays and bus transfers
+ *          panels=N: instead of the workload table, the wall time of 1 .. N
+ *                    emulated panels drawn at the same time (one thread /
+ *                    panel, the wire time of the spi bus is waited by the
+ *                    emulator)
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include "main.h"
+#include "lcd.h"
+#include "bmp.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_sim.h"
+#include "st7796_font.h"
+#include "st7796_blend.h"
+#include "st7796_shape.h"
+#include "st7796_scatter.h"
+#include "st7796_bench.h"
+
+extern LCD_DrvTypeDef st7796_drv;
+
+#define BENCH_PIXELS      10000        /* WritePixel storm size */
+#define BENCH_READPIXELS  1000         /* ReadPixel count */
+#define BENCH_GRID        8            /* HLine / VLine grid step */
+#define BENCH_TILE        8            /* small FillRect size */
+#define BENCH_BMPSIZE     64           /* DrawBitmap width and height */
+#define BENCH_FONTW       10           /* text workload glyph cell */
+#define BENCH_FONTH       16
+#define BENCH_TEXTLINES   10
+#define BENCH_PANELFRAMES 4            /* frames / panel of the multi panel run */
+#define BENCH_SHAPEROWS   8            /* shape workload rows (7 shapes / row) */
+#define BENCH_SCATTER     4000         /* scatter plot points */
+
+static uint16_t benchimg[ST7796_LCD_PIXEL_WIDTH * ST7796_LCD_PIXEL_HEIGHT];
+static uint8_t benchbmp[sizeof(BITMAPSTRUCT) + BENCH_BMPSIZE * BENCH_BMPSIZE * 2];
+static uint32_t benchrnd;
+
+static const char benchtext[] = "The quick brown fox jumps over the lazy dog";
+static uint8_t benchspan[95 * BENCH_FONTW * BENCH_FONTH];
+static ST7796_GlyphTypeDef benchglyph[95];
+static uint16_t benchline[ST7796_LCD_PIXEL_HEIGHT * BENCH_FONTH];
+static uint16_t benchblend[ST7796_LCD_PIXEL_HEIGHT * BENCH_FONTH];
+static ST7796_PointTypeDef benchpoint[BENCH_SCATTER];
+static uint16_t benchcolor[BENCH_SCATTER];
+static uint32_t benchwork[2 * BENCH_SCATTER];
+static const ST7796_FontTypeDef benchfont = { benchglyph, benchspan, ' ', 95,
+		BENCH_FONTH, BENCH_FONTH - 4, 4 };
+
+//-----------------------------------------------------------------------------
+/* Deterministic pseudo random generator (the report must be reproducible) */
+static uint32_t BenchRand(void) {
+	benchrnd = benchrnd * 1103515245U + 12345U;
+	return benchrnd >> 8;
+}
+
+/* Workloads -----------------------------------------------------------------*/
+
+static uint32_t BenchInit(void) {
+	st7796_drv.Init();
+	return 1;
+}
+
+static uint32_t BenchWritePixel(void) {
+	uint32_t i;
+	for (i = 0; i < BENCH_PIXELS; i++)
+		st7796_drv.WritePixel(BenchRand() % ST7796_SIZE_X,
+				BenchRand() % ST7796_SIZE_Y, BenchRand());
+	return BENCH_PIXELS;
+}
+
+static uint32_t BenchReadPixel(void) {
+	uint32_t i;
+	for (i = 0; i < BENCH_READPIXELS; i++)
+		st7796_drv.ReadPixel(BenchRand() % ST7796_SIZE_X,
+				BenchRand() % ST7796_SIZE_Y);
+	return BENCH_READPIXELS;
+}
+
+static uint32_t BenchHLineGrid(void) {
+	uint32_t y, n = 0;
+	for (y = 0; y < ST7796_SIZE_Y; y += BENCH_GRID, n++)
+		st7796_drv.DrawHLine(0xFFFF, 0, y, ST7796_SIZE_X);
+	return n;
+}
+
+static uint32_t BenchVLineGrid(void) {
+	uint32_t x, n = 0;
+	for (x = 0; x < ST7796_SIZE_X; x += BENCH_GRID, n++)
+		st7796_drv.DrawVLine(0xFFFF, x, 0, ST7796_SIZE_Y);
+	return n;
+}
+
+static uint32_t BenchFillRectFull(void) {
+	st7796_drv.FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x001F);
+	return 1;
+}
+
+static uint32_t BenchFillRectTiles(void) {
+	uint32_t x, y, n = 0;
+	for (y = 0; y + BENCH_TILE <= ST7796_SIZE_Y; y += 4 * BENCH_TILE)
+		for (x = 0; x + BENCH_TILE <= ST7796_SIZE_X; x += 4 * BENCH_TILE, n++)
+			st7796_drv.FillRect(x, y, BENCH_TILE, BENCH_TILE, BenchRand());
+	return n;
+}
+
+static uint32_t BenchDrawRGBImage(void) {
+	st7796_drv.DrawRGBImage(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, benchimg);
+	return 1;
+}
+
+static uint32_t BenchDrawRGBImageRot(void) {
+	/* square: fits in every orientation */
+	ST7796_DrawRGBImageTransform(0, 0, ST7796_LCD_PIXEL_WIDTH,
+			ST7796_LCD_PIXEL_WIDTH, benchimg, ST7796_ROT_90);
+	return 1;
+}
+
+static uint32_t BenchReadRGBImage(void) {
+	st7796_drv.ReadRGBImage(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, benchimg);
+	return 1;
+}
+
+static uint32_t BenchDrawBitmap(void) {
+	st7796_drv.SetDisplayWindow(0, 0, BENCH_BMPSIZE, BENCH_BMPSIZE);
+	st7796_drv.DrawBitmap(0, 0, benchbmp);
+	return 2;
+}
+
+static uint32_t BenchScroll(void) {
+	uint32_t i;
+	for (i = 0; i < ST7796_SIZE_Y; i++)
+		st7796_drv.Scroll(i, 0, 0);
+	st7796_drv.Scroll(0, 0, 0);
+	return i + 1;
+}
+
+static uint32_t BenchTextWritePixel(void) {
+	/* per pixel character drawing of the BSP (every pixel of the cell) */
+	uint32_t i, l, x, y;
+	for (l = 0; l < BENCH_TEXTLINES; l++)
+		for (i = 0; i < sizeof(benchtext) - 1; i++)
+			for (y = 0; y < BENCH_FONTH; y++)
+				for (x = 0; x < BENCH_FONTW; x++)
+					st7796_drv.WritePixel(i * BENCH_FONTW + x, l * BENCH_FONTH + y,
+							((x ^ y ^ i) & 4) ? 0xFFFF : 0x0000);
+	return BENCH_TEXTLINES * (sizeof(benchtext) - 1);
+}
+
+static uint32_t BenchTextGlyph(void) {
+	uint32_t l;
+	ST7796_FontInit(NULL, 0);
+	for (l = 0; l < BENCH_TEXTLINES; l++)
+		ST7796_DrawString(0, l * BENCH_FONTH, &benchfont, benchtext);
+	return BENCH_TEXTLINES * (sizeof(benchtext) - 1);
+}
+
+static uint32_t BenchTextLine(void) {
+	uint32_t l;
+	ST7796_FontInit(benchline, sizeof(benchline) / sizeof(benchline[0]));
+	for (l = 0; l < BENCH_TEXTLINES; l++)
+		ST7796_DrawString(0, l * BENCH_FONTH, &benchfont, benchtext);
+	return BENCH_TEXTLINES * (sizeof(benchtext) - 1);
+}
+
+static uint32_t BenchFillRectAlpha(void) {
+	/* dimmed modal background */
+	ST7796_BlendInit(benchblend, sizeof(benchblend) / sizeof(benchblend[0]));
+	ST7796_FillRectAlpha(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000, 128);
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* One row of circles, arcs, triangles, rounded rectangles and diagonal lines
+   in cells across the screen */
+static uint32_t BenchShapeSet(void) {
+	uint32_t i;
+	uint16_t w = ST7796_SIZE_X / 7, h = ST7796_SIZE_Y / BENCH_SHAPEROWS;
+	uint16_t r = ((w < h) ? w : h) / 2 - 2, x, y, c;
+	for (i = 0; i < BENCH_SHAPEROWS; i++) {
+		y = i * h;
+		x = 0;
+		c = 0x8000 | (0x0841 * (i + 1));
+		ST7796_FillCircle(x + w / 2, y + h / 2, r, c);
+		x += w;
+		ST7796_DrawCircle(x + w / 2, y + h / 2, r, c);
+		x += w;
+		ST7796_DrawArc(x + w / 2, y + h / 2, r, r / 3, 45 * i, 45 * i + 240, c);
+		x += w;
+		ST7796_FillTriangle(x + 2, y + h - 3, x + w / 2, y + 2, x + w - 3, y + h - 3 - i * 4, c);
+		x += w;
+		ST7796_FillRoundRect(x + 2, y + 2, w - 4, h - 4, r / 3, c);
+		x += w;
+		ST7796_DrawLine(x + 2, y + 2, x + w - 3, y + h - 3 - i * 5, c);
+		x += w;
+		ST7796_DrawThickLine(x + 4, y + h - 5, x + w - 5, y + 4 + i * 3, 5, c);
+	}
+	return BENCH_SHAPEROWS * 7;
+}
+
+static uint32_t BenchShapeWritePixel(void) {
+	/* per pixel drawing of the same shapes by the BSP (the pixels are taken
+	   from the emulator, the reference drawing is not counted) */
+	uint32_t n;
+	uint16_t x, y, c;
+	ST7796_BlendInit(benchblend, sizeof(benchblend) / sizeof(benchblend[0]));
+	st7796_drv.FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	n = BenchShapeSet();
+	ST7796_Sim_ResetStat();
+	for (y = 0; y < ST7796_SIZE_Y; y++)
+		for (x = 0; x < ST7796_SIZE_X; x++)
+			if ((c = ST7796_Sim_GetScreenPixel(x, y)))
+				st7796_drv.WritePixel(x, y, c);
+	return n;
+}
+
+static uint32_t BenchShapeSpans(void) {
+	st7796_drv.FillRect(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y, 0x0000);
+	ST7796_Sim_ResetStat(); /* the clear is not counted */
+	return BenchShapeSet();
+}
+
+//-----------------------------------------------------------------------------
+/* Scatter plot: a dense cloud around a point and a noisy line chart (own
+   generator: the same points for both scatter workloads) */
+static void BenchScatterSet(void) {
+	uint32_t i, rnd = 7;
+	for (i = 0; i < BENCH_SCATTER / 2; i++) {
+		rnd = rnd * 1103515245U + 12345U;
+		benchpoint[i].X = ST7796_SIZE_X / 4 + ((rnd >> 8) & 31) + ((rnd >> 16) & 15);
+		benchpoint[i].Y = ST7796_SIZE_Y / 4 + ((rnd >> 12) & 31) + ((rnd >> 20) & 15);
+		benchcolor[i] = 0xF800 | (i & 0x07FF);
+	}
+	for (; i < BENCH_SCATTER; i++) {
+		rnd = rnd * 1103515245U + 12345U;
+		benchpoint[i].X = i % ST7796_SIZE_X;
+		benchpoint[i].Y = ST7796_SIZE_Y / 2 + (i % ST7796_SIZE_X) / 8 + ((rnd >> 16) & 7);
+		benchcolor[i] = 0x07E0;
+	}
+}
+
+static uint32_t BenchScatterWritePixel(void) {
+	uint32_t i;
+	BenchScatterSet();
+	for (i = 0; i < BENCH_SCATTER; i++)
+		st7796_drv.WritePixel(benchpoint[i].X, benchpoint[i].Y, benchcolor[i]);
+	return BENCH_SCATTER;
+}
+
+static uint32_t BenchScatterWritePixels(void) {
+	BenchScatterSet();
+	ST7796_ScatterInit(benchwork, sizeof(benchwork) / sizeof(benchwork[0]));
+	ST7796_WritePixels(benchpoint, benchcolor, BENCH_SCATTER);
+	return BENCH_SCATTER;
+}
+
+static const struct {
+	const char *Name;
+	uint32_t (*Func)(void);
+} benchworkloads[ST7796_BENCH_WORKLOADS] = {
+	{ "Init", BenchInit },
+	{ "WritePixel", BenchWritePixel },
+	{ "ReadPixel", BenchReadPixel },
+	{ "DrawHLineGrid", BenchHLineGrid },
+	{ "DrawVLineGrid", BenchVLineGrid },
+	{ "FillRectFull", BenchFillRectFull },
+	{ "FillRectTiles", BenchFillRectTiles },
+	{ "DrawRGBImageFull", BenchDrawRGBImage },
+	{ "DrawRGBImageRot90", BenchDrawRGBImageRot },
+	{ "ReadRGBImageFull", BenchReadRGBImage },
+	{ "DrawBitmap", BenchDrawBitmap },
+	{ "ScrollSweep", BenchScroll },
+	{ "TextWritePixel", BenchTextWritePixel },
+	{ "TextGlyphWindow", BenchTextGlyph },
+	{ "TextLineBuffer", BenchTextLine },
+	{ "FillRectAlphaFull", BenchFillRectAlpha },
+	{ "ShapeWritePixel", BenchShapeWritePixel },
+	{ "ShapeSpans", BenchShapeSpans },
+	{ "ScatterWritePixel", BenchScatterWritePixel },
+	{ "ScatterWritePixels", BenchScatterWritePixels }
+};
+
+//-----------------------------------------------------------------------------
+/* Bus traffic of the emulated panel since the last counter reset */
+static void BenchGetResult(ST7796_BenchResultTypeDef *pResult) {
+	const ST7796_SimStatTypeDef *pStat = ST7796_Sim_GetStat();
+	pResult->Cmds = pStat->Cmds;
+	pResult->PixelBytes = pStat->CmdBytes[ST7796_WRITE_RAM]
+			+ pStat->CmdBytes[ST7796_WRITE_RAM_CONT]
+			+ pStat->CmdBytes[ST7796_READ_RAM]
+			+ pStat->CmdBytes[ST7796_READ_RAM_CONT];
+	pResult->ParamBytes = pStat->WrBytes + pStat->RdBytes - pResult->PixelBytes;
+	pResult->DummyBytes = pStat->DummyBytes;
+	pResult->Pixels = pStat->WrPixels + pStat->RdPixels;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Run every workload on a freshly initialized emulated panel
+ * @param  pResult: result array (ST7796_BENCH_WORKLOADS items)
+ * @retval number of results
+ */
+uint32_t ST7796_Bench_Run(ST7796_BenchResultTypeDef *pResult) {
+	BITMAPSTRUCT *pBmp = (BITMAPSTRUCT*) benchbmp;
+	uint8_t level[BENCH_FONTW * BENCH_FONTH];
+	uint32_t i, j, n = 0;
+
+	benchrnd = 1;
+	for (i = 0; i < sizeof(benchimg) / sizeof(benchimg[0]); i++)
+		benchimg[i] = BenchRand();
+	memset(benchbmp, 0, sizeof(BITMAPSTRUCT));
+	pBmp->fileHeader.bfSize = sizeof(benchbmp);
+	pBmp->fileHeader.bfOffBits = sizeof(BITMAPSTRUCT);
+	pBmp->infoHeader.biWidth = BENCH_BMPSIZE;
+	pBmp->infoHeader.biHeight = BENCH_BMPSIZE;
+	pBmp->infoHeader.biBitCount = 16;
+	/* synthetic 4 bpp font: anti-aliased edges around a solid core */
+	for (i = 0; i < 95; i++) {
+		for (j = 0; j < BENCH_FONTW * BENCH_FONTH; j++)
+			level[j] = ((j % BENCH_FONTW < 1) || (j % BENCH_FONTW > 7)
+					|| (j / BENCH_FONTW < 3) || (j / BENCH_FONTW > 12)) ? 0 :
+					(((j + i) % 5) ? 15 : BenchRand() & 15);
+		benchglyph[i].Offset = n;
+		benchglyph[i].Advance = BENCH_FONTW;
+		n += ST7796_FontEncodeGlyph(level, BENCH_FONTW * BENCH_FONTH, 4,
+				&benchspan[n], sizeof(benchspan) - n);
+	}
+	ST7796_FontSetColor(0xFFFF, 0x0000);
+
+	ST7796_Sim_Reset();
+	st7796_drv.Init();
+	for (i = 0; i < ST7796_BENCH_WORKLOADS; i++) {
+		ST7796_Sim_ResetStat();
+		pResult[i].Name = benchworkloads[i].Name;
+		pResult[i].Calls = benchworkloads[i].Func();
+		BenchGetResult(&pResult[i]);
+	}
+	return ST7796_BENCH_WORKLOADS;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Total bytes on the bus (command + parameter + pixel + dummy)
+ * @param  pResult: workload result
+ * @retval bytes
+ */
+uint32_t ST7796_Bench_BusBytes(const ST7796_BenchResultTypeDef *pResult) {
+	return pResult->Cmds + pResult->ParamBytes + pResult->PixelBytes
+			+ pResult->DummyBytes;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Estimated bus time of a workload
+ * @param  pResult: workload result
+ * @param  pBus:    bus timing model
+ * @retval time [us]
+ */
+uint32_t ST7796_Bench_TimeUs(const ST7796_BenchResultTypeDef *pResult,
+		const ST7796_BenchBusTypeDef *pBus) {
+	uint64_t clocks;
+	uint8_t cmdwidth = (pBus->BusWidth < 8) ? pBus->BusWidth : 8;
+	clocks = (uint64_t) pResult->Cmds * 8 / cmdwidth
+			+ ((uint64_t) pResult->ParamBytes + pResult->PixelBytes
+					+ pResult->DummyBytes) * 8 / pBus->BusWidth;
+	return (uint32_t) ((clocks * 1000000U + pBus->ClockHz - 1) / pBus->ClockHz
+			+ ((uint64_t) pResult->Cmds * pBus->CmdOverheadNs + 999) / 1000);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Print the results in CSV format
+ * @param  pOut:      output stream
+ * @param  pResult:   results
+ * @param  ResultNum: number of results
+ * @param  pBus:      bus timing models
+ * @param  BusNum:    number of bus timing models
+ * @retval None
+ */
+void ST7796_Bench_Report(FILE *pOut, const ST7796_BenchResultTypeDef *pResult,
+		uint32_t ResultNum, const ST7796_BenchBusTypeDef *pBus, uint32_t BusNum) {
+	uint32_t i, b, framing, t;
+	fprintf(pOut, "workload,bus,calls,cmds,param_bytes,pixel_bytes,dummy_bytes,"
+			"bus_bytes,pixels,pixels_per_cmd_byte,time_us,bus_bytes_per_call,"
+			"calls_per_s\n");
+	for (i = 0; i < ResultNum; i++) {
+		framing = pResult[i].Cmds + pResult[i].ParamBytes;
+		for (b = 0; b < BusNum; b++) {
+			t = ST7796_Bench_TimeUs(&pResult[i], &pBus[b]);
+			fprintf(pOut, "%s,%s,%u,%u,%u,%u,%u,%u,%u,%.3f,%u,%.1f,%.0f\n",
+					pResult[i].Name, pBus[b].Name, pResult[i].Calls,
+					pResult[i].Cmds, pResult[i].ParamBytes, pResult[i].PixelBytes,
+					pResult[i].DummyBytes, ST7796_Bench_BusBytes(&pResult[i]),
+					pResult[i].Pixels,
+					framing ? (double) pResult[i].Pixels / framing : 0.0, t,
+					(double) ST7796_Bench_BusBytes(&pResult[i]) / pResult[i].Calls,
+					t ? (double) pResult[i].Calls * 1000000.0 / t : 0.0);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Boot time of the panel (power on to the first visible pixel) in
+ *         CSV format: the LCD_Delay waits and the bus transfers of the init
+ * @param  pOut:   output stream
+ * @param  pBus:   bus timing models
+ * @param  BusNum: number of bus timing models
+ * @retval sum of the init delays [ms]
+ */
+uint32_t ST7796_Bench_Boot(FILE *pOut, const ST7796_BenchBusTypeDef *pBus,
+		uint32_t BusNum) {
+	ST7796_BenchResultTypeDef r;
+	uint32_t b, delay, t;
+	ST7796_Sim_Reset();
+	st7796_drv.Init();
+	delay = ST7796_Sim_GetStat()->DelayMs;
+	r.Name = "Init";
+	r.Calls = 1;
+	BenchGetResult(&r);
+	fprintf(pOut, "bus,cmds,bus_bytes,delay_ms,transfer_us,boot_us,delay_share\n");
+	for (b = 0; b < BusNum; b++) {
+		t = ST7796_Bench_TimeUs(&r, &pBus[b]);
+		fprintf(pOut, "%s,%u,%u,%u,%u,%u,%.3f\n", pBus[b].Name, r.Cmds,
+				ST7796_Bench_BusBytes(&r), delay, t, delay * 1000 + t,
+				delay * 1000.0 / (delay * 1000 + t));
+	}
+	return delay;
+}
+
+/**
+ * @brief  Panel instance of the multi panel run
+ */
+typedef struct {
+	ST7796_PanelTypeDef hpanel;
+	ST7796_SimPanelTypeDef sim;
+	pthread_t thread;
+} BenchPanelTypeDef;
+
+//-----------------------------------------------------------------------------
+/* Frame loop of a panel: full screen clear and picture */
+static void *BenchPanelThread(void *pArg) {
+	BenchPanelTypeDef *p = pArg;
+	uint16_t w, h;
+	uint32_t f;
+	ST7796_Panel_Init(&p->hpanel);
+	w = ST7796_Panel_GetLcdPixelWidth(&p->hpanel);
+	h = ST7796_Panel_GetLcdPixelHeight(&p->hpanel);
+	for (f = 0; f < BENCH_PANELFRAMES; f++) {
+		ST7796_Panel_FillRect(&p->hpanel, 0, 0, w, h, f);
+		ST7796_Panel_DrawRGBImage(&p->hpanel, 0, 0, w, h, benchimg);
+	}
+	return NULL;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw 1 .. PanelNum emulated panels at the same time (one thread /
+ *         panel) and print the wall time in CSV format
+ * @param  pOut:      output stream
+ * @param  PanelNum:  largest number of panels
+ * @param  NsPerByte: wire time of a byte
+ * @retval number of panels with a wrong GRAM content
+ */
+uint32_t ST7796_Bench_Panels(FILE *pOut, uint32_t PanelNum, uint32_t NsPerByte) {
+	BenchPanelTypeDef *pPanel = malloc(PanelNum * sizeof(BenchPanelTypeDef));
+	struct timespec t0, t1;
+	double ms, ms1 = 0;
+	uint32_t n, i, bad = 0, badall = 0;
+	if (pPanel == NULL)
+		return PanelNum;
+	benchrnd = 1;
+	for (i = 0; i < sizeof(benchimg) / sizeof(benchimg[0]); i++)
+		benchimg[i] = BenchRand();
+	fprintf(pOut, "panels,frames,wall_ms,frames_per_s,speedup,bad\n");
+	for (n = 1; n <= PanelNum; n++) {
+		for (i = 0; i < n; i++) {
+			ST7796_SimPanel_Reset(&pPanel[i].sim, NsPerByte);
+			pPanel[i].hpanel = (ST7796_PanelTypeDef) ST7796_PANEL_INIT(
+					&ST7796_SimPanelIo, &pPanel[i].sim);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (i = 0; i < n; i++)
+			pthread_create(&pPanel[i].thread, NULL, BenchPanelThread, &pPanel[i]);
+		for (i = 0; i < n; i++)
+			pthread_join(pPanel[i].thread, NULL);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		ms = (t1.tv_sec - t0.tv_sec) * 1000.0 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+		if (n == 1)
+			ms1 = ms;
+		/* every panel shows the same picture */
+		for (bad = 0, i = 1; i < n; i++)
+			if (memcmp(pPanel[i].sim.Gram, pPanel[0].sim.Gram,
+					sizeof(pPanel[0].sim.Gram)))
+				bad++;
+		badall += bad;
+		fprintf(pOut, "%u,%u,%.1f,%.1f,%.2f,%u\n", n, n * BENCH_PANELFRAMES, ms,
+				n * BENCH_PANELFRAMES * 1000.0 / ms, ms1 * n / ms, bad);
+	}
+	free(pPanel);
+	return badall;
+}
+
+#if defined(ST7796_BENCH_MAIN)
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[]) {
+	static ST7796_BenchResultTypeDef result[ST7796_BENCH_WORKLOADS];
+	ST7796_BenchBusTypeDef bus[3] = {
+		{ "spi", 40000000U, 1, 200 },
+		{ "p8", 20000000U, 8, 50 },
+		{ "p16", 20000000U, 16, 50 } };
+	uint32_t b, n, panels = 0, boot = 0;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "panels=", 7) == 0)
+			panels = strtoul(&argv[i][7], NULL, 0);
+		else if (strcmp(argv[i], "boot") == 0)
+			boot = 1;
+		for (b = 0; b < 3; b++) {
+			n = strlen(bus[b].Name);
+			if ((strncmp(argv[i], bus[b].Name, n) == 0) && (argv[i][n] == '='))
+				bus[b].ClockHz = strtoul(&argv[i][n + 1], NULL, 0);
+		}
+	}
+
+	if (boot) {
+		ST7796_Bench_Boot(stdout, bus, 3);
+		return 0;
+	}
+	if (panels)
+		return ST7796_Bench_Panels(stdout, panels, 8000000000U / bus[0].ClockHz) != 0;
+	n = ST7796_Bench_Run(result);
+	ST7796_Bench_Report(stdout, result, n, bus, 3);
+	return 0;
+}
+#endif /* #if defined(ST7796_BENCH_MAIN) */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
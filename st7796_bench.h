@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ * @file    st7796_bench.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 bus cost benchmark
+ *          (host build, runs on the st7796_sim panel emulator).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_BENCH_H
+#define ST7796_BENCH_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief  Bus timing model
+ *         clocks = transactions * 8 / min(BusWidth, 8) + data bytes * 8 / BusWidth
+ *         time   = clocks / ClockHz + transactions * CmdOverheadNs
+ */
+typedef struct {
+	const char *Name;              /* bus name in the report */
+	uint32_t ClockHz;              /* SPI SCK or 8080 WR strobe frequency */
+	uint8_t BusWidth;              /* 1: SPI, 8: 8080 8 bit, 16: 8080 16 bit */
+	uint32_t CmdOverheadNs;        /* CS / DC handling cost of a transaction */
+} ST7796_BenchBusTypeDef;
+
+/**
+ * @brief  Result of one workload
+ */
+typedef struct {
+	const char *Name;              /* workload name */
+	uint32_t Calls;                /* driver calls */
+	uint32_t Cmds;                 /* bus transactions (command bytes) */
+	uint32_t ParamBytes;           /* non pixel data bytes (CASET, RASET, MADCTL ...) */
+	uint32_t PixelBytes;           /* RAMWR / RAMRD data bytes */
+	uint32_t DummyBytes;           /* dummy read bytes */
+	uint32_t Pixels;               /* pixels written or read */
+} ST7796_BenchResultTypeDef;
+
+/* Number of workloads of the suite */
+#define ST7796_BENCH_WORKLOADS   20
+
+//-----------------------------------------------------------------------------
+uint32_t ST7796_Bench_Run(ST7796_BenchResultTypeDef *pResult);
+uint32_t ST7796_Bench_BusBytes(const ST7796_BenchResultTypeDef *pResult);
+uint32_t ST7796_Bench_TimeUs(const ST7796_BenchResultTypeDef *pResult,
+		const ST7796_BenchBusTypeDef *pBus);
+void ST7796_Bench_Report(FILE *pOut, const ST7796_BenchResultTypeDef *pResult,
+		uint32_t ResultNum, const ST7796_BenchBusTypeDef *pBus, uint32_t BusNum);
+uint32_t ST7796_Bench_Boot(FILE *pOut, const ST7796_BenchBusTypeDef *pBus,
+		uint32_t BusNum);
+uint32_t ST7796_Bench_Panels(FILE *pOut, uint32_t PanelNum, uint32_t NsPerByte);
+
+#endif /* ST7796_BENCH_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
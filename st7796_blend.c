@@ -0,0 +1,164 @@
+/**
+ ******************************************************************************
+ * @file    st7796_blend.c
+ * @author  MCD Application Team
+ * @brief   Alpha blended drawing for the st7796 driver. The background is
+ *          read back from the display memory in batches of rows (only two
+ *          interface pixel format changes / batch with the 16 bit write and
+ *          24 bit read bitdepth), blended with the st7796_conv kernels and
+ *          written back with the same window. With ST7796_BLEND_SHADOW the
+ *          blending works in the shadow buffer without readback.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_conv.h"
+#include "st7796_blend.h"
+#if ST7796_BLEND_SHADOW == 1
+#include "st7796_shadow.h"
+#endif
+
+static uint16_t *blendbuf;
+static uint32_t blendsize;
+
+//-----------------------------------------------------------------------------
+/* Clip a rectangle to the screen (0: nothing left) */
+static uint8_t BlendClip(uint16_t *pX, uint16_t *pY, uint16_t *pW,
+		uint16_t *pH) {
+	if ((*pX >= ST7796_SIZE_X) || (*pY >= ST7796_SIZE_Y) || (*pW == 0)
+			|| (*pH == 0))
+		return 0;
+	if (*pW > ST7796_SIZE_X - *pX)
+		*pW = ST7796_SIZE_X - *pX;
+	if (*pH > ST7796_SIZE_Y - *pY)
+		*pH = ST7796_SIZE_Y - *pY;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Blend the rows of one batch (pData: image pixels of the first row, NULL:
+   color fill) */
+static void BlendRows(uint16_t *pDst, uint32_t DstPitch, uint16_t Xsize,
+		uint16_t Ysize, const uint32_t *pData, uint32_t SrcPitch,
+		uint16_t RGBCode, uint8_t Alpha) {
+	if (pData == NULL && DstPitch == Xsize)
+		/* continuous rows: one kernel call */
+		ST7796_BlendColor(RGBCode, Alpha, pDst, (uint32_t) Xsize * Ysize);
+	else
+		while (Ysize--) {
+			if (pData) {
+				ST7796_BlendARGB8888(pData, pDst, Xsize);
+				pData += SrcPitch;
+			} else
+				ST7796_BlendColor(RGBCode, Alpha, pDst, Xsize);
+			pDst += DstPitch;
+		}
+}
+
+//-----------------------------------------------------------------------------
+/* Blend a clipped rectangle (pData: the image pixel at Xpos, Ypos) */
+static void BlendRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, const uint32_t *pData, uint32_t Pitch, uint16_t RGBCode,
+		uint8_t Alpha) {
+	uint32_t x, y, w, h;
+#if ST7796_BLEND_SHADOW == 1
+	uint16_t *p = ST7796_ShadowGetBuffer();
+	if (p) {
+		BlendRows(&p[Ypos * ST7796_SIZE_X + Xpos], ST7796_SIZE_X, Xsize, Ysize,
+				pData, Pitch, RGBCode, Alpha);
+		ST7796_ShadowMarkDirty(Xpos, Ypos, Xsize, Ysize);
+		return;
+	}
+#endif
+	/* no buffer: the stripes would be 0 pixels wide */
+	if ((blendbuf == NULL) || (blendsize == 0))
+		return;
+	ST7796_Sync();
+	/* column stripes only when one row does not fit into the buffer */
+	for (x = 0; x < Xsize; x += w) {
+		w = (Xsize - x > blendsize) ? blendsize : Xsize - x;
+		for (y = 0; y < Ysize; y += h) {
+			h = (Ysize - y > blendsize / w) ? blendsize / w : Ysize - y;
+			ST7796_ReadRGBImage(Xpos + x, Ypos + y, w, h, blendbuf);
+			BlendRows(blendbuf, w, w, h, pData ? pData + y * Pitch + x : NULL,
+					Pitch, RGBCode, Alpha);
+			/* the same window: no CASET / RASET */
+			ST7796_SetWriteWindow(Xpos + x, Ypos + y, w, h);
+			LCD_IO_DrawBitmap(blendbuf, (uint32_t) w * h);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the readback buffer
+ * @param  pBuffer: buffer
+ * @param  Size:    buffer size [pixel]
+ * @retval None
+ */
+void ST7796_BlendInit(uint16_t *pBuffer, uint32_t Size) {
+	blendbuf = pBuffer;
+	blendsize = Size;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw an ARGB8888 picture over the display content
+ * @param  Xpos:  Image X position in the LCD
+ * @param  Ypos:  Image Y position in the LCD
+ * @param  Xsize: Image X size in the LCD
+ * @param  Ysize: Image Y size in the LCD
+ * @param  pData: picture address (0xAARRGGBB pixels)
+ * @retval None
+ */
+void ST7796_BlendRGBAImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, const uint32_t *pData) {
+	uint16_t pitch = Xsize;
+	if (BlendClip(&Xpos, &Ypos, &Xsize, &Ysize))
+		BlendRect(Xpos, Ypos, Xsize, Ysize, pData, pitch, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a translucent filled rectangle
+ * @param  Xpos:    specifies the X position.
+ * @param  Ypos:    specifies the Y position.
+ * @param  Xsize:   specifies the X size
+ * @param  Ysize:   specifies the Y size
+ * @param  RGBCode: specifies the RGB color
+ * @param  Alpha:   0 (transparent) .. 255 (opaque)
+ * @retval None
+ */
+void ST7796_FillRectAlpha(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode, uint8_t Alpha) {
+	if (!BlendClip(&Xpos, &Ypos, &Xsize, &Ysize) || (Alpha < 4))
+		return; /* transparent (the blend weight is 0) */
+	if (Alpha >= 252) {
+		/* opaque: no readback */
+#if ST7796_BLEND_SHADOW == 1
+		if (ST7796_ShadowGetBuffer()) {
+			ST7796_ShadowFillRect(Xpos, Ypos, Xsize, Ysize, RGBCode);
+			return;
+		}
+#endif
+		ST7796_FillRect(Xpos, Ypos, Xsize, Ysize, RGBCode);
+	} else
+		BlendRect(Xpos, Ypos, Xsize, Ysize, NULL, 0, RGBCode, Alpha);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
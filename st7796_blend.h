@@ -0,0 +1,44 @@
+/**
+ ******************************************************************************
+ * @file    st7796_blend.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 alpha blended
+ *          drawing (translucent images and rectangles).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_BLEND_H
+#define ST7796_BLEND_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+/* Readback buffer: the background is read, blended and written back in
+   batches of whole rows fitting into the buffer (two interface pixel format
+   changes / batch), a row longer than the buffer is split into column
+   stripes. Not needed with ST7796_BLEND_SHADOW == 1 and a shadow buffer. */
+void ST7796_BlendInit(uint16_t *pBuffer, uint32_t Size);
+
+/* pData: Xsize * Ysize ARGB8888 pixels (0xAARRGGBB, alpha 255: opaque) */
+void ST7796_BlendRGBAImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, const uint32_t *pData);
+/* Alpha: 0 (transparent) .. 255 (opaque) */
+void ST7796_FillRectAlpha(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode, uint8_t Alpha);
+
+#endif /* ST7796_BLEND_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,281 @@
+/**
+ ******************************************************************************
+ * @file    st7796_bmp.c
+ * @author  MCD Application Team
+ * @brief   Streaming BMP decoder for the st7796 driver. The file is pulled
+ *          through a read callback, every row is decoded in place into an
+ *          RGB565 row buffer and sent to the GRAM. The drawing direction
+ *          follows the row order of the file (bottom-up: right then up,
+ *          top-down: right then down), so the rows are never reordered.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_bmp.h"
+
+/* widest visible row in any orientation */
+#define BMP_MAXWIDTH     ((ST7796_LCD_PIXEL_WIDTH > ST7796_LCD_PIXEL_HEIGHT) ? ST7796_LCD_PIXEL_WIDTH : ST7796_LCD_PIXEL_HEIGHT)
+
+#define BMP_RGB          0             /* biCompression: BI_RGB */
+#define BMP_BITFIELDS    3             /* biCompression: BI_BITFIELDS */
+#define BMP_MAXHEADER    124           /* BITMAPV5HEADER */
+
+#define BMP_RD16(p)      ((uint16_t)((p)[0] | ((p)[1] << 8)))
+#define BMP_RD32(p)      ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+static uint32_t bmprow[BMP_MAXWIDTH];  /* raw row (max. 32 bit / pixel), decoded in place */
+static uint32_t bmppal[256];           /* palette (0x00RRGGBB) */
+static ST7796_BmpReadCallback bmpread;
+static void *bmpparam;
+static uint16_t bmpbpp;
+static uint8_t bmp555;                 /* 16 bit file: 1 = RGB555, 0 = RGB565 */
+
+#if ST7796_BMP_DITHER == 1
+static const uint8_t bmpbayer[4][4] = {
+	{ 0, 8, 2, 10 },
+	{ 12, 4, 14, 6 },
+	{ 3, 11, 1, 9 },
+	{ 15, 7, 13, 5 } };
+#endif
+
+//-----------------------------------------------------------------------------
+/* RGB888 to RGB565 (the screen position selects the dither threshold) */
+static uint16_t BmpColor(uint8_t r, uint8_t g, uint8_t b, uint16_t Xpos,
+		uint16_t Ypos) {
+#if ST7796_BMP_DITHER == 1
+	uint8_t d = bmpbayer[Ypos & 3][Xpos & 3];
+	r = (r > 255 - (d >> 1)) ? 255 : r + (d >> 1);
+	g = (g > 255 - (d >> 2)) ? 255 : g + (d >> 2);
+	b = (b > 255 - (d >> 1)) ? 255 : b + (d >> 1);
+#else
+	(void) Xpos;
+	(void) Ypos;
+#endif
+	return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+//-----------------------------------------------------------------------------
+/* Read Size bytes from the stream (0: end of stream) */
+static uint8_t BmpRead(uint8_t *pData, uint32_t Size) {
+	return bmpread(bmpparam, pData, Size) == Size;
+}
+
+//-----------------------------------------------------------------------------
+/* Skip Size bytes of the stream (through the row buffer) */
+static uint8_t BmpSkip(uint32_t Size) {
+	uint32_t n;
+	while (Size) {
+		n = (Size > sizeof(bmprow)) ? sizeof(bmprow) : Size;
+		if (!BmpRead((uint8_t *) bmprow, n))
+			return 0;
+		Size -= n;
+	}
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Decode the first Xsize pixels of the row buffer into RGB565 (in place:
+   forward when the source pixel is not shorter than 16 bit, backward for the
+   palette indexes) */
+static void BmpDecodeRow(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize) {
+	uint8_t *s = (uint8_t *) bmprow;
+	uint16_t *d = (uint16_t *) bmprow;
+	uint16_t i, c;
+	uint32_t p;
+
+	switch (bmpbpp) {
+	case 32:
+		for (i = 0; i < Xsize; i++, s += 4)
+			d[i] = BmpColor(s[2], s[1], s[0], Xpos + i, Ypos);
+		break;
+	case 24:
+		for (i = 0; i < Xsize; i++, s += 3)
+			d[i] = BmpColor(s[2], s[1], s[0], Xpos + i, Ypos);
+		break;
+	case 16:
+		for (i = 0; i < Xsize; i++, s += 2) {
+			c = BMP_RD16(s);
+			if (bmp555)
+				c = ((c & 0x7FE0) << 1) | ((c & 0x0200) >> 4) | (c & 0x001F);
+			d[i] = c;
+		}
+		break;
+	default: /* 1, 4, 8 bit palette index */
+		for (i = Xsize; i-- > 0;) {
+			if (bmpbpp == 8)
+				p = s[i];
+			else if (bmpbpp == 4)
+				p = (s[i >> 1] >> ((~i & 1) << 2)) & 0x0F;
+			else
+				p = (s[i >> 3] >> (7 - (i & 7))) & 0x01;
+			p = bmppal[p];
+			d[i] = BmpColor(p >> 16, p >> 8, p, Xpos + i, Ypos);
+		}
+		break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a BMP file from a stream (see st7796_bmp.h)
+ * @param  Xpos:   Image X position in the LCD
+ * @param  Ypos:   Image Y position in the LCD
+ * @param  pRead:  read callback
+ * @param  pParam: read callback parameter
+ * @retval ST7796_BMP_OK, ST7796_BMP_ERROR_READ or ST7796_BMP_ERROR_FORMAT
+ * @brief  The image is clipped to the screen, the row order of the file
+ *         selects the drawing direction
+ */
+uint8_t ST7796_DrawBmpStream(uint16_t Xpos, uint16_t Ypos,
+		ST7796_BmpReadCallback pRead, void *pParam) {
+	uint8_t *h = (uint8_t *) bmprow;
+	uint32_t hsize, offbits, compression, colors, pos, pitch, rowbytes, i;
+	uint32_t rmask, gmask, bmask;
+	int32_t width, height;
+	uint16_t Xsize, Ysize;
+	uint8_t topdown;
+
+	bmpread = pRead;
+	bmpparam = pParam;
+
+	/* file header and the size of the info header */
+	if (!BmpRead(h, 18))
+		return ST7796_BMP_ERROR_READ;
+	if ((h[0] != 'B') || (h[1] != 'M'))
+		return ST7796_BMP_ERROR_FORMAT;
+	offbits = BMP_RD32(&h[10]);
+	hsize = BMP_RD32(&h[14]);
+	if ((hsize < 40) || (hsize > BMP_MAXHEADER))
+		return ST7796_BMP_ERROR_FORMAT;
+	if (!BmpRead(&h[18], hsize - 4))
+		return ST7796_BMP_ERROR_READ;
+	pos = 14 + hsize;
+
+	width = (int32_t) BMP_RD32(&h[18]);
+	height = (int32_t) BMP_RD32(&h[22]);
+	bmpbpp = BMP_RD16(&h[28]);
+	compression = BMP_RD32(&h[30]);
+	colors = BMP_RD32(&h[46]);
+	topdown = height < 0;
+	if (topdown)
+		height = -height;
+	if ((width <= 0) || (width > 0xFFFF) || (height <= 0) || (height > 0xFFFF)
+			|| (BMP_RD16(&h[26]) != 1))
+		return ST7796_BMP_ERROR_FORMAT;
+
+	/* pixel format */
+	bmp555 = 1;
+	if ((compression == BMP_BITFIELDS) && ((bmpbpp == 16) || (bmpbpp == 32))) {
+		/* the color masks follow a BITMAPINFOHEADER, newer headers contain them */
+		if (hsize == 40) {
+			if (!BmpRead(&h[54], 12))
+				return ST7796_BMP_ERROR_READ;
+			pos += 12;
+		} else if (hsize < 52)
+			return ST7796_BMP_ERROR_FORMAT;
+		rmask = BMP_RD32(&h[54]);
+		gmask = BMP_RD32(&h[58]);
+		bmask = BMP_RD32(&h[62]);
+		if ((bmpbpp == 16) && (rmask == 0xF800) && (gmask == 0x07E0)
+				&& (bmask == 0x001F))
+			bmp555 = 0;
+		else if (!(((bmpbpp == 16) && (rmask == 0x7C00) && (gmask == 0x03E0)
+				&& (bmask == 0x001F)) || ((bmpbpp == 32) && (rmask == 0xFF0000)
+				&& (gmask == 0x00FF00) && (bmask == 0x0000FF))))
+			return ST7796_BMP_ERROR_FORMAT;
+	} else if ((compression != BMP_RGB)
+			|| ((bmpbpp != 1) && (bmpbpp != 4) && (bmpbpp != 8) && (bmpbpp != 16)
+					&& (bmpbpp != 24) && (bmpbpp != 32)))
+		return ST7796_BMP_ERROR_FORMAT;
+
+	/* palette (BGRX entries) */
+	if (bmpbpp <= 8) {
+		if (colors == 0)
+			colors = 1UL << bmpbpp;
+		if (colors > 256)
+			return ST7796_BMP_ERROR_FORMAT;
+		if (!BmpRead(h, colors * 4))
+			return ST7796_BMP_ERROR_READ;
+		memset(bmppal, 0, sizeof(bmppal));
+		for (i = 0; i < colors; i++)
+			bmppal[i] = ((uint32_t) h[i * 4 + 2] << 16)
+					| ((uint32_t) h[i * 4 + 1] << 8) | h[i * 4];
+		pos += colors * 4;
+	}
+
+	/* pixel data: bfOffBits can only move forward, bfSize is not used */
+	if (offbits < pos)
+		return ST7796_BMP_ERROR_FORMAT;
+	if (!BmpSkip(offbits - pos))
+		return ST7796_BMP_ERROR_READ;
+
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y))
+		return ST7796_BMP_OK;
+	Xsize = ((uint32_t) width > ST7796_SIZE_X - Xpos) ?
+			ST7796_SIZE_X - Xpos : (uint16_t) width;
+	Ysize = ((uint32_t) height > ST7796_SIZE_Y - Ypos) ?
+			ST7796_SIZE_Y - Ypos : (uint16_t) height;
+	pitch = (((uint32_t) width * bmpbpp + 31) / 32) * 4;
+	rowbytes = ((uint32_t) Xsize * bmpbpp + 7) / 8;
+
+	ST7796_Sync();
+	if (topdown) {
+		ST7796_SetWriteWindow(Xpos, Ypos, Xsize, Ysize);
+	} else {
+		/* the first rows of a bottom-up file can be below the screen */
+		for (i = height; i > Ysize; i--)
+			if (!BmpSkip(pitch))
+				return ST7796_BMP_ERROR_READ;
+		ST7796_SetWriteWindowUp(Xpos, Ypos, Xsize, Ysize);
+	}
+
+	for (i = 0; i < Ysize; i++) {
+		if (!BmpRead((uint8_t *) bmprow, rowbytes))
+			return ST7796_BMP_ERROR_READ;
+		BmpDecodeRow(Xpos, topdown ? Ypos + i : Ypos + Ysize - 1 - i, Xsize);
+		if (i == 0) {
+			LCD_IO_DrawBitmap((uint16_t *) bmprow, Xsize);
+		} else {
+			LCD_IO_DrawBitmapCont((uint16_t *) bmprow, Xsize);
+		}
+		/* clipped columns and row padding */
+		if ((i + 1 < Ysize) && !BmpSkip(pitch - rowbytes))
+			return ST7796_BMP_ERROR_READ;
+	}
+	return ST7796_BMP_OK;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Read callback for a BMP file in the addressable memory
+ * @param  pParam: ST7796_BmpMemoryTypeDef (Pos = 0 before the first read)
+ * @param  pData:  destination
+ * @param  Size:   requested bytes
+ * @retval number of copied bytes (never reads behind Size of the file)
+ */
+uint32_t ST7796_BmpMemoryRead(void *pParam, uint8_t *pData, uint32_t Size) {
+	ST7796_BmpMemoryTypeDef *pMem = (ST7796_BmpMemoryTypeDef *) pParam;
+	if (Size > pMem->Size - pMem->Pos)
+		Size = pMem->Size - pMem->Pos;
+	memcpy(pData, &pMem->pData[pMem->Pos], Size);
+	pMem->Pos += Size;
+	return Size;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
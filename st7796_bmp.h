@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file    st7796_bmp.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 streaming BMP
+ *          decoder (BMP files from SD card, external flash or host files).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_BMP_H
+#define ST7796_BMP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Supported files: BITMAPINFOHEADER or newer header, 1/4/8 bit palette,
+   16 bit (RGB555 or RGB565 bitfields), 24 bit and 32 bit (BGRX) pixels,
+   bottom-up (positive height) or top-down (negative height) rows.
+   The file is read once from the start, only one row is held in RAM. */
+
+/* ST7796_DrawBmpStream return values */
+#define ST7796_BMP_OK             0
+#define ST7796_BMP_ERROR_READ     1    /* the stream ended (the read part is drawn) */
+#define ST7796_BMP_ERROR_FORMAT   2    /* not a BMP file or unsupported format */
+
+/* Read callback: copy the next Size bytes of the file to pData
+   (return value: number of copied bytes, less than Size at the end of file) */
+typedef uint32_t (*ST7796_BmpReadCallback)(void *pParam, uint8_t *pData,
+		uint32_t Size);
+
+/* Memory stream (ST7796_BmpMemoryRead parameter) */
+typedef struct {
+	const uint8_t *pData;
+	uint32_t Size;
+	uint32_t Pos;
+} ST7796_BmpMemoryTypeDef;
+
+//-----------------------------------------------------------------------------
+uint8_t ST7796_DrawBmpStream(uint16_t Xpos, uint16_t Ypos,
+		ST7796_BmpReadCallback pRead, void *pParam);
+uint32_t ST7796_BmpMemoryRead(void *pParam, uint8_t *pData, uint32_t Size);
+
+#endif /* ST7796_BMP_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
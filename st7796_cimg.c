@@ -0,0 +1,183 @@
+/**
+ ******************************************************************************
+ * @file    st7796_cimg.c
+ * @author  MCD Application Team
+ * @brief   Streaming decoder of the st7796 compressed image format. The image
+ *          is decoded in ST7796_CIMG_BUFFER sized chunks directly into the
+ *          display window, the long runs are sent as fills. With ST7796_ASYNC
+ *          the next chunk is decoded while the previous one is on the wire.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_cimg.h"
+#if ST7796_ASYNC == 1
+#include "st7796_async.h"
+#define CIMG_CHUNK       (ST7796_CIMG_BUFFER / 2)
+#else
+#define CIMG_CHUNK       ST7796_CIMG_BUFFER
+#endif
+
+static uint16_t cimgbuf[ST7796_CIMG_BUFFER];
+static uint16_t *cimgchunk;            /* chunk under decoding */
+static uint16_t cimgcnt;               /* decoded pixels in the chunk */
+#if ST7796_ASYNC == 1
+static volatile uint8_t cimgbusy[2];   /* 1: the chunk is queued or on the wire */
+static uint8_t cimgidx = 0;
+#else
+static uint8_t cimgfirst;              /* 1: the next transfer starts the window */
+#endif
+
+#if ST7796_ASYNC == 1
+//-----------------------------------------------------------------------------
+/* Queue the decoded pixels and continue in the other half of the buffer */
+static void CImgFlush(void) {
+	if (!cimgcnt)
+		return;
+	ST7796_AsyncWriteChunk(cimgchunk, cimgcnt, cimgbusy, cimgidx);
+	cimgidx ^= 1;
+	cimgchunk = &cimgbuf[cimgidx * CIMG_CHUNK];
+	cimgcnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+static void CImgFill(uint16_t Color, uint32_t Size) {
+	CImgFlush();
+	ST7796_WriteFillAsync(Color, Size, NULL, NULL);
+}
+
+#else /* #if ST7796_ASYNC == 1 */
+//-----------------------------------------------------------------------------
+/* Send the decoded pixels */
+static void CImgFlush(void) {
+	if (!cimgcnt)
+		return;
+	if (cimgfirst) {
+		LCD_IO_DrawBitmap(cimgchunk, cimgcnt);
+	} else {
+		LCD_IO_DrawBitmapCont(cimgchunk, cimgcnt);
+	}
+	cimgfirst = 0;
+	cimgcnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+static void CImgFill(uint16_t Color, uint32_t Size) {
+	CImgFlush();
+	if (cimgfirst) {
+		LCD_IO_DrawFill(Color, Size);
+	} else {
+		LCD_IO_DrawFillCont(Color, Size);
+	}
+	cimgfirst = 0;
+}
+#endif /* #else ST7796_ASYNC == 1 */
+
+//-----------------------------------------------------------------------------
+static void CImgPixel(uint16_t Color) {
+	cimgchunk[cimgcnt++] = Color;
+	if (cimgcnt >= CIMG_CHUNK)
+		CImgFlush();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw compressed image (see st7796_cimg.h)
+ * @param  Xpos:   Image X position in the LCD
+ * @param  Ypos:   Image Y position in the LCD
+ * @param  pImage: compressed image address
+ * @retval 0: OK, 1: bad image (the decoded part is drawn)
+ */
+uint8_t ST7796_DrawCompressedImage(uint16_t Xpos, uint16_t Ypos,
+		const uint8_t *pImage) {
+	uint16_t index[64] = { 0 };
+	uint16_t Xsize, Ysize, c = 0;
+	uint32_t left, n, i;
+	uint8_t op;
+
+	if ((pImage[0] != 'S') || (pImage[1] != '7') || (pImage[2] != 'C')
+			|| (pImage[3] != 'I'))
+		return 1;
+	Xsize = pImage[4] | (pImage[5] << 8);
+	Ysize = pImage[6] | (pImage[7] << 8);
+	if ((Xsize == 0) || (Ysize == 0))
+		return 0;
+	pImage += ST7796_CIMG_HEADER;
+	left = (uint32_t) Xsize * Ysize;
+
+	ST7796_Sync();
+#if ST7796_ASYNC == 1
+	ST7796_SetWriteWindowAsync(Xpos, Ypos, Xsize, Ysize);
+	cimgchunk = &cimgbuf[cimgidx * CIMG_CHUNK];
+#else
+	ST7796_SetWriteWindow(Xpos, Ypos, Xsize, Ysize);
+	cimgchunk = cimgbuf;
+	cimgfirst = 1;
+#endif
+	cimgcnt = 0;
+
+	while (left) {
+		op = *pImage++;
+		switch (op & ST7796_CIMG_OP_MASK) {
+		case ST7796_CIMG_OP_INDEX:
+			c = index[op];
+			n = 1;
+			CImgPixel(c);
+			break;
+		case ST7796_CIMG_OP_DIFF:
+			c = ((((c >> 11) + ((op >> 4) & 3) - 2) & 0x1F) << 11)
+					| ((((c >> 5) + ((op >> 2) & 3) - 2) & 0x3F) << 5)
+					| ((c + (op & 3) - 2) & 0x1F);
+			index[ST7796_CIMG_HASH(c)] = c;
+			n = 1;
+			CImgPixel(c);
+			break;
+		case ST7796_CIMG_OP_RUN:
+			n = (op & 0x3F) + 1;
+			if (n == ST7796_CIMG_RUN_EXT + 1) {
+				n = 64 + (pImage[0] | (pImage[1] << 8));
+				pImage += 2;
+			}
+			if (n > left)
+				break;
+			if (n >= ST7796_CIMG_MINFILL)
+				CImgFill(c, n);
+			else
+				for (i = 0; i < n; i++)
+					CImgPixel(c);
+			break;
+		default: /* ST7796_CIMG_OP_LITERAL */
+			n = (op & 0x3F) + 1;
+			if (n > left)
+				break;
+			for (i = 0; i < n; i++, pImage += 2) {
+				c = pImage[0] | (pImage[1] << 8);
+				index[ST7796_CIMG_HASH(c)] = c;
+				CImgPixel(c);
+			}
+			break;
+		}
+		if (n > left)
+			break;
+		left -= n;
+	}
+	CImgFlush();
+	return left != 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * @file    st7796_cimg.h
+ * @author  MCD Application Team
+ * @brief   This file contains the st7796 compressed image format and the
+ *          interface of the decoder / encoder.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_CIMG_H
+#define ST7796_CIMG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Compressed RGB565 image
+   header: "S7CI", width (uint16 LE), height (uint16 LE)
+   then the pixels (left to right, top to bottom) as a byte stream of ops:
+   - 00iiiiii: INDEX   1 pixel from the 64 entry color cache
+   - 01rrggbb: DIFF    1 pixel, previous pixel + (rr-2, gg-2, bb-2) in
+                       R5 / G6 / B5 units (wrapping)
+   - 10nnnnnn: RUN     n+1 pixels of the previous color (n < 63),
+                       n = 63: 64 + (next uint16 LE) pixels
+   - 11nnnnnn: LITERAL n+1 pixels follow as RGB565 uint16 LE
+   The previous pixel starts with 0x0000, every INDEX / DIFF / LITERAL pixel
+   is stored into the color cache at ST7796_CIMG_HASH. */
+#define ST7796_CIMG_HEADER        8
+#define ST7796_CIMG_OP_INDEX      0x00
+#define ST7796_CIMG_OP_DIFF       0x40
+#define ST7796_CIMG_OP_RUN        0x80
+#define ST7796_CIMG_OP_LITERAL    0xC0
+#define ST7796_CIMG_OP_MASK       0xC0
+#define ST7796_CIMG_RUN_EXT       0x3F
+#define ST7796_CIMG_RUN_MAX       (64 + 0xFFFF)
+#define ST7796_CIMG_HASH(c)       ((((c) >> 11) * 3 + (((c) >> 5) & 0x3F) * 5 + ((c) & 0x1F) * 7) & 0x3F)
+
+//-----------------------------------------------------------------------------
+/* Decoder (st7796_cimg.c) */
+uint8_t ST7796_DrawCompressedImage(uint16_t Xpos, uint16_t Ypos, const uint8_t *pImage);
+
+/* Encoder (st7796_cimg_enc.c, host tool) */
+uint32_t ST7796_CImgEncode(const uint16_t *pSrc, uint16_t Xsize, uint16_t Ysize,
+		uint8_t *pDst, uint32_t DstSize);
+
+#endif /* ST7796_CIMG_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,203 @@
+/**
+ ******************************************************************************
+ * @file    st7796_cimg_enc.c
+ * @author  MCD Application Team
+ * @brief   Encoder of the st7796 compressed image format (host tool).
+ *          Build with ST7796_CIMG_MAIN defined to get a command line tool
+ *          converting a 16 or 24 bit BMP file to a C array:
+ *          st7796_cimg_enc input.bmp name > name.c
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "st7796_cimg.h"
+
+typedef struct {
+	uint8_t *pDst;
+	uint32_t Size;                 /* pDst size */
+	uint32_t Pos;                  /* written bytes */
+	uint16_t Literal[64];          /* pending literal pixels */
+	uint8_t LiteralCnt;
+} CImgEncTypeDef;
+
+//-----------------------------------------------------------------------------
+static void CImgPut(CImgEncTypeDef *pEnc, uint8_t Data) {
+	if (pEnc->Pos < pEnc->Size)
+		pEnc->pDst[pEnc->Pos] = Data;
+	pEnc->Pos++;
+}
+
+//-----------------------------------------------------------------------------
+static void CImgPutLiteral(CImgEncTypeDef *pEnc) {
+	uint8_t i;
+	if (!pEnc->LiteralCnt)
+		return;
+	CImgPut(pEnc, ST7796_CIMG_OP_LITERAL | (pEnc->LiteralCnt - 1));
+	for (i = 0; i < pEnc->LiteralCnt; i++) {
+		CImgPut(pEnc, pEnc->Literal[i] & 0xFF);
+		CImgPut(pEnc, pEnc->Literal[i] >> 8);
+	}
+	pEnc->LiteralCnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+static void CImgPutRun(CImgEncTypeDef *pEnc, uint32_t Run) {
+	uint32_t n;
+	while (Run) {
+		n = (Run > ST7796_CIMG_RUN_MAX) ? ST7796_CIMG_RUN_MAX : Run;
+		if (n <= ST7796_CIMG_RUN_EXT)
+			CImgPut(pEnc, ST7796_CIMG_OP_RUN | (n - 1));
+		else {
+			CImgPut(pEnc, ST7796_CIMG_OP_RUN | ST7796_CIMG_RUN_EXT);
+			CImgPut(pEnc, (n - 64) & 0xFF);
+			CImgPut(pEnc, (n - 64) >> 8);
+		}
+		Run -= n;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Compress a RGB565 image
+ * @param  pSrc:    pixels (left to right, top to bottom)
+ * @param  Xsize:   image width
+ * @param  Ysize:   image height
+ * @param  pDst:    compressed image
+ * @param  DstSize: pDst size
+ * @retval compressed size (greater than DstSize: pDst is too small)
+ */
+uint32_t ST7796_CImgEncode(const uint16_t *pSrc, uint16_t Xsize, uint16_t Ysize,
+		uint8_t *pDst, uint32_t DstSize) {
+	CImgEncTypeDef enc = { pDst, DstSize, 0, { 0 }, 0 };
+	uint16_t index[64] = { 0 };
+	uint16_t prev = 0, c;
+	uint32_t i, run = 0, size = (uint32_t) Xsize * Ysize;
+	int8_t dr, dg, db;
+
+	CImgPut(&enc, 'S');
+	CImgPut(&enc, '7');
+	CImgPut(&enc, 'C');
+	CImgPut(&enc, 'I');
+	CImgPut(&enc, Xsize & 0xFF);
+	CImgPut(&enc, Xsize >> 8);
+	CImgPut(&enc, Ysize & 0xFF);
+	CImgPut(&enc, Ysize >> 8);
+
+	for (i = 0; i < size; i++) {
+		c = pSrc[i];
+		if (c == prev) {
+			run++;
+			continue;
+		}
+		if (run) {
+			CImgPutLiteral(&enc);
+			CImgPutRun(&enc, run);
+			run = 0;
+		}
+		dr = (int8_t) ((((c >> 11) - (prev >> 11)) + 2) & 0x1F) - 2;
+		dg = (int8_t) (((((c >> 5) & 0x3F) - ((prev >> 5) & 0x3F)) + 2) & 0x3F) - 2;
+		db = (int8_t) ((((c & 0x1F) - (prev & 0x1F)) + 2) & 0x1F) - 2;
+		if (index[ST7796_CIMG_HASH(c)] == c) {
+			CImgPutLiteral(&enc);
+			CImgPut(&enc, ST7796_CIMG_OP_INDEX | ST7796_CIMG_HASH(c));
+		} else if ((dr >= -2) && (dr <= 1) && (dg >= -2) && (dg <= 1)
+				&& (db >= -2) && (db <= 1)) {
+			CImgPutLiteral(&enc);
+			CImgPut(&enc, ST7796_CIMG_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2)
+					| (db + 2));
+		} else {
+			enc.Literal[enc.LiteralCnt++] = c;
+			if (enc.LiteralCnt == 64)
+				CImgPutLiteral(&enc);
+		}
+		index[ST7796_CIMG_HASH(c)] = c;
+		prev = c;
+	}
+	CImgPutLiteral(&enc);
+	CImgPutRun(&enc, run);
+	return enc.Pos;
+}
+
+#if defined(ST7796_CIMG_MAIN)
+//-----------------------------------------------------------------------------
+static uint32_t CImgLe(const uint8_t *p, uint8_t Size) {
+	uint32_t r = 0;
+	while (Size--)
+		r = (r << 8) | p[Size];
+	return r;
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[]) {
+	FILE *f;
+	uint8_t hdr[54], *pRow, *pDst;
+	uint16_t *pSrc;
+	int32_t w, h, x, y;
+	uint32_t bpp, pitch, size, i;
+
+	if (argc < 3) {
+		fprintf(stderr, "usage: %s input.bmp name > name.c\n", argv[0]);
+		return 1;
+	}
+	f = fopen(argv[1], "rb");
+	if (!f || (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr)) || (hdr[0] != 'B')
+			|| (hdr[1] != 'M')) {
+		fprintf(stderr, "%s: not a BMP file\n", argv[1]);
+		return 1;
+	}
+	w = (int32_t) CImgLe(&hdr[18], 4);
+	h = (int32_t) CImgLe(&hdr[22], 4);
+	bpp = CImgLe(&hdr[28], 2);
+	if (((bpp != 16) && (bpp != 24)) || (w <= 0) || (w > 0xFFFF) || (h == 0)
+			|| (h > 0xFFFF) || (h < -0xFFFF)) {
+		fprintf(stderr, "%s: only 16 (RGB565) and 24 bit BMP\n", argv[1]);
+		return 1;
+	}
+	pitch = (w * (bpp / 8) + 3) & ~3;
+	pRow = malloc(pitch);
+	pSrc = malloc((size_t) w * abs(h) * 2);
+	fseek(f, CImgLe(&hdr[10], 4), SEEK_SET);
+	for (y = 0; y < abs(h); y++) {
+		/* positive height: bottom-up rows */
+		uint16_t *pLine = &pSrc[(size_t) w * ((h > 0) ? h - 1 - y : y)];
+		if (fread(pRow, 1, pitch, f) != pitch) {
+			fprintf(stderr, "%s: truncated\n", argv[1]);
+			return 1;
+		}
+		for (x = 0; x < w; x++)
+			if (bpp == 16)
+				pLine[x] = pRow[x * 2] | (pRow[x * 2 + 1] << 8);
+			else
+				pLine[x] = ((pRow[x * 3 + 2] & 0xF8) << 8)
+						| ((pRow[x * 3 + 1] & 0xFC) << 3) | (pRow[x * 3] >> 3);
+	}
+	fclose(f);
+	h = abs(h);
+
+	size = ST7796_CImgEncode(pSrc, w, h, NULL, 0);
+	pDst = malloc(size);
+	ST7796_CImgEncode(pSrc, w, h, pDst, size);
+	printf("/* %s: %dx%d, %u bytes (RGB565: %u bytes) */\n", argv[1], (int) w,
+			(int) h, size, (uint32_t) (w * h * 2));
+	printf("const uint8_t %s[%u] = {", argv[2], size);
+	for (i = 0; i < size; i++)
+		printf("%s0x%02X,", (i % 16) ? " " : "\n  ", pDst[i]);
+	printf("\n};\n");
+	return 0;
+}
+#endif /* #if defined(ST7796_CIMG_MAIN) */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
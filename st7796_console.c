@@ -0,0 +1,265 @@
+/**
+ ******************************************************************************
+ * @file    st7796_console.c
+ * @author  MCD Application Team
+ * @brief   Text console for the st7796 driver. The console area between the
+ *          fixed header and footer is a circular buffer in the GRAM: a new
+ *          line is rendered into the rows that scroll in at the bottom and
+ *          the old lines are moved by ST7796_Scroll (one VSCRSADD write),
+ *          they are never redrawn.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_console.h"
+
+/* widest screen row in any orientation and the narrowest (5 pixel) font */
+#define CON_MAXWIDTH     ((ST7796_LCD_PIXEL_WIDTH > ST7796_LCD_PIXEL_HEIGHT) ? ST7796_LCD_PIXEL_WIDTH : ST7796_LCD_PIXEL_HEIGHT)
+#define CON_MAXCOLS      (CON_MAXWIDTH / 5)
+
+/* the gate lines (hardware scroll direction) are the screen rows */
+#define CON_HWSCROLL     (ST7796_SIZE_Y == ST7796_LCD_PIXEL_HEIGHT)
+
+static const ST7796_ConsoleFontTypeDef *confont = NULL;
+static uint16_t contextcolor, conbackcolor;
+static uint16_t contop, conbottom;     /* fixed areas [line] */
+static uint16_t conarea;               /* console area [line] */
+static uint16_t conscroll;             /* the screen row contop + r shows the
+                                          row contop + (r + conscroll) % conarea */
+static uint16_t conrow;                /* first row of the current line in the console area */
+static uint8_t connewline;             /* 1: the next character starts a new line */
+static uint16_t concols;               /* characters / line */
+static uint16_t conlen;                /* characters in the current line */
+static char conline[CON_MAXCOLS];
+static uint16_t conrowbuf[CON_MAXWIDTH];
+
+//-----------------------------------------------------------------------------
+/* Render one pixel row of a text into the row buffer (padded with the
+   background color up to Xsize) */
+static void ConRenderRow(const char *pText, uint16_t Len, uint16_t Xsize,
+		uint16_t Row) {
+	uint16_t bpr = (confont->Width + 7) / 8;
+	uint16_t i, b, x = 0;
+	const uint8_t *g;
+	uint32_t bits;
+	char c;
+	for (i = 0; (i < Len) && (x < Xsize); i++) {
+		c = pText[i];
+		if ((c < ' ') || (c > '~'))
+			c = ' ';
+		g = &confont->table[((c - ' ') * confont->Height + Row) * bpr];
+		for (bits = 0, b = 0; b < bpr; b++)
+			bits = (bits << 8) | g[b];
+		for (b = 0; (b < confont->Width) && (x < Xsize); b++, x++)
+			conrowbuf[x] = (bits & (1UL << (bpr * 8 - 1 - b))) ?
+					contextcolor : conbackcolor;
+	}
+	while (x < Xsize)
+		conrowbuf[x++] = conbackcolor;
+}
+
+//-----------------------------------------------------------------------------
+/* Draw a text line at a screen position. The rows are sent in windows that
+   do not cross the console area border and the GRAM wrap of the scroll. */
+static void ConDrawText(uint16_t Xpos, uint16_t Ypos, const char *pText,
+		uint16_t Len, uint16_t Xsize) {
+	uint16_t rows, row = 0, run, n, y;
+	uint8_t first;
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y) || (Xsize == 0))
+		return;
+	if (Xsize > ST7796_SIZE_X - Xpos)
+		Xsize = ST7796_SIZE_X - Xpos;
+	rows = confont->Height;
+	if (rows > ST7796_SIZE_Y - Ypos)
+		rows = ST7796_SIZE_Y - Ypos;
+
+	ST7796_Sync();
+	while (row < rows) {
+		y = Ypos + row;
+		run = rows - row;
+		if ((y >= contop) && (y < contop + conarea)) {
+			n = contop + conarea - y;
+			if (run > n)
+				run = n;
+			n = conarea - (y - contop + conscroll) % conarea;
+			if (run > n)
+				run = n;
+		} else if ((y < contop) && (run > contop - y))
+			run = contop - y;
+		ST7796_SetWriteWindow(Xpos, ST7796_ConsoleMapRow(y), Xsize, run);
+		for (first = 1; run; run--, row++, first = 0) {
+			ConRenderRow(pText, Len, Xsize, row);
+			if (first) {
+				LCD_IO_DrawBitmap(conrowbuf, Xsize);
+			} else {
+				LCD_IO_DrawBitmapCont(conrowbuf, Xsize);
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Draw the current line (full width: the old content of the rows is cleared) */
+static void ConDrawLine(void) {
+	ConDrawText(0, contop + conrow, conline, conlen, ST7796_SIZE_X);
+}
+
+//-----------------------------------------------------------------------------
+/* Step to the next line, scroll when it is not in the console area */
+static void ConNewLine(void) {
+	uint16_t h = confont->Height;
+	conlen = 0;
+	connewline = 0;
+	if (conrow + 2 * h <= conarea) {
+		conrow += h;
+	} else if (CON_HWSCROLL) {
+		/* the rows of the new line scroll in at the bottom */
+		conscroll = (conscroll + conrow + 2 * h - conarea) % conarea;
+		conrow = conarea - h;
+		ST7796_Scroll(conscroll, contop, conbottom);
+	} else
+		conrow = 0;
+	if (!CON_HWSCROLL) {
+		/* mark the newest line with an empty line after it */
+		if (conrow + 2 * h <= conarea)
+			ST7796_FillRect(0, contop + conrow + h, ST7796_SIZE_X, h, conbackcolor);
+		else
+			ST7796_FillRect(0, contop, ST7796_SIZE_X, h, conbackcolor);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Console init (the console area is cleared, the fixed areas are not)
+ * @param  TopFix:    header height [pixel]
+ * @param  BottomFix: footer height [pixel]
+ * @param  pFont:     font
+ * @param  TextColor: text color
+ * @param  BackColor: background color
+ * @retval None
+ */
+void ST7796_ConsoleInit(uint16_t TopFix, uint16_t BottomFix,
+		const ST7796_ConsoleFontTypeDef *pFont, uint16_t TextColor,
+		uint16_t BackColor) {
+	confont = pFont;
+	contextcolor = TextColor;
+	conbackcolor = BackColor;
+	contop = TopFix;
+	conbottom = BottomFix;
+	conarea = ST7796_SIZE_Y - TopFix - BottomFix;
+	concols = ST7796_SIZE_X / pFont->Width;
+	if (concols > CON_MAXCOLS)
+		concols = CON_MAXCOLS;
+	ST7796_ConsoleClear();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the color of the next characters
+ * @param  TextColor: text color
+ * @param  BackColor: background color
+ * @retval None
+ */
+void ST7796_ConsoleSetColor(uint16_t TextColor, uint16_t BackColor) {
+	contextcolor = TextColor;
+	conbackcolor = BackColor;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Clear the console area, the next line is the first line
+ * @param  None
+ * @retval None
+ */
+void ST7796_ConsoleClear(void) {
+	conscroll = 0;
+	conrow = 0;
+	conlen = 0;
+	connewline = 0;
+	if (CON_HWSCROLL)
+		ST7796_Scroll(0, contop, conbottom);
+	ST7796_FillRect(0, contop, ST7796_SIZE_X, conarea, conbackcolor);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Write text to the console
+ * @param  pText: text ('\n': new line, '\r': to the start of the line,
+ *                the long lines are wrapped)
+ * @retval None
+ * @brief  Only the changed line is drawn, once / call
+ */
+void ST7796_ConsolePuts(const char *pText) {
+	uint8_t dirty = 0;
+	if ((confont == NULL) || (conarea < confont->Height))
+		return;
+	for (; *pText; pText++) {
+		if (connewline) {
+			ConNewLine();
+			dirty = 1;
+		}
+		if (*pText == '\n') {
+			if (dirty)
+				ConDrawLine();
+			dirty = 0;
+			connewline = 1;
+		} else if (*pText == '\r') {
+			conlen = 0;
+			dirty = 1;
+		} else {
+			if (conlen >= concols) {
+				ConDrawLine();
+				ConNewLine();
+			}
+			conline[conlen++] = *pText;
+			dirty = 1;
+		}
+	}
+	if (dirty)
+		ConDrawLine();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw text at a screen position (not scrolled with the console)
+ * @param  Xpos:  specifies the X position.
+ * @param  Ypos:  specifies the Y position.
+ * @param  pText: text
+ * @retval None
+ */
+void ST7796_ConsoleDrawText(uint16_t Xpos, uint16_t Ypos, const char *pText) {
+	uint16_t len = strlen(pText);
+	if (confont == NULL)
+		return;
+	ConDrawText(Xpos, Ypos, pText, len, len * confont->Width);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Translate a screen row to the row of the drawing functions
+ * @param  Ypos: screen row
+ * @retval drawing row (the screen row in the fixed areas)
+ */
+uint16_t ST7796_ConsoleMapRow(uint16_t Ypos) {
+	if ((Ypos >= contop) && (Ypos < contop + conarea))
+		return contop + (Ypos - contop + conscroll) % conarea;
+	return Ypos;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
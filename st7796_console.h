@@ -0,0 +1,61 @@
+/**
+ ******************************************************************************
+ * @file    st7796_console.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 text console
+ *          (hardware scrolled log area between fixed header and footer).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_CONSOLE_H
+#define ST7796_CONSOLE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/**
+ * @brief  Monospace bitmap font (the layout of the STM32Cube BSP sFONT:
+ *         characters from ' ' to '~', Height rows / character, (Width + 7) / 8
+ *         bytes / row, the leftmost pixel is the MSB of the first byte)
+ */
+typedef struct {
+	const uint8_t *table;
+	uint16_t Width;
+	uint16_t Height;
+} ST7796_ConsoleFontTypeDef;
+
+//-----------------------------------------------------------------------------
+/* The lines between the TopFix and BottomFix areas are the console. A new
+   line is written only into the rows scrolled in at the bottom, the old
+   lines are moved by the vertical scroll start address (VSCRSADD).
+   The hardware scroll moves the gate lines, these are only vertical in the
+   portrait orientations (0, 2). In landscape orientation the console wraps
+   to its first line instead of scrolling (the line after the newest line is
+   cleared). */
+void ST7796_ConsoleInit(uint16_t TopFix, uint16_t BottomFix,
+		const ST7796_ConsoleFontTypeDef *pFont, uint16_t TextColor,
+		uint16_t BackColor);
+void ST7796_ConsoleSetColor(uint16_t TextColor, uint16_t BackColor);
+void ST7796_ConsoleClear(void);
+void ST7796_ConsolePuts(const char *pText);
+
+/* Text at a screen position (header, footer or console area: the scrolled
+   rows are translated to their GRAM rows) */
+void ST7796_ConsoleDrawText(uint16_t Xpos, uint16_t Ypos, const char *pText);
+uint16_t ST7796_ConsoleMapRow(uint16_t Ypos);
+
+#endif /* ST7796_CONSOLE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
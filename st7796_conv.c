@@ -0,0 +1,539 @@
+/**
+ ******************************************************************************
+ * @file    st7796_conv.c
+ * @author  MCD Application Team
+ * @brief   RGB565 <-> RGB888 block conversion kernels. The same results as
+ *          the per pixel reference, 16 pixels / iteration with SSSE3 or NEON,
+ *          4 pixels / iteration with 32 bit word loads and stores (Cortex-M).
+ *          Alpha blending kernels over RGB565 pixels: 8 (SSSE3) or 16 (NEON)
+ *          pixels / iteration, the 3 channels of one pixel in a 32 bit word.
+ *          Build with ST7796_CONV_MAIN defined to get a command line tool
+ *          checking the kernels against the reference and comparing the
+ *          throughput: st7796_conv [pixels]
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "st7796_conv.h"
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define CONV_R(c)        (((c) >> 8) & 0xF8)
+#define CONV_G(c)        (((c) >> 3) & 0xFC)
+#define CONV_B(c)        (((c) << 3) & 0xF8)
+#define CONV_565(r, g, b) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
+
+/* 8 bit alpha -> 0 .. 32 blend weight */
+#define CONV_ALPHA(a)    (((a) + 4) >> 3)
+/* RGB565 with the green channel moved to the upper half word (6 free bits
+   above every channel: room for the 5 bit weight products) */
+#define CONV_SPREAD(c)   (((c) | ((uint32_t) (c) << 16)) & 0x07E0F81F)
+
+//-----------------------------------------------------------------------------
+/* One channel: bg + (fg - bg) * a / 32 (rounded down) */
+static inline uint32_t ConvBlendChannel(int32_t Fg, int32_t Bg, int32_t A) {
+	return Bg + (((Fg - Bg) * A) >> 5);
+}
+
+//-----------------------------------------------------------------------------
+/* One pixel with the 3 channels in a 32 bit word (the same result as the
+   ConvBlendChannel, the borrow of a negative channel difference is cut off
+   by the mask) */
+static inline uint16_t ConvBlendWord(uint32_t Fg, uint16_t Bg, uint32_t A) {
+	uint32_t bg = CONV_SPREAD(Bg);
+	bg = ((((Fg - bg) * A) >> 5) + bg) & 0x07E0F81F;
+	return bg | (bg >> 16);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  RGB565 -> RGB888 bus bytes (per pixel reference)
+ * @param  pSrc: RGB565 pixels
+ * @param  pDst: 3 bytes / pixel
+ * @param  Size: number of pixels
+ * @retval None
+ */
+void ST7796_Conv16to24_Ref(const uint16_t *pSrc, uint8_t *pDst, uint32_t Size) {
+	while (Size--) {
+		*pDst++ = CONV_R(*pSrc);
+		*pDst++ = CONV_G(*pSrc);
+		*pDst++ = CONV_B(*pSrc);
+		pSrc++;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  RGB888 bus bytes -> RGB565 (per pixel reference)
+ * @param  pSrc: 3 bytes / pixel
+ * @param  pDst: RGB565 pixels
+ * @param  Size: number of pixels
+ * @retval None
+ */
+void ST7796_Conv24to16_Ref(const uint8_t *pSrc, uint16_t *pDst, uint32_t Size) {
+	while (Size--) {
+		*pDst++ = CONV_565(pSrc[0], pSrc[1], pSrc[2]);
+		pSrc += 3;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  ARGB8888 pixels over RGB565 pixels (per pixel reference)
+ * @param  pSrc: ARGB8888 pixels (0xAARRGGBB, alpha 255: opaque)
+ * @param  pDst: RGB565 background pixels, overwritten with the result
+ * @param  Size: number of pixels
+ * @retval None
+ */
+void ST7796_BlendARGB8888_Ref(const uint32_t *pSrc, uint16_t *pDst, uint32_t Size) {
+	uint32_t a, fg;
+	while (Size--) {
+		a = CONV_ALPHA(*pSrc >> 24);
+		fg = CONV_565(*pSrc >> 16, *pSrc >> 8, *pSrc & 0xFF);
+		*pDst = (ConvBlendChannel(fg >> 11, *pDst >> 11, a) << 11)
+				| (ConvBlendChannel((fg >> 5) & 0x3F, (*pDst >> 5) & 0x3F, a) << 5)
+				| ConvBlendChannel(fg & 0x1F, *pDst & 0x1F, a);
+		pSrc++;
+		pDst++;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  One RGB565 color over RGB565 pixels (per pixel reference)
+ * @param  Color: RGB565 color
+ * @param  Alpha: 0 (transparent) .. 255 (opaque)
+ * @param  pDst:  RGB565 background pixels, overwritten with the result
+ * @param  Size:  number of pixels
+ * @retval None
+ */
+void ST7796_BlendColor_Ref(uint16_t Color, uint8_t Alpha, uint16_t *pDst, uint32_t Size) {
+	uint32_t a = CONV_ALPHA(Alpha);
+	while (Size--) {
+		*pDst = (ConvBlendChannel(Color >> 11, *pDst >> 11, a) << 11)
+				| (ConvBlendChannel((Color >> 5) & 0x3F, (*pDst >> 5) & 0x3F, a) << 5)
+				| ConvBlendChannel(Color & 0x1F, *pDst & 0x1F, a);
+		pDst++;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  RGB565 -> RGB888 bus bytes
+ * @param  pSrc: RGB565 pixels
+ * @param  pDst: 3 bytes / pixel
+ * @param  Size: number of pixels
+ * @retval None
+ */
+void ST7796_Conv16to24(const uint16_t *pSrc, uint8_t *pDst, uint32_t Size) {
+	uint32_t a, b, p0, p1, p2, p3;
+#if defined(__SSSE3__)
+	const __m128i m8 = _mm_set1_epi16(0x00F8), m6 = _mm_set1_epi16(0x00FC);
+	const __m128i s00 = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5);
+	const __m128i s01 = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1);
+	const __m128i s02 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+	const __m128i s10 = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1);
+	const __m128i s11 = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10);
+	const __m128i s12 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1);
+	const __m128i s20 = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1);
+	const __m128i s21 = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1);
+	const __m128i s22 = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+	__m128i x0, x1, vr, vg, vb;
+	for (; Size >= 16; Size -= 16, pSrc += 16, pDst += 48) {
+		x0 = _mm_loadu_si128((const __m128i *) pSrc);
+		x1 = _mm_loadu_si128((const __m128i *) (pSrc + 8));
+		vr = _mm_packus_epi16(_mm_and_si128(_mm_srli_epi16(x0, 8), m8),
+				_mm_and_si128(_mm_srli_epi16(x1, 8), m8));
+		vg = _mm_packus_epi16(_mm_and_si128(_mm_srli_epi16(x0, 3), m6),
+				_mm_and_si128(_mm_srli_epi16(x1, 3), m6));
+		vb = _mm_packus_epi16(_mm_and_si128(_mm_slli_epi16(x0, 3), m8),
+				_mm_and_si128(_mm_slli_epi16(x1, 3), m8));
+		_mm_storeu_si128((__m128i *) pDst, _mm_or_si128(_mm_or_si128(
+				_mm_shuffle_epi8(vr, s00), _mm_shuffle_epi8(vg, s01)),
+				_mm_shuffle_epi8(vb, s02)));
+		_mm_storeu_si128((__m128i *) (pDst + 16), _mm_or_si128(_mm_or_si128(
+				_mm_shuffle_epi8(vr, s10), _mm_shuffle_epi8(vg, s11)),
+				_mm_shuffle_epi8(vb, s12)));
+		_mm_storeu_si128((__m128i *) (pDst + 32), _mm_or_si128(_mm_or_si128(
+				_mm_shuffle_epi8(vr, s20), _mm_shuffle_epi8(vg, s21)),
+				_mm_shuffle_epi8(vb, s22)));
+	}
+#elif defined(__ARM_NEON)
+	uint16x8_t p;
+	uint8x16x3_t v;
+	for (; Size >= 16; Size -= 16, pSrc += 16, pDst += 48) {
+		p = vld1q_u16(pSrc);
+		v.val[0] = vcombine_u8(vmovn_u16(vshrq_n_u16(p, 8)), vdup_n_u8(0));
+		v.val[1] = vcombine_u8(vmovn_u16(vshrq_n_u16(p, 3)), vdup_n_u8(0));
+		v.val[2] = vcombine_u8(vmovn_u16(vshlq_n_u16(p, 3)), vdup_n_u8(0));
+		p = vld1q_u16(pSrc + 8);
+		v.val[0] = vcombine_u8(vget_low_u8(v.val[0]), vmovn_u16(vshrq_n_u16(p, 8)));
+		v.val[1] = vcombine_u8(vget_low_u8(v.val[1]), vmovn_u16(vshrq_n_u16(p, 3)));
+		v.val[2] = vcombine_u8(vget_low_u8(v.val[2]), vmovn_u16(vshlq_n_u16(p, 3)));
+		v.val[0] = vandq_u8(v.val[0], vdupq_n_u8(0xF8));
+		v.val[1] = vandq_u8(v.val[1], vdupq_n_u8(0xFC));
+		v.val[2] = vandq_u8(v.val[2], vdupq_n_u8(0xF8));
+		vst3q_u8(pDst, v);
+	}
+#endif
+	/* 4 pixels: 2 words in, 3 words out (r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3) */
+	for (; Size >= 4; Size -= 4, pSrc += 4, pDst += 12) {
+		memcpy(&a, pSrc, 4);
+		memcpy(&b, pSrc + 2, 4);
+		p0 = a & 0xFFFF;
+		p1 = a >> 16;
+		p2 = b & 0xFFFF;
+		p3 = b >> 16;
+		a = ((p0 >> 8) & 0xF8) | ((p0 << 5) & 0xFC00) | ((p0 << 19) & 0xF80000)
+				| ((p1 << 16) & 0xF8000000);
+		memcpy(pDst, &a, 4);
+		a = ((p1 >> 3) & 0xFC) | ((p1 << 11) & 0xF800) | ((p2 << 8) & 0xF80000)
+				| ((p2 << 21) & 0xFC000000);
+		memcpy(pDst + 4, &a, 4);
+		a = ((p2 << 3) & 0xF8) | (p3 & 0xF800) | ((p3 << 13) & 0xFC0000)
+				| ((p3 << 27) & 0xF8000000);
+		memcpy(pDst + 8, &a, 4);
+	}
+	ST7796_Conv16to24_Ref(pSrc, pDst, Size);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  RGB888 bus bytes -> RGB565
+ * @param  pSrc: 3 bytes / pixel
+ * @param  pDst: RGB565 pixels
+ * @param  Size: number of pixels
+ * @retval None
+ */
+void ST7796_Conv24to16(const uint8_t *pSrc, uint16_t *pDst, uint32_t Size) {
+	uint32_t a, b, c, o;
+#if defined(__SSSE3__)
+	const __m128i z = _mm_setzero_si128();
+	const __m128i m8 = _mm_set1_epi8((char) 0xF8), m6 = _mm_set1_epi8((char) 0xFC);
+	const __m128i g00 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i g01 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+	const __m128i g02 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+	const __m128i g10 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i g11 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+	const __m128i g12 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+	const __m128i g20 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i g21 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+	const __m128i g22 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+	__m128i x0, x1, x2, vr, vg, vb;
+	for (; Size >= 16; Size -= 16, pSrc += 48, pDst += 16) {
+		x0 = _mm_loadu_si128((const __m128i *) pSrc);
+		x1 = _mm_loadu_si128((const __m128i *) (pSrc + 16));
+		x2 = _mm_loadu_si128((const __m128i *) (pSrc + 32));
+		vr = _mm_and_si128(_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(x0, g00),
+				_mm_shuffle_epi8(x1, g01)), _mm_shuffle_epi8(x2, g02)), m8);
+		vg = _mm_and_si128(_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(x0, g10),
+				_mm_shuffle_epi8(x1, g11)), _mm_shuffle_epi8(x2, g12)), m6);
+		vb = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(x0, g20),
+				_mm_shuffle_epi8(x1, g21)), _mm_shuffle_epi8(x2, g22));
+		/* R in the high byte, G << 3 and B >> 3 in 16 bit lanes */
+		_mm_storeu_si128((__m128i *) pDst, _mm_or_si128(_mm_or_si128(
+				_mm_unpacklo_epi8(z, vr),
+				_mm_slli_epi16(_mm_unpacklo_epi8(vg, z), 3)),
+				_mm_srli_epi16(_mm_unpacklo_epi8(vb, z), 3)));
+		_mm_storeu_si128((__m128i *) (pDst + 8), _mm_or_si128(_mm_or_si128(
+				_mm_unpackhi_epi8(z, vr),
+				_mm_slli_epi16(_mm_unpackhi_epi8(vg, z), 3)),
+				_mm_srli_epi16(_mm_unpackhi_epi8(vb, z), 3)));
+	}
+#elif defined(__ARM_NEON)
+	uint8x16x3_t v;
+	uint16x8_t p;
+	for (; Size >= 16; Size -= 16, pSrc += 48, pDst += 16) {
+		v = vld3q_u8(pSrc);
+		v.val[0] = vandq_u8(v.val[0], vdupq_n_u8(0xF8));
+		v.val[1] = vandq_u8(v.val[1], vdupq_n_u8(0xFC));
+		p = vorrq_u16(vorrq_u16(vshll_n_u8(vget_low_u8(v.val[0]), 8),
+				vshll_n_u8(vget_low_u8(v.val[1]), 3)),
+				vmovl_u8(vshr_n_u8(vget_low_u8(v.val[2]), 3)));
+		vst1q_u16(pDst, p);
+		p = vorrq_u16(vorrq_u16(vshll_n_u8(vget_high_u8(v.val[0]), 8),
+				vshll_n_u8(vget_high_u8(v.val[1]), 3)),
+				vmovl_u8(vshr_n_u8(vget_high_u8(v.val[2]), 3)));
+		vst1q_u16(pDst + 8, p);
+	}
+#endif
+	/* 4 pixels: 3 words in (r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3), 2 words out */
+	for (; Size >= 4; Size -= 4, pSrc += 12, pDst += 4) {
+		memcpy(&a, pSrc, 4);
+		memcpy(&b, pSrc + 4, 4);
+		memcpy(&c, pSrc + 8, 4);
+		o = ((a << 8) & 0xF800) | ((a >> 5) & 0x07E0) | ((a >> 19) & 0x1F)
+				| ((a & 0xF8000000) | ((b << 19) & 0x07E00000) | ((b << 5) & 0x1F0000));
+		memcpy(pDst, &o, 4);
+		o = ((b >> 8) & 0xF800) | ((b >> 21) & 0x07E0) | ((c >> 3) & 0x1F)
+				| ((c << 16) & 0xF8000000) | ((c << 3) & 0x07E00000) | ((c >> 11) & 0x1F0000);
+		memcpy(pDst + 2, &o, 4);
+	}
+	ST7796_Conv24to16_Ref(pSrc, pDst, Size);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  ARGB8888 pixels over RGB565 pixels
+ * @param  pSrc: ARGB8888 pixels (0xAARRGGBB, alpha 255: opaque)
+ * @param  pDst: RGB565 background pixels, overwritten with the result
+ * @param  Size: number of pixels
+ * @retval None
+ */
+void ST7796_BlendARGB8888(const uint32_t *pSrc, uint16_t *pDst, uint32_t Size) {
+	uint32_t a;
+#if defined(__SSSE3__)
+	const __m128i m5 = _mm_set1_epi16(0x1F), m6 = _mm_set1_epi16(0x3F);
+	const __m128i k5 = _mm_set1_epi32(0x1F), k6 = _mm_set1_epi32(0x3F);
+	const __m128i r4 = _mm_set1_epi16(4);
+	__m128i x0, x1, fr, fg, fb, va, br, bg, bb, d;
+	for (; Size >= 8; Size -= 8, pSrc += 8, pDst += 8) {
+		x0 = _mm_loadu_si128((const __m128i *) pSrc);
+		x1 = _mm_loadu_si128((const __m128i *) (pSrc + 4));
+		/* channels of the 8 pixels in 16 bit lanes */
+		fr = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(x0, 19), k5),
+				_mm_and_si128(_mm_srli_epi32(x1, 19), k5));
+		fg = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(x0, 10), k6),
+				_mm_and_si128(_mm_srli_epi32(x1, 10), k6));
+		fb = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(x0, 3), k5),
+				_mm_and_si128(_mm_srli_epi32(x1, 3), k5));
+		va = _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(_mm_srli_epi32(x0, 24),
+				_mm_srli_epi32(x1, 24)), r4), 3);
+		d = _mm_loadu_si128((const __m128i *) pDst);
+		br = _mm_srli_epi16(d, 11);
+		bg = _mm_and_si128(_mm_srli_epi16(d, 5), m6);
+		bb = _mm_and_si128(d, m5);
+		/* bg + (fg - bg) * a >> 5 (the arithmetic shift rounds down) */
+		br = _mm_add_epi16(br, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fr, br), va), 5));
+		bg = _mm_add_epi16(bg, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fg, bg), va), 5));
+		bb = _mm_add_epi16(bb, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fb, bb), va), 5));
+		_mm_storeu_si128((__m128i *) pDst, _mm_or_si128(_mm_or_si128(
+				_mm_slli_epi16(br, 11), _mm_slli_epi16(bg, 5)), bb));
+	}
+#elif defined(__ARM_NEON)
+	uint8x16x4_t v;
+	uint16x8_t d;
+	int16x8_t fr, fg, fb, va, br, bg, bb;
+	uint32_t h;
+	for (; Size >= 16; Size -= 16, pSrc += 16, pDst += 16) {
+		/* little endian 0xAARRGGBB: B, G, R, A planes */
+		v = vld4q_u8((const uint8_t *) pSrc);
+		for (h = 0; h < 2; h++) {
+			uint8x8_t b8 = h ? vget_high_u8(v.val[0]) : vget_low_u8(v.val[0]);
+			uint8x8_t g8 = h ? vget_high_u8(v.val[1]) : vget_low_u8(v.val[1]);
+			uint8x8_t r8 = h ? vget_high_u8(v.val[2]) : vget_low_u8(v.val[2]);
+			uint8x8_t a8 = h ? vget_high_u8(v.val[3]) : vget_low_u8(v.val[3]);
+			fr = vreinterpretq_s16_u16(vmovl_u8(vshr_n_u8(r8, 3)));
+			fg = vreinterpretq_s16_u16(vmovl_u8(vshr_n_u8(g8, 2)));
+			fb = vreinterpretq_s16_u16(vmovl_u8(vshr_n_u8(b8, 3)));
+			va = vreinterpretq_s16_u16(vshrq_n_u16(vaddw_u8(vdupq_n_u16(4), a8), 3));
+			d = vld1q_u16(pDst + 8 * h);
+			br = vreinterpretq_s16_u16(vshrq_n_u16(d, 11));
+			bg = vreinterpretq_s16_u16(vandq_u16(vshrq_n_u16(d, 5), vdupq_n_u16(0x3F)));
+			bb = vreinterpretq_s16_u16(vandq_u16(d, vdupq_n_u16(0x1F)));
+			br = vaddq_s16(br, vshrq_n_s16(vmulq_s16(vsubq_s16(fr, br), va), 5));
+			bg = vaddq_s16(bg, vshrq_n_s16(vmulq_s16(vsubq_s16(fg, bg), va), 5));
+			bb = vaddq_s16(bb, vshrq_n_s16(vmulq_s16(vsubq_s16(fb, bb), va), 5));
+			vst1q_u16(pDst + 8 * h, vorrq_u16(vorrq_u16(
+					vshlq_n_u16(vreinterpretq_u16_s16(br), 11),
+					vshlq_n_u16(vreinterpretq_u16_s16(bg), 5)),
+					vreinterpretq_u16_s16(bb)));
+		}
+	}
+#endif
+	for (; Size; Size--, pSrc++, pDst++) {
+		a = CONV_ALPHA(*pSrc >> 24);
+		if (a == 32)
+			*pDst = CONV_565(*pSrc >> 16, *pSrc >> 8, *pSrc & 0xFF);
+		else if (a)
+			*pDst = ConvBlendWord(CONV_SPREAD(CONV_565(*pSrc >> 16, *pSrc >> 8,
+					*pSrc & 0xFF)), *pDst, a);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  One RGB565 color over RGB565 pixels
+ * @param  Color: RGB565 color
+ * @param  Alpha: 0 (transparent) .. 255 (opaque)
+ * @param  pDst:  RGB565 background pixels, overwritten with the result
+ * @param  Size:  number of pixels
+ * @retval None
+ */
+void ST7796_BlendColor(uint16_t Color, uint8_t Alpha, uint16_t *pDst, uint32_t Size) {
+	uint32_t a = CONV_ALPHA(Alpha), fg = CONV_SPREAD(Color);
+#if defined(__SSSE3__)
+	const __m128i m5 = _mm_set1_epi16(0x1F), m6 = _mm_set1_epi16(0x3F);
+	const __m128i va = _mm_set1_epi16(a);
+	const __m128i fr = _mm_set1_epi16(Color >> 11);
+	const __m128i fgr = _mm_set1_epi16((Color >> 5) & 0x3F);
+	const __m128i fb = _mm_set1_epi16(Color & 0x1F);
+	__m128i br, bg, bb, d;
+	for (; Size >= 8; Size -= 8, pDst += 8) {
+		d = _mm_loadu_si128((const __m128i *) pDst);
+		br = _mm_srli_epi16(d, 11);
+		bg = _mm_and_si128(_mm_srli_epi16(d, 5), m6);
+		bb = _mm_and_si128(d, m5);
+		br = _mm_add_epi16(br, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fr, br), va), 5));
+		bg = _mm_add_epi16(bg, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fgr, bg), va), 5));
+		bb = _mm_add_epi16(bb, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fb, bb), va), 5));
+		_mm_storeu_si128((__m128i *) pDst, _mm_or_si128(_mm_or_si128(
+				_mm_slli_epi16(br, 11), _mm_slli_epi16(bg, 5)), bb));
+	}
+#elif defined(__ARM_NEON)
+	const int16x8_t va = vdupq_n_s16(a);
+	const int16x8_t fr = vdupq_n_s16(Color >> 11);
+	const int16x8_t fgr = vdupq_n_s16((Color >> 5) & 0x3F);
+	const int16x8_t fb = vdupq_n_s16(Color & 0x1F);
+	int16x8_t br, bg, bb;
+	uint16x8_t d;
+	for (; Size >= 8; Size -= 8, pDst += 8) {
+		d = vld1q_u16(pDst);
+		br = vreinterpretq_s16_u16(vshrq_n_u16(d, 11));
+		bg = vreinterpretq_s16_u16(vandq_u16(vshrq_n_u16(d, 5), vdupq_n_u16(0x3F)));
+		bb = vreinterpretq_s16_u16(vandq_u16(d, vdupq_n_u16(0x1F)));
+		br = vaddq_s16(br, vshrq_n_s16(vmulq_s16(vsubq_s16(fr, br), va), 5));
+		bg = vaddq_s16(bg, vshrq_n_s16(vmulq_s16(vsubq_s16(fgr, bg), va), 5));
+		bb = vaddq_s16(bb, vshrq_n_s16(vmulq_s16(vsubq_s16(fb, bb), va), 5));
+		vst1q_u16(pDst, vorrq_u16(vorrq_u16(
+				vshlq_n_u16(vreinterpretq_u16_s16(br), 11),
+				vshlq_n_u16(vreinterpretq_u16_s16(bg), 5)),
+				vreinterpretq_u16_s16(bb)));
+	}
+#endif
+	for (; Size; Size--, pDst++)
+		*pDst = ConvBlendWord(fg, *pDst, a);
+}
+
+#if defined(ST7796_CONV_MAIN)
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//-----------------------------------------------------------------------------
+static double ConvSeconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[]) {
+	uint32_t size = (argc > 1) ? strtoul(argv[1], NULL, 0) : 320 * 480;
+	uint32_t i, n, err = 0, rounds = 200;
+	uint16_t *p16 = malloc((size + 65536) * 2), *q16 = malloc((size + 65536) * 2);
+	uint8_t *p24 = malloc((size + 65536) * 3), *q24 = malloc((size + 65536) * 3);
+	uint32_t *p32 = malloc((size + 65536) * 4);
+	double t;
+
+	/* bit exactness: every RGB565 code, random bytes, every length / offset */
+	for (i = 0; i < 65536; i++)
+		p16[i] = i;
+	ST7796_Conv16to24_Ref(p16, p24, 65536);
+	ST7796_Conv16to24(p16, q24, 65536);
+	err += memcmp(p24, q24, 65536 * 3) != 0;
+	for (i = 0; i < 65536 * 3; i++)
+		p24[i] = rand();
+	ST7796_Conv24to16_Ref(p24, p16, 65536);
+	ST7796_Conv24to16(p24, q16, 65536);
+	err += memcmp(p16, q16, 65536 * 2) != 0;
+	for (n = 0; n < 64; n++)
+		for (i = 0; i < 4; i++) {
+			memset(q24, 0x55, 64 * 3 + 3);
+			memset(q16, 0x55, 64 * 2 + 2);
+			ST7796_Conv16to24_Ref(p16 + i, p24, n);
+			ST7796_Conv16to24(p16 + i, q24 + i, n);
+			err += memcmp(p24, q24 + i, n * 3) || (q24[i + n * 3] != 0x55);
+			ST7796_Conv24to16_Ref(p24 + i, p16 + 1, n);
+			ST7796_Conv24to16(p24 + i, q16 + 1, n);
+			err += memcmp(p16 + 1, q16 + 1, n * 2) || (q16[1 + n] != 0x5555);
+		}
+	/* blending: random foreground, background and alpha, every length / offset */
+	for (i = 0; i < 65536; i++) {
+		p32[i] = ((uint32_t) rand() << 16) ^ rand();
+		p16[i] = rand();
+	}
+	memcpy(q16, p16, 65536 * 2);
+	ST7796_BlendARGB8888_Ref(p32, p16, 65536);
+	ST7796_BlendARGB8888(p32, q16, 65536);
+	err += memcmp(p16, q16, 65536 * 2) != 0;
+	for (i = 0; i < 256; i++) {
+		ST7796_BlendColor_Ref(i * 0x0101, i, p16, 256);
+		ST7796_BlendColor(i * 0x0101, i, q16, 256);
+	}
+	err += memcmp(p16, q16, 256 * 2) != 0;
+	for (n = 0; n < 40; n++)
+		for (i = 0; i < 4; i++) {
+			memcpy(q16 + 1, p16 + 1, n * 2 + 2);
+			ST7796_BlendARGB8888_Ref(p32 + i, p16 + 1, n);
+			ST7796_BlendARGB8888(p32 + i, q16 + 1, n);
+			err += memcmp(p16 + 1, q16 + 1, n * 2 + 2) != 0;
+			ST7796_BlendColor_Ref(p16[n], n * 6, p16 + 1, n);
+			ST7796_BlendColor(p16[n], n * 6, q16 + 1, n);
+			err += memcmp(p16 + 1, q16 + 1, n * 2 + 2) != 0;
+		}
+	printf("bit exactness: %s\n", err ? "FAILED" : "OK");
+
+	printf("kernel,pixels,ref_mpix_s,block_mpix_s\n");
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_Conv16to24_Ref(p16, p24, size);
+	t = ConvSeconds() - t;
+	printf("16to24,%u,%.1f,", size, (double) size * rounds / t / 1e6);
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_Conv16to24(p16, p24, size);
+	t = ConvSeconds() - t;
+	printf("%.1f\n", (double) size * rounds / t / 1e6);
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_Conv24to16_Ref(p24, p16, size);
+	t = ConvSeconds() - t;
+	printf("24to16,%u,%.1f,", size, (double) size * rounds / t / 1e6);
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_Conv24to16(p24, p16, size);
+	t = ConvSeconds() - t;
+	printf("%.1f\n", (double) size * rounds / t / 1e6);
+	for (i = 0; i < size; i++)
+		p32[i] = ((uint32_t) rand() << 16) ^ rand();
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_BlendARGB8888_Ref(p32, p16, size);
+	t = ConvSeconds() - t;
+	printf("blendargb,%u,%.1f,", size, (double) size * rounds / t / 1e6);
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_BlendARGB8888(p32, p16, size);
+	t = ConvSeconds() - t;
+	printf("%.1f\n", (double) size * rounds / t / 1e6);
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_BlendColor_Ref(0xF81F, 128, p16, size);
+	t = ConvSeconds() - t;
+	printf("blendcolor,%u,%.1f,", size, (double) size * rounds / t / 1e6);
+	t = ConvSeconds();
+	for (i = 0; i < rounds; i++)
+		ST7796_BlendColor(0xF81F, 128, p16, size);
+	t = ConvSeconds() - t;
+	printf("%.1f\n", (double) size * rounds / t / 1e6);
+	return err != 0;
+}
+#endif /* #if defined(ST7796_CONV_MAIN) */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file    st7796_conv.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 RGB565 <-> RGB888
+ *          block conversion kernels (for the 24 bit LCD_IO_* functions)
+ *          and the RGB565 alpha blending kernels.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_CONV_H
+#define ST7796_CONV_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Bus byte order of a 24 bit pixel: R, G, B (the low bits of the 888 bytes
+   are 0 when written, ignored when read) */
+
+//-----------------------------------------------------------------------------
+/* Block kernels (SSSE3 / NEON / 32 bit word, selected at compile time) */
+void ST7796_Conv16to24(const uint16_t *pSrc, uint8_t *pDst, uint32_t Size);
+void ST7796_Conv24to16(const uint8_t *pSrc, uint16_t *pDst, uint32_t Size);
+
+/* Per pixel reference */
+void ST7796_Conv16to24_Ref(const uint16_t *pSrc, uint8_t *pDst, uint32_t Size);
+void ST7796_Conv24to16_Ref(const uint8_t *pSrc, uint16_t *pDst, uint32_t Size);
+
+//-----------------------------------------------------------------------------
+/* Alpha blending in place over RGB565 pixels: every channel is
+   bg + (fg - bg) * ((alpha + 4) >> 3) / 32, rounded down (alpha 0: the
+   background, 255: the foreground) */
+void ST7796_BlendARGB8888(const uint32_t *pSrc, uint16_t *pDst, uint32_t Size);
+void ST7796_BlendColor(uint16_t Color, uint8_t Alpha, uint16_t *pDst, uint32_t Size);
+
+/* Per pixel reference */
+void ST7796_BlendARGB8888_Ref(const uint32_t *pSrc, uint16_t *pDst, uint32_t Size);
+void ST7796_BlendColor_Ref(uint16_t Color, uint8_t Alpha, uint16_t *pDst, uint32_t Size);
+
+#endif /* ST7796_CONV_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
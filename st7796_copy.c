@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ * @file    st7796_copy.c
+ * @author  MCD Application Team
+ * @brief   Display memory rectangle copy for the st7796 driver. The panel has
+ *          no copy command: the source is read back in row batches (24 bit
+ *          reads are converted to RGB565 by the st7796_conv kernels) and
+ *          written to the destination. The order of the batches follows the
+ *          direction of the move, so an overlapping source is always read
+ *          before it is overwritten.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_copy.h"
+
+static uint16_t *copybuf;
+static uint32_t copysize;
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the copy buffer
+ * @param  pBuffer: buffer
+ * @param  Size:    buffer size [pixel]
+ * @retval None
+ */
+void ST7796_CopyInit(uint16_t *pBuffer, uint32_t Size) {
+	copybuf = pBuffer;
+	copysize = Size;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Copy a rectangle of the display memory
+ * @param  Xsrc:  source X position
+ * @param  Ysrc:  source Y position
+ * @param  Xdst:  destination X position
+ * @param  Ydst:  destination Y position
+ * @param  Xsize: specifies the X size
+ * @param  Ysize: specifies the Y size
+ * @retval None
+ */
+void ST7796_CopyRect(uint16_t Xsrc, uint16_t Ysrc, uint16_t Xdst, uint16_t Ydst,
+		uint16_t Xsize, uint16_t Ysize) {
+	uint32_t i, j, x, y, w, h;
+	/* clip to the screen (both rectangles) */
+	if ((Xsrc >= ST7796_SIZE_X) || (Ysrc >= ST7796_SIZE_Y)
+			|| (Xdst >= ST7796_SIZE_X) || (Ydst >= ST7796_SIZE_Y)
+			|| ((Xsrc == Xdst) && (Ysrc == Ydst)) || (copybuf == NULL)
+			|| (copysize == 0))
+		return;
+	if (Xsize > ST7796_SIZE_X - ((Xsrc > Xdst) ? Xsrc : Xdst))
+		Xsize = ST7796_SIZE_X - ((Xsrc > Xdst) ? Xsrc : Xdst);
+	if (Ysize > ST7796_SIZE_Y - ((Ysrc > Ydst) ? Ysrc : Ydst))
+		Ysize = ST7796_SIZE_Y - ((Ysrc > Ydst) ? Ysrc : Ydst);
+
+	ST7796_Sync();
+	/* moving right: stripes from the right, moving down: batches from the
+	   bottom (a batch is read completely before it is written) */
+	for (i = 0; i < Xsize; i += w) {
+		w = (Xsize - i > copysize) ? copysize : Xsize - i;
+		x = (Xdst > Xsrc) ? Xsize - i - w : i;
+		for (j = 0; j < Ysize; j += h) {
+			h = (Ysize - j > copysize / w) ? copysize / w : Ysize - j;
+			y = (Ydst > Ysrc) ? Ysize - j - h : j;
+			ST7796_ReadRGBImage(Xsrc + x, Ysrc + y, w, h, copybuf);
+			ST7796_SetWriteWindow(Xdst + x, Ydst + y, w, h);
+			LCD_IO_DrawBitmap(copybuf, w * h);
+		}
+	}
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
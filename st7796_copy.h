@@ -0,0 +1,40 @@
+/**
+ ******************************************************************************
+ * @file    st7796_copy.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 display memory
+ *          rectangle copy (moving on screen content without redrawing).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_COPY_H
+#define ST7796_COPY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+/* Copy buffer: the rectangle is read and written back in batches of whole
+   rows fitting into the buffer, a row longer than the buffer is split into
+   column stripes (a larger buffer: fewer interface pixel format changes) */
+void ST7796_CopyInit(uint16_t *pBuffer, uint32_t Size);
+
+/* The source and the destination can overlap */
+void ST7796_CopyRect(uint16_t Xsrc, uint16_t Ysrc, uint16_t Xdst, uint16_t Ydst,
+		uint16_t Xsize, uint16_t Ysize);
+
+#endif /* ST7796_COPY_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
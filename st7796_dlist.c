@@ -0,0 +1,234 @@
+/**
+ ******************************************************************************
+ * @file    st7796_dlist.c
+ * @author  MCD Application Team
+ * @brief   Display list for the st7796 driver. The drawing primitives are
+ *          recorded and sent on flush, after the list has been optimized:
+ *          - primitives fully covered by a later opaque primitive are dropped
+ *          - same color fills are merged when they form a rectangle
+ *          - non overlapping primitives are ordered by MADCTL direction and
+ *            position, so the MADCTL and window caches hit more often
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_dlist.h"
+
+typedef struct {
+	uint8_t Type;                  /* ST7796_DL_FILL or ST7796_DL_IMAGE */
+	uint8_t Dir;                   /* MADCTL drawing direction */
+	uint16_t X, Y, W, H;
+	uint16_t Color;
+	uint16_t *pData;
+} DListEntry;
+
+static DListEntry dlist[ST7796_DLIST_SIZE];
+static uint16_t dlistcnt = 0;
+static uint8_t dlistrec = 0;
+static uint8_t dlistflush = 0;
+
+//-----------------------------------------------------------------------------
+/* Overlap of two entries */
+static uint8_t DListOverlap(const DListEntry *a, const DListEntry *b) {
+	return (a->X < b->X + b->W) && (b->X < a->X + a->W) && (a->Y < b->Y + b->H)
+			&& (b->Y < a->Y + a->H);
+}
+
+//-----------------------------------------------------------------------------
+/* a fully covers b */
+static uint8_t DListCovers(const DListEntry *a, const DListEntry *b) {
+	return (a->X <= b->X) && (a->X + a->W >= b->X + b->W) && (a->Y <= b->Y)
+			&& (a->Y + a->H >= b->Y + b->H);
+}
+
+//-----------------------------------------------------------------------------
+/* Merge b into a when both are same color fills and their union is a
+   rectangle (0: not mergeable) */
+static uint8_t DListMerge(DListEntry *a, const DListEntry *b) {
+	uint16_t e;
+	if ((a->Type != ST7796_DL_FILL) || (b->Type != ST7796_DL_FILL)
+			|| (a->Color != b->Color))
+		return 0;
+	if (DListCovers(a, b))
+		return 1;
+	if ((a->Y == b->Y) && (a->H == b->H) && (a->X <= b->X + b->W)
+			&& (b->X <= a->X + a->W)) {
+		e = (a->X + a->W > b->X + b->W) ? a->X + a->W : b->X + b->W;
+		a->X = (a->X < b->X) ? a->X : b->X;
+		a->W = e - a->X;
+		return 1;
+	}
+	if ((a->X == b->X) && (a->W == b->W) && (a->Y <= b->Y + b->H)
+			&& (b->Y <= a->Y + a->H)) {
+		e = (a->Y + a->H > b->Y + b->H) ? a->Y + a->H : b->Y + b->H;
+		a->Y = (a->Y < b->Y) ? a->Y : b->Y;
+		a->H = e - a->Y;
+		return 1;
+	}
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+static void DListRemove(uint16_t Index) {
+	dlistcnt--;
+	for (; Index < dlistcnt; Index++)
+		dlist[Index] = dlist[Index + 1];
+}
+
+//-----------------------------------------------------------------------------
+/* Sort key: MADCTL direction, then the top left corner in scan order */
+static uint8_t DListAfter(const DListEntry *a, const DListEntry *b) {
+	if (a->Dir != b->Dir)
+		return a->Dir > b->Dir;
+	if (a->Y != b->Y)
+		return a->Y > b->Y;
+	return a->X > b->X;
+}
+
+//-----------------------------------------------------------------------------
+static void DListOptimize(void) {
+	uint16_t i, j, k;
+	DListEntry t;
+
+	/* drop the primitives covered by a later one (every entry is opaque) */
+	for (i = 0; i < dlistcnt; i++)
+		for (j = i + 1; j < dlistcnt; j++)
+			if (DListCovers(&dlist[j], &dlist[i])) {
+				DListRemove(i--);
+				break;
+			}
+
+	/* merge every fill into an earlier one when no primitive between them
+	   touches it (the drawing order stays the same): one forward pass, each
+	   entry is compared backwards up to the first overlapping primitive and
+	   a grown entry is merged further back the same way */
+	for (j = 1; j < dlistcnt; j++) {
+		k = j;
+		for (i = j; i-- > 0;) {
+			if (DListMerge(&dlist[i], &dlist[k])) {
+				DListRemove(k);
+				k = i;
+				j--;
+			} else if (DListOverlap(&dlist[i], &dlist[k]))
+				break;
+		}
+	}
+
+	/* stable insertion sort, overlapping entries never change order */
+	for (i = 1; i < dlistcnt; i++)
+		for (j = i; (j > 0) && DListAfter(&dlist[j - 1], &dlist[j])
+				&& !DListOverlap(&dlist[j - 1], &dlist[j]); j--) {
+			t = dlist[j];
+			dlist[j] = dlist[j - 1];
+			dlist[j - 1] = t;
+		}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Start recording the drawing primitives
+ * @param  None
+ * @retval None
+ */
+void ST7796_DListBegin(void) {
+	dlistrec = 1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Optimize and send the recorded primitives (recording continues)
+ * @param  None
+ * @retval None
+ */
+void ST7796_DListFlush(void) {
+	uint16_t i;
+	uint8_t rec = dlistrec;
+	if (dlistflush || (dlistcnt == 0))
+		return;
+	dlistflush = 1;
+	DListOptimize();
+	dlistrec = 0;
+	for (i = 0; i < dlistcnt; i++) {
+		if (dlist[i].Type == ST7796_DL_FILL)
+			ST7796_FillRect(dlist[i].X, dlist[i].Y, dlist[i].W, dlist[i].H,
+					dlist[i].Color);
+		else
+			ST7796_DrawRGBImage(dlist[i].X, dlist[i].Y, dlist[i].W, dlist[i].H,
+					dlist[i].pData);
+	}
+	dlistcnt = 0;
+	dlistrec = rec;
+	dlistflush = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Send the recorded primitives and stop recording
+ * @param  None
+ * @retval None
+ */
+void ST7796_DListEnd(void) {
+	ST7796_DListFlush();
+	dlistrec = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Drop the recorded primitives without sending them (recording
+ *         continues)
+ * @param  None
+ * @retval None
+ */
+void ST7796_DListDrop(void) {
+	if (!dlistflush)
+		dlistcnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Store a primitive into the display list (called by the driver)
+ * @param  Type:    ST7796_DL_FILL or ST7796_DL_IMAGE
+ * @param  Xpos:    specifies the X position.
+ * @param  Ypos:    specifies the Y position.
+ * @param  Xsize:   specifies the X size
+ * @param  Ysize:   specifies the Y size
+ * @param  RGBCode: fill color (ST7796_DL_FILL)
+ * @param  pData:   image data (ST7796_DL_IMAGE)
+ * @retval 0: not recording (the caller draws directly), 1: recorded
+ */
+uint8_t ST7796_DListRecord(uint8_t Type, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode, uint16_t *pData) {
+	DListEntry *p;
+	if (!dlistrec)
+		return 0;
+	if ((Xsize == 0) || (Ysize == 0))
+		return 1;
+	if (dlistcnt >= ST7796_DLIST_SIZE)
+		ST7796_DListFlush();
+	p = &dlist[dlistcnt++];
+	p->Type = Type;
+	p->Dir = ST7796_MAD_DATA_RIGHT_THEN_DOWN;
+	p->X = Xpos;
+	p->Y = Ypos;
+	p->W = Xsize;
+	p->H = Ysize;
+	p->Color = RGBCode;
+	p->pData = pData;
+	return 1;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,48 @@
+/**
+ ******************************************************************************
+ * @file    st7796_dlist.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 display list
+ *          (deferred drawing with span coalescing).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_DLIST_H
+#define ST7796_DLIST_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Display list entry types */
+#define ST7796_DL_FILL     0         /* FillRect, DrawHLine, DrawVLine, WritePixel */
+#define ST7796_DL_IMAGE    1         /* DrawRGBImage */
+
+//-----------------------------------------------------------------------------
+/* While recording, ST7796_FillRect, ST7796_DrawHLine, ST7796_DrawVLine,
+   ST7796_WritePixel and ST7796_DrawRGBImage are stored in the list and only
+   sent to the LCD by ST7796_DListFlush / ST7796_DListEnd.
+   note: the image data of ST7796_DrawRGBImage is not copied, the buffer must
+   be left unchanged until the next flush */
+void ST7796_DListBegin(void);
+void ST7796_DListFlush(void);
+void ST7796_DListEnd(void);
+/* Forget the recorded primitives without sending them (ST7796_Init) */
+void ST7796_DListDrop(void);
+uint8_t ST7796_DListRecord(uint8_t Type, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode, uint16_t *pData);
+
+#endif /* ST7796_DLIST_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,367 @@
+/**
+ ******************************************************************************
+ * @file    st7796_fill.c
+ * @author  MCD Application Team
+ * @brief   Generator fills for the st7796 driver. Gradients, repeated tiles
+ *          and checkerboards are generated on the fly into a small chunk
+ *          buffer instead of a full size RAM image, the runs of one color
+ *          (constant rows of a vertical gradient, checkerboard cells) are
+ *          sent as fills and the constant columns of a horizontal gradient
+ *          as one filled rectangle / color step.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_fill.h"
+#if ST7796_ASYNC == 1
+#include "st7796_async.h"
+#define FILL_CHUNK       (ST7796_FILL_BUFFER / 2)
+#else
+#define FILL_CHUNK       ST7796_FILL_BUFFER
+#endif
+
+static uint16_t fillbuf[ST7796_FILL_BUFFER];
+static uint16_t *fillchunk;            /* chunk under generation */
+static uint16_t fillcnt;               /* generated pixels in the chunk */
+static uint16_t fillcolor;             /* color of the pending run */
+static uint32_t fillrun;               /* pixels of the pending run */
+#if ST7796_ASYNC == 1
+static volatile uint8_t fillbusy[2];   /* 1: the chunk is queued or on the wire */
+static uint8_t fillidx = 0;
+#else
+static uint8_t fillfirst;              /* 1: the next transfer starts the window */
+#endif
+
+static const uint8_t fillbayer[4][4] = {
+	{ 0, 8, 2, 10 },
+	{ 12, 4, 14, 6 },
+	{ 3, 11, 1, 9 },
+	{ 15, 7, 13, 5 } };
+
+#if ST7796_ASYNC == 1
+//-----------------------------------------------------------------------------
+/* Queue the generated pixels and continue in the other half of the buffer */
+static void FillFlush(void) {
+	if (!fillcnt)
+		return;
+	ST7796_AsyncWriteChunk(fillchunk, fillcnt, fillbusy, fillidx);
+	fillidx ^= 1;
+	fillchunk = &fillbuf[fillidx * FILL_CHUNK];
+	fillcnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+static void FillFill(uint16_t Color, uint32_t Size) {
+	FillFlush();
+	ST7796_WriteFillAsync(Color, Size, NULL, NULL);
+}
+
+#else /* #if ST7796_ASYNC == 1 */
+//-----------------------------------------------------------------------------
+/* Send the generated pixels */
+static void FillFlush(void) {
+	if (!fillcnt)
+		return;
+	if (fillfirst) {
+		LCD_IO_DrawBitmap(fillchunk, fillcnt);
+	} else {
+		LCD_IO_DrawBitmapCont(fillchunk, fillcnt);
+	}
+	fillfirst = 0;
+	fillcnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+static void FillFill(uint16_t Color, uint32_t Size) {
+	FillFlush();
+	if (fillfirst) {
+		LCD_IO_DrawFill(Color, Size);
+	} else {
+		LCD_IO_DrawFillCont(Color, Size);
+	}
+	fillfirst = 0;
+}
+#endif /* #else ST7796_ASYNC == 1 */
+
+//-----------------------------------------------------------------------------
+/* Send the pending run (a fill or buffered pixels) */
+static void FillRun(void) {
+	if (fillrun >= ST7796_FILL_MINFILL)
+		FillFill(fillcolor, fillrun);
+	else
+		while (fillrun--) {
+			fillchunk[fillcnt++] = fillcolor;
+			if (fillcnt >= FILL_CHUNK)
+				FillFlush();
+		}
+	fillrun = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Add Size pixels of one color (merged with the pending run) */
+static void FillPut(uint16_t Color, uint32_t Size) {
+	if (fillrun && (Color != fillcolor))
+		FillRun();
+	fillcolor = Color;
+	fillrun += Size;
+}
+
+//-----------------------------------------------------------------------------
+/* Clip a rectangle to the screen (0: nothing left) */
+static uint8_t FillClip(uint16_t *pX, uint16_t *pY, uint16_t *pW,
+		uint16_t *pH) {
+	if ((*pX >= ST7796_SIZE_X) || (*pY >= ST7796_SIZE_Y) || (*pW == 0)
+			|| (*pH == 0))
+		return 0;
+	if (*pW > ST7796_SIZE_X - *pX)
+		*pW = ST7796_SIZE_X - *pX;
+	if (*pH > ST7796_SIZE_Y - *pY)
+		*pH = ST7796_SIZE_Y - *pY;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Clip the rectangle and open the window (0: nothing left) */
+static uint8_t FillBegin(uint16_t *pX, uint16_t *pY, uint16_t *pW,
+		uint16_t *pH) {
+	if (!FillClip(pX, pY, pW, pH))
+		return 0;
+	ST7796_Sync();
+#if ST7796_ASYNC == 1
+	ST7796_SetWriteWindowAsync(*pX, *pY, *pW, *pH);
+	fillchunk = &fillbuf[fillidx * FILL_CHUNK];
+#else
+	ST7796_SetWriteWindow(*pX, *pY, *pW, *pH);
+	fillchunk = fillbuf;
+	fillfirst = 1;
+#endif
+	fillcnt = 0;
+	fillrun = 0;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Send the rest */
+static void FillEnd(void) {
+	FillRun();
+	FillFlush();
+}
+
+//-----------------------------------------------------------------------------
+/* Interpolate between two RGB565 colors (T: 0..65536, Bias: rounding or
+   dither threshold of the 16 bit fraction) */
+static uint16_t FillLerp(uint16_t C0, uint16_t C1, uint32_t T, uint32_t Bias) {
+	int32_t r = C0 >> 11, g = (C0 >> 5) & 0x3F, b = C0 & 0x1F;
+	r = ((r << 16) + ((int32_t) (C1 >> 11) - r) * (int32_t) T + Bias) >> 16;
+	g = ((g << 16) + ((int32_t) ((C1 >> 5) & 0x3F) - g) * (int32_t) T + Bias) >> 16;
+	b = ((b << 16) + ((int32_t) (C1 & 0x1F) - b) * (int32_t) T + Bias) >> 16;
+	return (r << 11) | (g << 5) | b;
+}
+
+//-----------------------------------------------------------------------------
+/* Rounding / dither threshold of a screen position */
+static uint32_t FillBias(uint16_t Xpos, uint16_t Ypos, uint8_t Flags) {
+	if (Flags & ST7796_FILL_DITHER)
+		return fillbayer[Ypos & 3][Xpos & 3] * 4096 + 2048;
+	return 0x8000;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a linear gradient
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Xsize:  specifies the X size
+ * @param  Ysize:  specifies the Y size
+ * @param  Color0: RGB565 color of the first corner in the (Dx, Dy) direction
+ * @param  Color1: RGB565 color of the last corner in the (Dx, Dy) direction
+ * @param  Dx:     X component of the gradient direction
+ * @param  Dy:     Y component of the gradient direction
+ * @param  Flags:  ST7796_FILL_DITHER or 0
+ * @retval None
+ */
+void ST7796_FillGradient(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Color0, uint16_t Color1, int16_t Dx,
+		int16_t Dy, uint8_t Flags) {
+	uint16_t x, y, ox, oy, c[4];
+	int32_t p0, p, range;
+	uint32_t inv;
+	uint8_t i;
+	/* position along the direction: x * Dx + y * Dy - p0 (0..range) */
+	p0 = ((Dx < 0) ? (int32_t) (Xsize - 1) * Dx : 0)
+			+ ((Dy < 0) ? (int32_t) (Ysize - 1) * Dy : 0);
+	range = (int32_t) (Xsize - 1) * ((Dx < 0) ? -Dx : Dx)
+			+ (int32_t) (Ysize - 1) * ((Dy < 0) ? -Dy : Dy);
+	inv = range ? 0xFFFFFFFFU / range : 0;
+	ox = Xpos;
+	oy = Ypos;
+	if (!FillBegin(&Xpos, &Ypos, &Xsize, &Ysize))
+		return;
+	ox = Xpos - ox;
+	oy = Ypos - oy;
+	for (y = 0; y < Ysize; y++) {
+		p = (int32_t) ox * Dx + (int32_t) (y + oy) * Dy - p0;
+		if (Dx == 0) {
+			/* constant row: one color, or the 4 pixel dither cycle */
+			for (i = 0; i < 4; i++)
+				c[i] = FillLerp(Color0, Color1, ((uint64_t) p * inv) >> 16,
+						FillBias(Xpos + i, Ypos + y, Flags));
+			if (!(Flags & ST7796_FILL_DITHER))
+				FillPut(c[0], Xsize);
+			else
+				for (x = 0; x < Xsize; x++)
+					FillPut(c[x & 3], 1);
+			continue;
+		}
+		for (x = 0; x < Xsize; x++, p += Dx)
+			FillPut(FillLerp(Color0, Color1, ((uint64_t) p * inv) >> 16,
+					FillBias(Xpos + x, Ypos + y, Flags)), 1);
+	}
+	FillEnd();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a vertical gradient
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Xsize:  specifies the X size
+ * @param  Ysize:  specifies the Y size
+ * @param  Top:    RGB565 color of the top row
+ * @param  Bottom: RGB565 color of the bottom row
+ * @param  Flags:  ST7796_FILL_DITHER or 0
+ * @retval None
+ */
+void ST7796_FillGradientV(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Top, uint16_t Bottom, uint8_t Flags) {
+	ST7796_FillGradient(Xpos, Ypos, Xsize, Ysize, Top, Bottom, 0, 1, Flags);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a horizontal gradient
+ * @param  Xpos:  specifies the X position.
+ * @param  Ypos:  specifies the Y position.
+ * @param  Xsize: specifies the X size
+ * @param  Ysize: specifies the Y size
+ * @param  Left:  RGB565 color of the left column
+ * @param  Right: RGB565 color of the right column
+ * @param  Flags: ST7796_FILL_DITHER or 0
+ * @retval None
+ */
+void ST7796_FillGradientH(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Left, uint16_t Right, uint8_t Flags) {
+	uint16_t x, w, ox, c;
+	uint32_t inv;
+	if (Flags & ST7796_FILL_DITHER) {
+		ST7796_FillGradient(Xpos, Ypos, Xsize, Ysize, Left, Right, 1, 0, Flags);
+		return;
+	}
+	inv = (Xsize > 1) ? 0xFFFFFFFFU / (Xsize - 1) : 0;
+	ox = Xpos;
+	if (!FillClip(&Xpos, &Ypos, &Xsize, &Ysize))
+		return;
+	ox = Xpos - ox;
+	ST7796_Sync();
+	/* constant columns: one filled rectangle / color step */
+	for (x = 0; x < Xsize; x += w) {
+		c = FillLerp(Left, Right, ((uint64_t) (x + ox) * inv) >> 16, 0x8000);
+		for (w = 1; (x + w < Xsize) && (FillLerp(Left, Right,
+				((uint64_t) (x + w + ox) * inv) >> 16, 0x8000) == c); w++);
+#if ST7796_ASYNC == 1
+		ST7796_FillRectAsync(Xpos + x, Ypos, w, Ysize, c, NULL, NULL);
+#else
+		ST7796_SetWriteWindow(Xpos + x, Ypos, w, Ysize);
+		LCD_IO_DrawFill(c, (uint32_t) w * Ysize);
+#endif
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Fill a rectangle with a repeated tile
+ * @param  Xpos:  specifies the X position.
+ * @param  Ypos:  specifies the Y position.
+ * @param  Xsize: specifies the X size
+ * @param  Ysize: specifies the Y size
+ * @param  pTile: tile (RGB565 pixels, TileX * TileY)
+ * @param  TileX: tile X size
+ * @param  TileY: tile Y size
+ * @retval None
+ */
+void ST7796_FillPattern(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, const uint16_t *pTile, uint16_t TileX, uint16_t TileY) {
+	uint16_t x, y, tx, ty, ox, oy;
+	const uint16_t *pRow;
+	if ((TileX == 0) || (TileY == 0))
+		return;
+	ox = Xpos;
+	oy = Ypos;
+	if (!FillBegin(&Xpos, &Ypos, &Xsize, &Ysize))
+		return;
+	ox = (Xpos - ox) % TileX;
+	ty = (Ypos - oy) % TileY;
+	for (y = 0; y < Ysize; y++) {
+		pRow = &pTile[ty * TileX];
+		for (x = 0, tx = ox; x < Xsize; x++) {
+			FillPut(pRow[tx], 1);
+			if (++tx == TileX)
+				tx = 0;
+		}
+		if (++ty == TileY)
+			ty = 0;
+	}
+	FillEnd();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a checkerboard
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Xsize:  specifies the X size
+ * @param  Ysize:  specifies the Y size
+ * @param  Color0: RGB565 color of the top left cell
+ * @param  Color1: RGB565 color of the other cells
+ * @param  CellX:  cell X size
+ * @param  CellY:  cell Y size
+ * @retval None
+ */
+void ST7796_FillChecker(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Color0, uint16_t Color1, uint16_t CellX,
+		uint16_t CellY) {
+	uint16_t x, y, w, ox, oy;
+	uint8_t odd;
+	if ((CellX == 0) || (CellY == 0))
+		return;
+	ox = Xpos;
+	oy = Ypos;
+	if (!FillBegin(&Xpos, &Ypos, &Xsize, &Ysize))
+		return;
+	ox = Xpos - ox;
+	oy = Ypos - oy;
+	for (y = 0; y < Ysize; y++) {
+		/* cell runs of the row */
+		odd = (((y + oy) / CellY) + (ox / CellX)) & 1;
+		for (x = 0, w = CellX - ox % CellX; x < Xsize; x += w, w = CellX, odd ^= 1)
+			FillPut(odd ? Color1 : Color0, (w > Xsize - x) ? Xsize - x : w);
+	}
+	FillEnd();
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,53 @@
+/**
+ ******************************************************************************
+ * @file    st7796_fill.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 generator fills
+ *          (gradients, patterns and checkerboards).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_FILL_H
+#define ST7796_FILL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Gradient flags */
+#define ST7796_FILL_DITHER      0x01  /* 4x4 ordered dithering between the RGB565 steps */
+
+//-----------------------------------------------------------------------------
+/* The pixels are generated into a small chunk buffer (halved and double
+   buffered against the transfer with ST7796_ASYNC), runs of one color of
+   at least ST7796_FILL_MINFILL pixels are sent as fills. The gradient and
+   pattern coordinates are relative to the rectangle, the dither pattern is
+   anchored to the screen. */
+void ST7796_FillGradientV(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Top, uint16_t Bottom, uint8_t Flags);
+void ST7796_FillGradientH(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Left, uint16_t Right, uint8_t Flags);
+/* Color0 -> Color1 along the (Dx, Dy) direction */
+void ST7796_FillGradient(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Color0, uint16_t Color1, int16_t Dx,
+		int16_t Dy, uint8_t Flags);
+void ST7796_FillPattern(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, const uint16_t *pTile, uint16_t TileX, uint16_t TileY);
+void ST7796_FillChecker(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Color0, uint16_t Color1, uint16_t CellX,
+		uint16_t CellY);
+
+#endif /* ST7796_FILL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
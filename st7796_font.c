@@ -0,0 +1,363 @@
+/**
+ ******************************************************************************
+ * @file    st7796_font.c
+ * @author  MCD Application Team
+ * @brief   Font renderer for the st7796 driver. The glyphs are expanded from
+ *          the coverage spans of the atlas (st7796_font.h) with a blending
+ *          LUT of the text / background color pair and sent with
+ *          LCD_IO_DrawBitmap: from the LRU glyph cache, from a line buffer
+ *          holding the whole string or, for the uncached glyphs, as a span
+ *          stream where the long uniform spans are LCD_IO_DrawFill writes.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_font.h"
+
+#define FONT_CHUNK       64            /* span stream buffer [pixel] */
+
+static uint16_t fonttext = 0xFFFF, fontback = 0x0000;
+static uint16_t fontlut[16];           /* coverage (4 bit scale) -> RGB565 */
+static uint8_t fontlutvalid = 0;
+static uint16_t *fontline = NULL;
+static uint32_t fontlinesize = 0;
+
+/* span stream state */
+static uint16_t fontbuf[FONT_CHUNK];
+static uint16_t fontcnt;
+static uint16_t fontruncolor;
+static uint32_t fontrunlen;
+static uint8_t fontfirst;
+
+#if ST7796_FONT_CACHE > 0
+typedef struct {
+	const ST7796_FontTypeDef *pFont;
+	uint16_t Index;                /* glyph index in pFont->pGlyph */
+	uint16_t Text, Back;
+	uint32_t Used;                 /* LRU time stamp (0: empty) */
+	uint16_t Pixel[ST7796_FONT_CACHEPIXELS];
+} FontCacheTypeDef;
+
+static FontCacheTypeDef fontcache[ST7796_FONT_CACHE];
+static uint32_t fonttick = 0;
+#endif
+
+//-----------------------------------------------------------------------------
+/* Blending LUT of the current color pair */
+static void FontMakeLut(void) {
+	uint8_t i;
+	int32_t r0 = fontback >> 11, g0 = (fontback >> 5) & 0x3F, b0 = fontback & 0x1F;
+	int32_t r1 = fonttext >> 11, g1 = (fonttext >> 5) & 0x3F, b1 = fonttext & 0x1F;
+	for (i = 0; i < 16; i++)
+		fontlut[i] = ((r0 + ((r1 - r0) * i + 7 * ((r1 > r0) ? 1 : -1)) / 15) << 11)
+				| ((g0 + ((g1 - g0) * i + 7 * ((g1 > g0) ? 1 : -1)) / 15) << 5)
+				| (b0 + ((b1 - b0) * i + 7 * ((b1 > b0) ? 1 : -1)) / 15);
+	fontlutvalid = 1;
+}
+
+//-----------------------------------------------------------------------------
+static const ST7796_GlyphTypeDef * FontGlyph(const ST7796_FontTypeDef *pFont,
+		uint16_t Code) {
+	if ((Code < pFont->First) || (Code - pFont->First >= pFont->Count))
+		return &pFont->pGlyph[0];
+	return &pFont->pGlyph[Code - pFont->First];
+}
+
+//-----------------------------------------------------------------------------
+/* Expand the Xsize x Ysize upper left part of a glyph cell to pDst */
+static void FontDecode(const ST7796_FontTypeDef *pFont,
+		const ST7796_GlyphTypeDef *pGlyph, uint16_t *pDst, uint16_t Pitch,
+		uint16_t Xsize, uint16_t Ysize) {
+	const uint8_t *s = &pFont->pSpan[pGlyph->Offset];
+	uint8_t shift = 8 - pFont->Bpp;
+	uint8_t mul = 15 / ((1 << pFont->Bpp) - 1);
+	uint16_t x = 0, y = 0, n, c;
+	while (y < Ysize) {
+		c = fontlut[(*s >> shift) * mul];
+		n = (*s++ & ((1 << shift) - 1)) + 1;
+		if ((x == 0) && (Xsize == pGlyph->Advance)) {
+			/* whole rows in the span */
+			while ((n >= Xsize) && (y < Ysize)) {
+				for (x = 0; x < Xsize; x++)
+					pDst[x] = c;
+				pDst += Pitch;
+				n -= Xsize;
+				y++;
+			}
+			x = 0;
+		}
+		while (n-- && (y < Ysize)) {
+			if (x < Xsize)
+				pDst[x] = c;
+			if (++x == pGlyph->Advance) {
+				x = 0;
+				y++;
+				pDst += Pitch;
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Span stream: send the buffered pixels */
+static void FontFlush(void) {
+	if (!fontcnt)
+		return;
+	if (fontfirst) {
+		LCD_IO_DrawBitmap(fontbuf, fontcnt);
+	} else {
+		LCD_IO_DrawBitmapCont(fontbuf, fontcnt);
+	}
+	fontfirst = 0;
+	fontcnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Span stream: send the pending uniform run (long runs as fill) */
+static void FontRunFlush(void) {
+	if (fontrunlen >= ST7796_FONT_MINFILL) {
+		FontFlush();
+		if (fontfirst) {
+			LCD_IO_DrawFill(fontruncolor, fontrunlen);
+		} else {
+			LCD_IO_DrawFillCont(fontruncolor, fontrunlen);
+		}
+		fontfirst = 0;
+	} else
+		while (fontrunlen--) {
+			fontbuf[fontcnt++] = fontruncolor;
+			if (fontcnt == FONT_CHUNK)
+				FontFlush();
+		}
+	fontrunlen = 0;
+}
+
+//-----------------------------------------------------------------------------
+static void FontRun(uint16_t Color, uint32_t Len) {
+	if (Len == 0)
+		return;
+	if ((fontrunlen) && (Color != fontruncolor))
+		FontRunFlush();
+	fontruncolor = Color;
+	fontrunlen += Len;
+}
+
+//-----------------------------------------------------------------------------
+/* Send the Xsize x Ysize upper left part of a glyph cell as a span stream
+   (the window is already set) */
+static void FontStream(const ST7796_FontTypeDef *pFont,
+		const ST7796_GlyphTypeDef *pGlyph, uint16_t Xsize, uint16_t Ysize) {
+	const uint8_t *s = &pFont->pSpan[pGlyph->Offset];
+	uint8_t shift = 8 - pFont->Bpp;
+	uint8_t mul = 15 / ((1 << pFont->Bpp) - 1);
+	uint32_t left = (uint32_t) pGlyph->Advance * Ysize, n, m;
+	uint16_t x = 0, c;
+	fontcnt = 0;
+	fontrunlen = 0;
+	fontfirst = 1;
+	while (left) {
+		c = fontlut[(*s >> shift) * mul];
+		n = (*s++ & ((1 << shift) - 1)) + 1;
+		if (n > left)
+			n = left;
+		left -= n;
+		if (Xsize == pGlyph->Advance) {
+			FontRun(c, n);
+			continue;
+		}
+		/* clipped cell: only the first Xsize columns of the rows */
+		while (n) {
+			m = pGlyph->Advance - x;
+			if (m > n)
+				m = n;
+			if (x < Xsize)
+				FontRun(c, (x + m > Xsize) ? (uint32_t) (Xsize - x) : m);
+			x = (x + m) % pGlyph->Advance;
+			n -= m;
+		}
+	}
+	FontRunFlush();
+	FontFlush();
+}
+
+#if ST7796_FONT_CACHE > 0
+//-----------------------------------------------------------------------------
+/* Expanded glyph cell from the LRU cache, the key is the glyph index and the
+   color pair (NULL: larger than a cache entry) */
+static uint16_t * FontCached(const ST7796_FontTypeDef *pFont,
+		const ST7796_GlyphTypeDef *pGlyph) {
+	uint16_t i, lru = 0, index = pGlyph - pFont->pGlyph;
+	if ((uint32_t) pGlyph->Advance * pFont->Height > ST7796_FONT_CACHEPIXELS)
+		return NULL;
+	fonttick++;
+	for (i = 0; i < ST7796_FONT_CACHE; i++) {
+		if ((fontcache[i].Used) && (fontcache[i].pFont == pFont)
+				&& (fontcache[i].Index == index) && (fontcache[i].Text == fonttext)
+				&& (fontcache[i].Back == fontback)) {
+			fontcache[i].Used = fonttick;
+			return fontcache[i].Pixel;
+		}
+		if (fontcache[i].Used < fontcache[lru].Used)
+			lru = i;
+	}
+	fontcache[lru].pFont = pFont;
+	fontcache[lru].Index = index;
+	fontcache[lru].Text = fonttext;
+	fontcache[lru].Back = fontback;
+	fontcache[lru].Used = fonttick;
+	FontDecode(pFont, pGlyph, fontcache[lru].Pixel, pGlyph->Advance,
+			pGlyph->Advance, pFont->Height);
+	return fontcache[lru].Pixel;
+}
+#else
+#define FontCached(pFont, pGlyph)   NULL
+#endif
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Font renderer init
+ * @param  pLineBuffer: string buffer (NULL: one window / glyph)
+ * @param  Size:        pLineBuffer size [pixel]
+ * @retval None
+ */
+void ST7796_FontInit(uint16_t *pLineBuffer, uint32_t Size) {
+	fontline = pLineBuffer;
+	fontlinesize = pLineBuffer ? Size : 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the text colors
+ * @param  TextColor: text color (full coverage)
+ * @param  BackColor: background color (no coverage)
+ * @retval None
+ */
+void ST7796_FontSetColor(uint16_t TextColor, uint16_t BackColor) {
+	if ((TextColor != fonttext) || (BackColor != fontback) || !fontlutvalid) {
+		fonttext = TextColor;
+		fontback = BackColor;
+		FontMakeLut();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Width of a string
+ * @param  pFont: font
+ * @param  pText: string
+ * @retval width [pixel]
+ */
+uint16_t ST7796_FontGetStringWidth(const ST7796_FontTypeDef *pFont,
+		const char *pText) {
+	uint16_t w = 0;
+	while (*pText)
+		w += FontGlyph(pFont, (uint8_t) *pText++)->Advance;
+	return w;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a character
+ * @param  Xpos:  specifies the X position (left of the cell)
+ * @param  Ypos:  specifies the Y position (top of the cell)
+ * @param  pFont: font
+ * @param  Code:  character code
+ * @retval advance [pixel]
+ */
+uint16_t ST7796_DrawChar(uint16_t Xpos, uint16_t Ypos,
+		const ST7796_FontTypeDef *pFont, uint16_t Code) {
+	const ST7796_GlyphTypeDef *pGlyph = FontGlyph(pFont, Code);
+	uint16_t w = pGlyph->Advance, h = pFont->Height, y;
+	uint16_t *p;
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y) || (w == 0))
+		return pGlyph->Advance;
+	if (w > ST7796_SIZE_X - Xpos)
+		w = ST7796_SIZE_X - Xpos;
+	if (h > ST7796_SIZE_Y - Ypos)
+		h = ST7796_SIZE_Y - Ypos;
+	if (!fontlutvalid)
+		FontMakeLut();
+
+	ST7796_Sync();
+	ST7796_SetWriteWindow(Xpos, Ypos, w, h);
+	p = FontCached(pFont, pGlyph);
+	if (p == NULL) {
+		FontStream(pFont, pGlyph, w, h);
+	} else if (w == pGlyph->Advance) {
+		LCD_IO_DrawBitmap(p, w * h);
+	} else {
+		LCD_IO_DrawBitmap(p, w);
+		for (y = 1; y < h; y++) {
+			LCD_IO_DrawBitmapCont(&p[y * pGlyph->Advance], w);
+		}
+	}
+	return pGlyph->Advance;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a string
+ * @param  Xpos:  specifies the X position (left of the first cell)
+ * @param  Ypos:  specifies the Y position (top of the cells)
+ * @param  pFont: font
+ * @param  pText: string
+ * @retval string width [pixel]
+ */
+uint16_t ST7796_DrawString(uint16_t Xpos, uint16_t Ypos,
+		const ST7796_FontTypeDef *pFont, const char *pText) {
+	const ST7796_GlyphTypeDef *pGlyph;
+	uint16_t width = ST7796_FontGetStringWidth(pFont, pText);
+	uint16_t w = width, h = pFont->Height, x, cw, y;
+	uint16_t *p;
+
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y) || (width == 0))
+		return width;
+	if (w > ST7796_SIZE_X - Xpos)
+		w = ST7796_SIZE_X - Xpos;
+	if (h > ST7796_SIZE_Y - Ypos)
+		h = ST7796_SIZE_Y - Ypos;
+
+	if ((uint32_t) w * h > fontlinesize) {
+		/* one window / glyph */
+		for (x = Xpos; *pText && (x < ST7796_SIZE_X); pText++)
+			x += ST7796_DrawChar(x, Ypos, pFont, (uint8_t) *pText);
+		return width;
+	}
+
+	/* the whole string in the line buffer, one window */
+	if (!fontlutvalid)
+		FontMakeLut();
+	for (x = 0; *pText && (x < w); pText++, x += pGlyph->Advance) {
+		pGlyph = FontGlyph(pFont, (uint8_t) *pText);
+		cw = (pGlyph->Advance > w - x) ? w - x : pGlyph->Advance;
+		p = FontCached(pFont, pGlyph);
+		if (p == NULL) {
+			FontDecode(pFont, pGlyph, &fontline[x], w, cw, h);
+		} else {
+			for (y = 0; y < h; y++)
+				memcpy(&fontline[y * w + x], &p[y * pGlyph->Advance], cw * 2);
+		}
+	}
+	ST7796_Sync();
+	ST7796_SetWriteWindow(Xpos, Ypos, w, h);
+	LCD_IO_DrawBitmap(fontline, (uint32_t) w * h);
+	return width;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,73 @@
+/**
+ ******************************************************************************
+ * @file    st7796_font.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 font renderer
+ *          (pre-rasterized anti-aliased glyph atlas, see st7796_font_conv.c
+ *          for the converter).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_FONT_H
+#define ST7796_FONT_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Glyph atlas
+   Every glyph is a cell of Advance x Height pixels (the background around the
+   glyph included), stored as coverage spans from left to right, top to
+   bottom (the spans continue on the next row):
+   - span byte: coverage level in the upper Bpp bits (0: background,
+                2^Bpp - 1: text color), run length - 1 in the lower 8 - Bpp bits
+   The characters out of the First .. First + Count - 1 range are drawn with
+   the first glyph. */
+#define ST7796_FONT_SPAN(Bpp, Level, Len)  ((uint8_t)(((Level) << (8 - (Bpp))) | ((Len) - 1)))
+#define ST7796_FONT_SPANMAX(Bpp)           (1U << (8 - (Bpp)))
+
+typedef struct {
+	uint32_t Offset;               /* first span byte of the glyph in pSpan */
+	uint16_t Advance;              /* cell width [pixel] */
+} ST7796_GlyphTypeDef;
+
+typedef struct {
+	const ST7796_GlyphTypeDef *pGlyph;
+	const uint8_t *pSpan;
+	uint16_t First;                /* character code of pGlyph[0] */
+	uint16_t Count;                /* number of glyphs */
+	uint16_t Height;               /* cell height [pixel] */
+	uint16_t Baseline;             /* baseline row from the top of the cell */
+	uint8_t Bpp;                   /* coverage bits / pixel: 1, 2 or 4 */
+} ST7796_FontTypeDef;
+
+//-----------------------------------------------------------------------------
+/* Renderer (st7796_font.c)
+   pLineBuffer: with a line buffer (Size pixels) a string that fits in it is
+   drawn in one window, without it every glyph has its own window. The last
+   ST7796_FONT_CACHE expanded glyphs (per text / background color) are kept
+   in a LRU cache. */
+void ST7796_FontInit(uint16_t *pLineBuffer, uint32_t Size);
+void ST7796_FontSetColor(uint16_t TextColor, uint16_t BackColor);
+uint16_t ST7796_FontGetStringWidth(const ST7796_FontTypeDef *pFont, const char *pText);
+uint16_t ST7796_DrawChar(uint16_t Xpos, uint16_t Ypos, const ST7796_FontTypeDef *pFont, uint16_t Code);
+uint16_t ST7796_DrawString(uint16_t Xpos, uint16_t Ypos, const ST7796_FontTypeDef *pFont, const char *pText);
+
+/* Encoder (st7796_font_conv.c, host tool) */
+uint32_t ST7796_FontEncodeGlyph(const uint8_t *pLevel, uint32_t Size, uint8_t Bpp,
+		uint8_t *pDst, uint32_t DstSize);
+
+#endif /* ST7796_FONT_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
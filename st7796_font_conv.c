@@ -0,0 +1,264 @@
+/**
+ ******************************************************************************
+ * @file    st7796_font_conv.c
+ * @author  MCD Application Team
+ * @brief   Glyph atlas encoder of the st7796 font renderer (host tool).
+ *          Build with ST7796_FONT_MAIN defined to get a command line tool
+ *          converting a BDF font (or with ST7796_FONT_FREETYPE defined and
+ *          FreeType linked, a TTF / OTF font) to a C source file:
+ *          st7796_font_conv [-bpp 1|2|4] [-size pixel] [-aa n] [-first code]
+ *                           [-last code] font.bdf|font.ttf name > name.c
+ *          -size: TTF pixel size, -aa: BDF supersampling (the anti-aliased
+ *          glyphs are n times smaller than the BDF glyphs)
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "st7796_font.h"
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Encode the coverage levels of a glyph cell into spans
+ * @param  pLevel:  coverage levels (0 .. 2^Bpp - 1), left to right, top to bottom
+ * @param  Size:    number of pixels (Advance * Height)
+ * @param  Bpp:     coverage bits / pixel (1, 2, 4)
+ * @param  pDst:    span buffer (NULL: only the size is computed)
+ * @param  DstSize: pDst size [byte]
+ * @retval span bytes (also when larger than DstSize)
+ */
+uint32_t ST7796_FontEncodeGlyph(const uint8_t *pLevel, uint32_t Size,
+		uint8_t Bpp, uint8_t *pDst, uint32_t DstSize) {
+	uint32_t i = 0, n, pos = 0;
+	while (i < Size) {
+		for (n = 1; (i + n < Size) && (n < ST7796_FONT_SPANMAX(Bpp))
+				&& (pLevel[i + n] == pLevel[i]); n++)
+			;
+		if (pos < DstSize)
+			pDst[pos] = ST7796_FONT_SPAN(Bpp, pLevel[i], n);
+		pos++;
+		i += n;
+	}
+	return pos;
+}
+
+#if defined(ST7796_FONT_MAIN)
+#if defined(ST7796_FONT_FREETYPE)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+typedef struct {
+	uint16_t Advance;
+	uint8_t *pCov;                 /* Advance x convheight coverage (0 .. 255) */
+} FontConvGlyphTypeDef;
+
+static FontConvGlyphTypeDef *convglyph;
+static uint16_t convfirst, convcount, convheight, convbaseline;
+
+//-----------------------------------------------------------------------------
+/* Load a BDF font, Aa x Aa source pixels give one pixel of the atlas */
+static int FontLoadBdf(const char *pName, uint8_t Aa) {
+	FILE *f = fopen(pName, "r");
+	char line[256];
+	int ascent = -1, descent = -1, bbh, bby, enc = -1, dw = 0, w = 0, h = 0, xo = 0,
+			yo = 0, x, y, sx, sy, sh, n;
+	uint8_t *pSrc = NULL;
+	unsigned long bits;
+	if (f == NULL)
+		return 0;
+	while (fgets(line, sizeof(line), f)) {
+		if (sscanf(line, "FONTBOUNDINGBOX %*d %d %*d %d", &bbh, &bby) == 2) {
+			if (ascent < 0)
+				ascent = bbh + bby;
+			if (descent < 0)
+				descent = -bby;
+		} else if (sscanf(line, "FONT_ASCENT %d", &n) == 1)
+			ascent = n;
+		else if (sscanf(line, "FONT_DESCENT %d", &n) == 1)
+			descent = n;
+		else if (strncmp(line, "STARTCHAR", 9) == 0) {
+			enc = -1;
+			dw = 0;
+		} else if (sscanf(line, "ENCODING %d", &n) == 1)
+			enc = n;
+		else if (sscanf(line, "DWIDTH %d", &n) == 1)
+			dw = n;
+		else if (sscanf(line, "BBX %d %d %d %d", &w, &h, &xo, &yo) == 4)
+			;
+		else if (strncmp(line, "BITMAP", 6) == 0) {
+			if ((ascent < 0) || (descent < 0))
+				break;
+			/* full resolution cell: dw x (ascent + descent) */
+			sh = ascent + descent;
+			pSrc = calloc((size_t) (dw + 1) * sh, 1);
+			for (y = 0; (y < h) && fgets(line, sizeof(line), f); y++) {
+				bits = strtoul(line, NULL, 16);
+				n = strspn(line, "0123456789ABCDEFabcdef") * 4;
+				for (x = 0; x < w; x++) {
+					sx = xo + x;
+					sy = ascent - (yo + h) + y;
+					if ((sx >= 0) && (sx < dw) && (sy >= 0) && (sy < sh)
+							&& (bits & (1UL << (n - 1 - x))))
+						pSrc[sy * dw + sx] = 1;
+				}
+			}
+			convheight = (sh + Aa - 1) / Aa;
+			convbaseline = ascent / Aa;
+			if ((enc >= convfirst) && (enc < convfirst + convcount)) {
+				FontConvGlyphTypeDef *g = &convglyph[enc - convfirst];
+				g->Advance = (dw + Aa - 1) / Aa;
+				g->pCov = calloc((size_t) g->Advance * convheight + 1, 1);
+				for (y = 0; y < convheight; y++)
+					for (x = 0; x < g->Advance; x++) {
+						n = 0;
+						for (sy = y * Aa; (sy < y * Aa + Aa) && (sy < sh); sy++)
+							for (sx = x * Aa; (sx < x * Aa + Aa) && (sx < dw); sx++)
+								n += pSrc[sy * dw + sx];
+						g->pCov[y * g->Advance + x] = n * 255 / (Aa * Aa);
+					}
+			}
+			free(pSrc);
+		}
+	}
+	fclose(f);
+	return (ascent >= 0) && (descent >= 0);
+}
+
+#if defined(ST7796_FONT_FREETYPE)
+//-----------------------------------------------------------------------------
+/* Load a TTF / OTF font with FreeType (gray levels, monochrome for 1 bpp) */
+static int FontLoadFt(const char *pName, uint16_t Size, uint8_t Bpp) {
+	FT_Library lib;
+	FT_Face face;
+	FT_Bitmap *b;
+	int ascent, descent, x, y, px, py, i;
+	uint8_t v;
+	if (FT_Init_FreeType(&lib) || FT_New_Face(lib, pName, 0, &face)
+			|| FT_Set_Pixel_Sizes(face, 0, Size))
+		return 0;
+	ascent = (face->size->metrics.ascender + 63) >> 6;
+	descent = (-face->size->metrics.descender + 63) >> 6;
+	convheight = ascent + descent;
+	convbaseline = ascent;
+	for (i = 0; i < convcount; i++) {
+		FontConvGlyphTypeDef *g = &convglyph[i];
+		if (FT_Load_Char(face, convfirst + i, FT_LOAD_RENDER
+				| ((Bpp == 1) ? FT_LOAD_TARGET_MONO : FT_LOAD_TARGET_NORMAL)))
+			continue;
+		b = &face->glyph->bitmap;
+		g->Advance = (face->glyph->advance.x + 32) >> 6;
+		g->pCov = calloc((size_t) g->Advance * convheight + 1, 1);
+		for (y = 0; y < (int) b->rows; y++)
+			for (x = 0; x < (int) b->width; x++) {
+				px = face->glyph->bitmap_left + x;
+				py = ascent - face->glyph->bitmap_top + y;
+				if ((px < 0) || (px >= g->Advance) || (py < 0) || (py >= convheight))
+					continue;
+				if (b->pixel_mode == FT_PIXEL_MODE_MONO)
+					v = (b->buffer[y * b->pitch + x / 8] & (0x80 >> (x & 7))) ? 255 : 0;
+				else
+					v = b->buffer[y * b->pitch + x];
+				g->pCov[py * g->Advance + px] = v;
+			}
+	}
+	FT_Done_Face(face);
+	FT_Done_FreeType(lib);
+	return 1;
+}
+#endif /* #if defined(ST7796_FONT_FREETYPE) */
+
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[]) {
+	uint8_t bpp = 4, aa = 1, *pLevel, *pSpan = NULL;
+	uint16_t last = 126;
+#if defined(ST7796_FONT_FREETYPE)
+	uint16_t size = 16;                  /* pixel size of the scalable fonts */
+#endif
+	uint32_t spansize = 0, n, i, j, cells = 0;
+	const char *pName;
+	int a, ok;
+
+	convfirst = 32;
+	for (a = 1; (a + 1 < argc) && (argv[a][0] == '-'); a += 2) {
+		if (strcmp(argv[a], "-bpp") == 0)
+			bpp = atoi(argv[a + 1]);
+#if defined(ST7796_FONT_FREETYPE)
+		else if (strcmp(argv[a], "-size") == 0)
+			size = atoi(argv[a + 1]);
+#endif
+		else if (strcmp(argv[a], "-aa") == 0)
+			aa = atoi(argv[a + 1]);
+		else if (strcmp(argv[a], "-first") == 0)
+			convfirst = strtoul(argv[a + 1], NULL, 0);
+		else if (strcmp(argv[a], "-last") == 0)
+			last = strtoul(argv[a + 1], NULL, 0);
+	}
+	if ((a + 2 > argc) || ((bpp != 1) && (bpp != 2) && (bpp != 4)) || (aa == 0)
+			|| (last < convfirst)) {
+		fprintf(stderr, "usage: %s [-bpp 1|2|4] [-size pixel] [-aa n] "
+				"[-first code] [-last code] font.bdf|font.ttf name > name.c\n",
+				argv[0]);
+		return 1;
+	}
+	pName = argv[a];
+	convcount = last - convfirst + 1;
+	convglyph = calloc(convcount, sizeof(FontConvGlyphTypeDef));
+	n = strlen(pName);
+	if ((n > 4) && (strcmp(&pName[n - 4], ".bdf") == 0))
+		ok = FontLoadBdf(pName, aa);
+	else
+#if defined(ST7796_FONT_FREETYPE)
+		ok = FontLoadFt(pName, size, bpp);
+#else
+		ok = 0;
+#endif
+	if (!ok) {
+		fprintf(stderr, "%s: unknown font format\n", pName);
+		return 1;
+	}
+
+	/* quantize and encode the cells */
+	printf("#include \"st7796_font.h\"\n\n");
+	printf("static const ST7796_GlyphTypeDef %s_glyph[%u] = {", argv[a + 1],
+			convcount);
+	for (i = 0; i < convcount; i++) {
+		FontConvGlyphTypeDef *g = &convglyph[i];
+		n = (uint32_t) g->Advance * convheight;
+		pLevel = malloc(n + 1);
+		for (j = 0; j < n; j++)
+			pLevel[j] = (g->pCov[j] * ((1 << bpp) - 1) + 127) / 255;
+		pSpan = realloc(pSpan, spansize + n + 1);
+		printf("%s{ %u, %u },", (i % 6) ? " " : "\n  ", spansize, g->Advance);
+		spansize += ST7796_FontEncodeGlyph(pLevel, n, bpp, &pSpan[spansize], n);
+		free(pLevel);
+		cells += n;
+	}
+	printf("\n};\n\n");
+	printf("/* %s: %u glyphs, height %u, %u bpp, %u span bytes (RGB565: %u bytes) */\n",
+			pName, convcount, convheight, bpp, spansize, cells * 2);
+	printf("static const uint8_t %s_span[%u] = {", argv[a + 1], spansize);
+	for (i = 0; i < spansize; i++)
+		printf("%s0x%02X,", (i % 16) ? " " : "\n  ", pSpan[i]);
+	printf("\n};\n\n");
+	printf("const ST7796_FontTypeDef %s = { %s_glyph, %s_span, %u, %u, %u, %u, %u };\n",
+			argv[a + 1], argv[a + 1], argv[a + 1], convfirst, convcount,
+			convheight, convbaseline, bpp);
+	return 0;
+}
+#endif /* #if defined(ST7796_FONT_MAIN) */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
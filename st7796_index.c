@@ -0,0 +1,421 @@
+/**
+ ******************************************************************************
+ * @file    st7796_index.c
+ * @author  MCD Application Team
+ * @brief   Indexed color framebuffer for the st7796 driver. The screen is
+ *          stored with ST7796_INDEX_BPP bits / pixel (320x480: 150 KB with
+ *          8 bits, 75 KB with 4 bits), the flush expands the palette indices
+ *          of the dirty rectangle in a streaming line buffer: to RGB565, or
+ *          directly to the RGB888 bus bytes with ST7796_WRITEBITDEPTH 24.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_index.h"
+#if ST7796_WRITEBITDEPTH == 24
+#include "st7796_conv.h"
+#endif
+
+#if (ST7796_INDEX_BPP != 8) && (ST7796_INDEX_BPP != 4)
+#error "ST7796_INDEX_BPP must be 8 or 4"
+#endif
+
+#define INDEX_COLORS     (1 << ST7796_INDEX_BPP)
+#define INDEX_PITCH      (ST7796_SIZE_X * ST7796_INDEX_BPP / 8)
+
+static uint8_t *indexframe;
+static uint16_t *indexbuf;
+static uint32_t indexbufsize;
+static uint16_t indexpal[INDEX_COLORS];
+#if ST7796_WRITEBITDEPTH == 24
+static uint8_t indexpal24[INDEX_COLORS * 3];  /* bus bytes of the palette */
+#endif
+/* dirty rectangle (x0 >= x1: clean) */
+static uint16_t indexx0, indexy0, indexx1, indexy1;
+
+//-----------------------------------------------------------------------------
+/* Clip a rectangle to the screen (0: nothing left) */
+static uint8_t IndexClip(uint16_t *pX, uint16_t *pY, uint16_t *pW,
+		uint16_t *pH) {
+	if ((*pX >= ST7796_SIZE_X) || (*pY >= ST7796_SIZE_Y) || (*pW == 0)
+			|| (*pH == 0))
+		return 0;
+	if (*pW > ST7796_SIZE_X - *pX)
+		*pW = ST7796_SIZE_X - *pX;
+	if (*pH > ST7796_SIZE_Y - *pY)
+		*pH = ST7796_SIZE_Y - *pY;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Grow the dirty rectangle with an already clipped rectangle */
+static void IndexMark(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	if (indexx0 >= indexx1) {
+		indexx0 = Xpos;
+		indexy0 = Ypos;
+		indexx1 = Xpos + Xsize;
+		indexy1 = Ypos + Ysize;
+		return;
+	}
+	if (Xpos < indexx0)
+		indexx0 = Xpos;
+	if (Ypos < indexy0)
+		indexy0 = Ypos;
+	if (Xpos + Xsize > indexx1)
+		indexx1 = Xpos + Xsize;
+	if (Ypos + Ysize > indexy1)
+		indexy1 = Ypos + Ysize;
+}
+
+//-----------------------------------------------------------------------------
+/* Store an index into a row segment of the framebuffer */
+static void IndexSetRow(uint16_t Xpos, uint16_t Ypos, uint16_t Length,
+		uint8_t Index) {
+	uint8_t *p = &indexframe[Ypos * INDEX_PITCH];
+#if ST7796_INDEX_BPP == 8
+	memset(&p[Xpos], Index, Length);
+#else
+	Index &= 0x0F;
+	p += Xpos >> 1;
+	if (Xpos & 1) {
+		/* right half of the first byte */
+		*p = (*p & 0xF0) | Index;
+		p++;
+		Length--;
+	}
+	memset(p, Index * 0x11, Length >> 1);
+	if (Length & 1) {
+		/* left half of the last byte */
+		p += Length >> 1;
+		*p = (*p & 0x0F) | (Index << 4);
+	}
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/* Expand a row segment of the framebuffer through the palette */
+#if ST7796_WRITEBITDEPTH == 24
+static uint8_t * IndexExpandRow(uint8_t *pDst, uint16_t Xpos, uint16_t Ypos,
+		uint32_t Length) {
+	const uint8_t *s = &indexframe[Ypos * INDEX_PITCH], *c;
+#if ST7796_INDEX_BPP == 8
+	s += Xpos;
+	while (Length--) {
+		c = &indexpal24[*s++ * 3];
+		*pDst++ = c[0];
+		*pDst++ = c[1];
+		*pDst++ = c[2];
+	}
+#else
+	s += Xpos >> 1;
+	if (Xpos & 1) {
+		c = &indexpal24[(*s++ & 0x0F) * 3];
+		*pDst++ = c[0];
+		*pDst++ = c[1];
+		*pDst++ = c[2];
+		Length--;
+	}
+	for (; Length >= 2; Length -= 2, s++) {
+		c = &indexpal24[(*s >> 4) * 3];
+		*pDst++ = c[0];
+		*pDst++ = c[1];
+		*pDst++ = c[2];
+		c = &indexpal24[(*s & 0x0F) * 3];
+		*pDst++ = c[0];
+		*pDst++ = c[1];
+		*pDst++ = c[2];
+	}
+	if (Length) {
+		c = &indexpal24[(*s >> 4) * 3];
+		*pDst++ = c[0];
+		*pDst++ = c[1];
+		*pDst++ = c[2];
+	}
+#endif
+	return pDst;
+}
+#else
+static uint16_t * IndexExpandRow(uint16_t *pDst, uint16_t Xpos, uint16_t Ypos,
+		uint32_t Length) {
+	const uint8_t *s = &indexframe[Ypos * INDEX_PITCH];
+#if ST7796_INDEX_BPP == 8
+	s += Xpos;
+	for (; Length >= 4; Length -= 4, s += 4, pDst += 4) {
+		pDst[0] = indexpal[s[0]];
+		pDst[1] = indexpal[s[1]];
+		pDst[2] = indexpal[s[2]];
+		pDst[3] = indexpal[s[3]];
+	}
+	while (Length--)
+		*pDst++ = indexpal[*s++];
+#else
+	s += Xpos >> 1;
+	if (Xpos & 1) {
+		*pDst++ = indexpal[*s++ & 0x0F];
+		Length--;
+	}
+	for (; Length >= 2; Length -= 2, s++) {
+		*pDst++ = indexpal[*s >> 4];
+		*pDst++ = indexpal[*s & 0x0F];
+	}
+	if (Length)
+		*pDst++ = indexpal[*s >> 4];
+#endif
+	return pDst;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the framebuffer and the line buffer, mark the full screen
+ * @param  pFrame:  framebuffer (ST7796_INDEX_FRAMESIZE bytes)
+ * @param  pBuffer: line buffer of the flush
+ * @param  Size:    line buffer size [pixel] (at least 2)
+ * @retval None
+ */
+void ST7796_IndexInit(uint8_t *pFrame, uint16_t *pBuffer, uint32_t Size) {
+	indexframe = pFrame;
+	indexbuf = pBuffer;
+	indexbufsize = Size;
+	IndexMark(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the framebuffer
+ * @param  None
+ * @retval framebuffer
+ */
+uint8_t * ST7796_IndexGetFrame(void) {
+	return indexframe;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set palette entries, mark the full screen
+ * @param  First: first index
+ * @param  Count: number of entries
+ * @param  pRGB:  RGB565 colors
+ * @retval None
+ */
+void ST7796_IndexSetPalette(uint16_t First, uint16_t Count,
+		const uint16_t *pRGB) {
+	if (First >= INDEX_COLORS)
+		return;
+	if (Count > INDEX_COLORS - First)
+		Count = INDEX_COLORS - First;
+	memcpy(&indexpal[First], pRGB, Count * 2);
+#if ST7796_WRITEBITDEPTH == 24
+	ST7796_Conv16to24(&indexpal[First], &indexpal24[First * 3], Count);
+#endif
+	IndexMark(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Mark a directly changed area
+ * @param  Xpos:  specifies the X position.
+ * @param  Ypos:  specifies the Y position.
+ * @param  Xsize: specifies the X size
+ * @param  Ysize: specifies the Y size
+ * @retval None
+ */
+void ST7796_IndexMarkDirty(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	if (IndexClip(&Xpos, &Ypos, &Xsize, &Ysize))
+		IndexMark(Xpos, Ypos, Xsize, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Write pixel.
+ * @param  Xpos:  specifies the X position.
+ * @param  Ypos:  specifies the Y position.
+ * @param  Index: palette index
+ * @retval None
+ */
+void ST7796_IndexWritePixel(uint16_t Xpos, uint16_t Ypos, uint8_t Index) {
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y))
+		return;
+	IndexSetRow(Xpos, Ypos, 1, Index);
+	IndexMark(Xpos, Ypos, 1, 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Read pixel.
+ * @param  Xpos: specifies the X position.
+ * @param  Ypos: specifies the Y position.
+ * @retval palette index
+ */
+uint8_t ST7796_IndexReadPixel(uint16_t Xpos, uint16_t Ypos) {
+	uint8_t b;
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y))
+		return 0;
+#if ST7796_INDEX_BPP == 8
+	b = indexframe[Ypos * INDEX_PITCH + Xpos];
+#else
+	b = indexframe[Ypos * INDEX_PITCH + (Xpos >> 1)];
+	b = (Xpos & 1) ? (b & 0x0F) : (b >> 4);
+#endif
+	return b;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw horizontal line.
+ * @param  Index:  palette index
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Length: specifies the Line length.
+ * @retval None
+ */
+void ST7796_IndexDrawHLine(uint8_t Index, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Length) {
+	ST7796_IndexFillRect(Xpos, Ypos, Length, 1, Index);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw vertical line.
+ * @param  Index:  palette index
+ * @param  Xpos:   specifies the X position.
+ * @param  Ypos:   specifies the Y position.
+ * @param  Length: specifies the Line length.
+ * @retval None
+ */
+void ST7796_IndexDrawVLine(uint8_t Index, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Length) {
+	ST7796_IndexFillRect(Xpos, Ypos, 1, Length, Index);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw Filled rectangle
+ * @param  Xpos:  specifies the X position.
+ * @param  Ypos:  specifies the Y position.
+ * @param  Xsize: specifies the X size
+ * @param  Ysize: specifies the Y size
+ * @param  Index: palette index
+ * @retval None
+ */
+void ST7796_IndexFillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint8_t Index) {
+	uint16_t y;
+	if (!IndexClip(&Xpos, &Ypos, &Xsize, &Ysize))
+		return;
+	for (y = Ypos; y < Ypos + Ysize; y++)
+		IndexSetRow(Xpos, y, Xsize, Index);
+	IndexMark(Xpos, Ypos, Xsize, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw an indexed picture
+ * @param  Xpos:  Image X position in the LCD
+ * @param  Ypos:  Image Y position in the LCD
+ * @param  Xsize: Image X size in the LCD
+ * @param  Ysize: Image Y size in the LCD
+ * @param  pData: picture address (one palette index / byte)
+ * @retval None
+ */
+void ST7796_IndexDrawImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, const uint8_t *pData) {
+	uint16_t y, w = Xsize;
+#if ST7796_INDEX_BPP == 4
+	uint16_t x;
+#endif
+	if (!IndexClip(&Xpos, &Ypos, &w, &Ysize))
+		return;
+	for (y = 0; y < Ysize; y++, pData += Xsize) {
+#if ST7796_INDEX_BPP == 8
+		memcpy(&indexframe[(Ypos + y) * INDEX_PITCH + Xpos], pData, w);
+#else
+		for (x = 0; x < w; x++)
+			IndexSetRow(Xpos + x, Ypos + y, 1, pData[x]);
+#endif
+	}
+	IndexMark(Xpos, Ypos, w, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Send the dirty rectangle (one window, the line buffer chunks
+ *         continue at the memory pointer)
+ * @param  None
+ * @retval number of sent pixels
+ */
+uint32_t ST7796_IndexFlush(void) {
+	uint16_t x, y, w;
+	uint32_t chunk, n, total, len, left, seg;
+#if ST7796_WRITEBITDEPTH == 24
+	uint8_t *p;
+	chunk = indexbufsize * 2 / 3; /* 3 bus bytes / pixel */
+#else
+	uint16_t *p;
+	chunk = indexbufsize;
+#endif
+	if ((indexx0 >= indexx1) || (indexframe == NULL) || (chunk == 0))
+		return 0;
+	x = indexx0;
+	y = indexy0;
+	w = indexx1 - indexx0;
+	total = (uint32_t) w * (indexy1 - indexy0);
+	ST7796_Sync();
+	ST7796_SetWriteWindow(indexx0, indexy0, w, indexy1 - indexy0);
+#if ST7796_WRITEBITDEPTH == 24
+	/* the 24 bit chunks bypass LCD_IO_DrawBitmap and its COLMOD switch */
+	SetWriteDir();
+#endif
+	for (n = 0; n < total; n += len) {
+		len = (total - n > chunk) ? chunk : total - n;
+		/* fill the chunk with row segments */
+#if ST7796_WRITEBITDEPTH == 24
+		p = (uint8_t *) indexbuf;
+#else
+		p = indexbuf;
+#endif
+		for (left = len; left; left -= seg) {
+			seg = indexx1 - x;
+			if (seg > left)
+				seg = left;
+			p = IndexExpandRow(p, x, y, seg);
+			x += seg;
+			if (x == indexx1) {
+				x = indexx0;
+				y++;
+			}
+		}
+#if ST7796_WRITEBITDEPTH == 24
+		LCD_IO_WriteCmd8MultipleData8(n ? ST7796_WRITE_RAM_CONT : ST7796_WRITE_RAM,
+				(uint8_t *) indexbuf, len * 3);
+#else
+		if (n == 0) {
+			LCD_IO_DrawBitmap(indexbuf, len);
+		} else {
+			LCD_IO_DrawBitmapCont(indexbuf, len);
+		}
+#endif
+	}
+	indexx0 = indexx1 = 0;
+	return total;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
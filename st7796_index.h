@@ -0,0 +1,55 @@
+/**
+ ******************************************************************************
+ * @file    st7796_index.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 indexed color
+ *          (palette) framebuffer.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_INDEX_H
+#define ST7796_INDEX_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Framebuffer size [byte] (ST7796_INDEX_BPP bits / pixel in rows of the
+   current orientation, with 4 bits the left pixel of a byte is the high
+   nibble) */
+#define ST7796_INDEX_FRAMESIZE  (ST7796_LCD_PIXEL_WIDTH * ST7796_LCD_PIXEL_HEIGHT * ST7796_INDEX_BPP / 8)
+
+//-----------------------------------------------------------------------------
+/* The drawing functions only change the index framebuffer and grow the
+   dirty rectangle, ST7796_IndexFlush expands the dirty rectangle through
+   the palette into the line buffer (Size pixels) and sends it. A palette
+   change marks the full screen (palette animation: set the palette and
+   flush again). After a direct change of the framebuffer, call
+   ST7796_IndexMarkDirty for the changed area. */
+void ST7796_IndexInit(uint8_t *pFrame, uint16_t *pBuffer, uint32_t Size);
+uint8_t * ST7796_IndexGetFrame(void); /* ST7796_SIZE_X * ST7796_INDEX_BPP / 8 bytes / row */
+void ST7796_IndexSetPalette(uint16_t First, uint16_t Count, const uint16_t *pRGB);
+void ST7796_IndexMarkDirty(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize);
+void ST7796_IndexWritePixel(uint16_t Xpos, uint16_t Ypos, uint8_t Index);
+uint8_t ST7796_IndexReadPixel(uint16_t Xpos, uint16_t Ypos);
+void ST7796_IndexDrawHLine(uint8_t Index, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_IndexDrawVLine(uint8_t Index, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_IndexFillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint8_t Index);
+/* pData: one index / byte */
+void ST7796_IndexDrawImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, const uint8_t *pData);
+uint32_t ST7796_IndexFlush(void);
+
+#endif /* ST7796_INDEX_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,155 @@
+/**
+ ******************************************************************************
+ * @file    st7796_power.c
+ * @author  MCD Application Team
+ * @brief   Power profiles for the st7796 driver (always on status displays).
+ *          The panel scans only the partial display area (PTLAR, PTLON),
+ *          the 8 color idle mode (IDMON) is switched on when the content
+ *          allows it, and the partial / idle mode frame rate (FRMCTR3,
+ *          FRMCTR2) can be lowered.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_power.h"
+
+static uint16_t *powerbuf;
+static uint32_t powerbufsize;
+/* partial display area in screen lines (size 0: full screen) */
+static uint16_t powerstart, powersize;
+static uint8_t powercolumns;       /* 1: the gate lines are screen columns */
+
+//-----------------------------------------------------------------------------
+/* Every pixel of the rectangle is an idle color (the display content) */
+static uint8_t PowerIdleContent(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	uint32_t i, h;
+	if ((powerbuf == NULL) || (powerbufsize < Xsize))
+		return 0;
+	for (; Ysize; Ysize -= h, Ypos += h) {
+		h = (Ysize > powerbufsize / Xsize) ? powerbufsize / Xsize : Ysize;
+		ST7796_ReadRGBImage(Xpos, Ypos, Xsize, h, powerbuf);
+		for (i = 0; i < Xsize * h; i++)
+			if (!ST7796_POWER_IDLECOLOR(powerbuf[i]))
+				return 0;
+	}
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the readback buffer of the automatic idle mode
+ * @param  pBuffer: buffer
+ * @param  Size:    buffer size [pixel]
+ * @retval None
+ */
+void ST7796_PowerInit(uint16_t *pBuffer, uint32_t Size) {
+	powerbuf = pBuffer;
+	powerbufsize = Size;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the power profile
+ * @param  pProfile: profile (NULL: full screen, normal mode)
+ * @retval 1: idle mode on, 0: off
+ */
+uint8_t ST7796_PowerSetProfile(const ST7796_PowerProfileTypeDef *pProfile) {
+	uint8_t mad = ST7796_MAD_DATA_RIGHT_THEN_DOWN, idle = 0;
+	uint16_t lines, first, last;
+	uint8_t ptlar[4];
+	ST7796_Sync();
+	powercolumns = (mad & ST7796_MAD_VERTICAL) ? 1 : 0;
+	lines = powercolumns ? ST7796_SIZE_X : ST7796_SIZE_Y;
+	powerstart = 0;
+	powersize = 0;
+	if (pProfile && pProfile->Size && (pProfile->Start < lines)) {
+		powerstart = pProfile->Start;
+		powersize = (pProfile->Size > lines - powerstart) ?
+				lines - powerstart : pProfile->Size;
+		/* screen lines -> frame memory rows (mirrored with MY) */
+		if (mad & ST7796_MAD_Y_DOWN) {
+			first = lines - powerstart - powersize;
+			last = lines - 1 - powerstart;
+		} else {
+			first = powerstart;
+			last = powerstart + powersize - 1;
+		}
+		ptlar[0] = first >> 8;
+		ptlar[1] = first;
+		ptlar[2] = last >> 8;
+		ptlar[3] = last;
+		LCD_IO_WriteCmd8MultipleData8(ST7796_PTLAR, ptlar, 4);
+		LCD_IO_WriteCmd8MultipleData8(ST7796_PARTIAL_DISPLAY_ON, NULL, 0);
+	} else
+		LCD_IO_WriteCmd8MultipleData8(ST7796_NORMAL_DISPLAY_OFF, NULL, 0);
+
+	/* the normal mode frame rate is the ST7796_TE_FRMCTR1 setting */
+	LCD_IO_WriteCmd8MultipleData8(ST7796_FRAME_RATE_CTRL2, (uint8_t *)
+			((pProfile && pProfile->LowRate) ? ST7796_POWER_FRMCTR : ST7796_TE_FRMCTR1), 2);
+	LCD_IO_WriteCmd8MultipleData8(ST7796_FRAME_RATE_CTRL3, (uint8_t *)
+			((pProfile && pProfile->LowRate) ? ST7796_POWER_FRMCTR : ST7796_TE_FRMCTR1), 2);
+
+	if (pProfile && (pProfile->Idle == ST7796_POWER_IDLE_ON))
+		idle = 1;
+	else if (pProfile && (pProfile->Idle == ST7796_POWER_IDLE_AUTO)) {
+		if (powersize == 0)
+			idle = PowerIdleContent(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y);
+		else if (powercolumns)
+			idle = PowerIdleContent(powerstart, 0, powersize, ST7796_SIZE_Y);
+		else
+			idle = PowerIdleContent(0, powerstart, ST7796_SIZE_X, powersize);
+	}
+	LCD_IO_WriteCmd8MultipleData8(idle ? ST7796_IDLE_MODE_ON : ST7796_IDLE_MODE_OFF,
+			NULL, 0);
+	return idle;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Clip a rectangle to the partial display area
+ * @param  pX: X position
+ * @param  pY: Y position
+ * @param  pW: X size (NULL: 1 pixel)
+ * @param  pH: Y size (NULL: 1 pixel)
+ * @retval 0: outside of the area, 1: something to draw
+ */
+uint8_t ST7796_PowerClip(uint16_t *pX, uint16_t *pY, uint16_t *pW, uint16_t *pH) {
+	uint16_t one = 1, *pPos, *pSize;
+	if (powersize == 0)
+		return 1;
+	if (powercolumns) {
+		pPos = pX;
+		pSize = pW ? pW : &one;
+	} else {
+		pPos = pY;
+		pSize = pH ? pH : &one;
+	}
+	if ((*pSize == 0) || (*pPos >= powerstart + powersize)
+			|| ((uint32_t) *pPos + *pSize <= powerstart))
+		return 0;
+	if (*pPos < powerstart) {
+		*pSize -= powerstart - *pPos;
+		*pPos = powerstart;
+	}
+	if (*pSize > powerstart + powersize - *pPos)
+		*pSize = powerstart + powersize - *pPos;
+	return 1;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
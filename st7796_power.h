@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ * @file    st7796_power.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 power profiles
+ *          (partial display area, 8 color idle mode, reduced frame rate).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_POWER_H
+#define ST7796_POWER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Idle mode of a profile */
+#define ST7796_POWER_IDLE_OFF     0
+#define ST7796_POWER_IDLE_ON      1
+#define ST7796_POWER_IDLE_AUTO    2  /* on if every displayed pixel is an idle color */
+
+/* The 8 colors of the idle mode (every channel is 0 or full) */
+#define ST7796_POWER_IDLECOLOR(c) \
+  (((((c) & 0xF800) == 0) || (((c) & 0xF800) == 0xF800)) && \
+   ((((c) & 0x07E0) == 0) || (((c) & 0x07E0) == 0x07E0)) && \
+   ((((c) & 0x001F) == 0) || (((c) & 0x001F) == 0x001F)))
+
+/**
+ * @brief  Power profile
+ *         The partial display area is a band of gate lines: screen rows in
+ *         portrait, screen columns in landscape orientation. The rest of
+ *         the screen is black and not refreshed.
+ */
+typedef struct {
+	uint16_t Start;                /* first screen row (landscape: column) of the displayed band */
+	uint16_t Size;                 /* rows (columns) of the band (0: full screen, normal mode) */
+	uint8_t Idle;                  /* ST7796_POWER_IDLE_OFF, _ON, _AUTO */
+	uint8_t LowRate;               /* 1: ST7796_POWER_FRMCTR frame rate in the partial and idle mode */
+} ST7796_PowerProfileTypeDef;
+
+//-----------------------------------------------------------------------------
+/* Readback buffer of the ST7796_POWER_IDLE_AUTO content check (at least
+   one screen row, NULL: the automatic idle mode stays off) */
+void ST7796_PowerInit(uint16_t *pBuffer, uint32_t Size);
+
+/* Set the profile (NULL: full screen, normal mode and frame rate), returns
+   1 if the idle mode is on. Set it again after an orientation change. */
+uint8_t ST7796_PowerSetProfile(const ST7796_PowerProfileTypeDef *pProfile);
+
+/* Clip a rectangle to the partial display area (pW, pH: NULL = 1 pixel),
+   0: nothing left. With ST7796_POWER == 1 the st7796_drv drawing functions
+   use it, the driver modules (shadow, band, blend ...) draw everywhere. */
+uint8_t ST7796_PowerClip(uint16_t *pX, uint16_t *pY, uint16_t *pW, uint16_t *pH);
+
+#endif /* ST7796_POWER_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
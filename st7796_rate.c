@@ -0,0 +1,150 @@
+/**
+ ******************************************************************************
+ * @file    st7796_rate.c
+ * @author  MCD Application Team
+ * @brief   Adaptive frame rate control for the st7796 driver. The presented
+ *          frames are counted in ST7796_RATE_WINDOWMS windows, the refresh
+ *          rate (FRMCTR1) and the inversion mode (INVCTR) step up at once
+ *          when the application presents faster than ST7796_RATE_UP % of
+ *          the refresh rate (animations) and step down after
+ *          ST7796_RATE_HOLD slow windows (static screens: less power and
+ *          less interference with the analog parts of the board).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_rate.h"
+
+#define RATE_STEPS       (sizeof(ratehz) / sizeof(ratehz[0]))
+
+static const uint8_t ratesteps[] = ST7796_RATE_STEPS;
+static const uint16_t ratehz[] = { ST7796_RATE_HZ };
+
+static const ST7796_RateSourceTypeDef *ratesrc;
+static ST7796_RateStatTypeDef ratestat;
+static uint32_t ratewindowstart;
+static uint32_t ratewindowframes;
+static uint8_t ratehold;
+
+//-----------------------------------------------------------------------------
+/* Program a step */
+static void RateSetStep(uint8_t Step) {
+	ST7796_Sync();
+	LCD_IO_WriteCmd8MultipleData8(ST7796_FRAME_RATE_CTRL1,
+			(uint8_t *) &ratesteps[Step * 3], 2);
+	LCD_IO_WriteCmd8MultipleData8(ST7796_INV_CTRL,
+			(uint8_t *) &ratesteps[Step * 3 + 2], 1);
+	ratestat.Step = Step;
+	ratestat.Hz = ratehz[Step];
+	ratehold = 0;
+	if (ratesrc->RateChanged)
+		ratesrc->RateChanged(1000000U / ratehz[Step]);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Start the rate control at the fastest step
+ * @param  pSource: time source
+ * @retval None
+ */
+void ST7796_RateInit(const ST7796_RateSourceTypeDef *pSource) {
+	ratesrc = pSource;
+	ratestat.Frames = 0;
+	ratestat.Ups = 0;
+	ratestat.Downs = 0;
+	ratestat.PresentHz = 0;
+	ratewindowstart = ratesrc->GetTimeUs();
+	ratewindowframes = 0;
+	RateSetStep(RATE_STEPS - 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Count a presented frame
+ * @param  None
+ * @retval None
+ */
+void ST7796_RateFrame(void) {
+	ratewindowframes++;
+	ratestat.Frames++;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Measure the presented frame rate at the end of the window and
+ *         change the refresh rate step if needed
+ * @param  None
+ * @retval 1: the step has changed, 0: no change
+ */
+uint8_t ST7796_RateTask(void) {
+	uint32_t elapsed, step;
+	uint64_t present;              /* presented frames / s * 100 */
+	if (!ratesrc)
+		return 0;
+	elapsed = ratesrc->GetTimeUs() - ratewindowstart;
+	if (elapsed < ST7796_RATE_WINDOWMS * 1000U)
+		return 0;
+	present = (uint64_t) ratewindowframes * 100000000U / elapsed;
+	ratestat.PresentHz = present / 100;
+	ratewindowstart += elapsed;
+	ratewindowframes = 0;
+
+	step = ratestat.Step;
+	if ((step < RATE_STEPS - 1)
+			&& (present > (uint64_t) ratehz[step] * ST7796_RATE_UP)) {
+		/* up at once: the slowest step with enough headroom */
+		while ((step < RATE_STEPS - 1)
+				&& (present > (uint64_t) ratehz[step] * ST7796_RATE_UP))
+			step++;
+		RateSetStep(step);
+		ratestat.Ups++;
+		return 1;
+	}
+	if (step && (present <= (uint64_t) ratehz[step - 1] * ST7796_RATE_DOWN)) {
+		/* down one step after ST7796_RATE_HOLD slow windows */
+		if (++ratehold >= ST7796_RATE_HOLD) {
+			RateSetStep(step - 1);
+			ratestat.Downs++;
+			return 1;
+		}
+	} else
+		ratehold = 0;
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the refresh rate
+ * @param  None
+ * @retval refresh rate of the current step [Hz]
+ */
+uint16_t ST7796_RateGetHz(void) {
+	return ratestat.Hz;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the rate control state
+ * @param  None
+ * @retval state
+ */
+const ST7796_RateStatTypeDef * ST7796_RateGetStat(void) {
+	return &ratestat;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
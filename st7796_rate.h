@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * @file    st7796_rate.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 adaptive frame
+ *          rate control (the refresh rate follows the presented frames).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_RATE_H
+#define ST7796_RATE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/**
+ * @brief  Time source and rate change notification
+ */
+typedef struct {
+	uint32_t (*GetTimeUs)(void);   /* free running microsecond counter */
+	void (*RateChanged)(uint32_t FrameUs); /* new refresh period (NULL: none, e.g. ST7796_TeSetFrameUs) */
+} ST7796_RateSourceTypeDef;
+
+/**
+ * @brief  Rate control state
+ */
+typedef struct {
+	uint8_t Step;                  /* current step (0: slowest) */
+	uint16_t Hz;                   /* refresh rate of the step [Hz] */
+	uint16_t PresentHz;            /* presented frames / s in the last window */
+	uint32_t Frames;               /* presented frames */
+	uint32_t Ups, Downs;           /* step changes */
+} ST7796_RateStatTypeDef;
+
+//-----------------------------------------------------------------------------
+/* Start with the fastest step. ST7796_RateFrame is called for every
+   presented frame, ST7796_RateTask periodically (at least once / window,
+   also when nothing is drawn: the static screens are detected here). */
+void ST7796_RateInit(const ST7796_RateSourceTypeDef *pSource);
+void ST7796_RateFrame(void);
+uint8_t ST7796_RateTask(void);
+uint16_t ST7796_RateGetHz(void);
+const ST7796_RateStatTypeDef * ST7796_RateGetStat(void);
+
+#endif /* ST7796_RATE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -58,6 +58,8 @@
 #define ST7796_IDLE_MODE_OFF                0x38U  /* Idle mode off: IDMOFF                       */
 #define ST7796_IDLE_MODE_ON                 0x39U  /* Idle mode on: IDMON                         */
 #define ST7796_COLOR_MODE                   0x3AU  /* Interface pixel format: COLMOD              */
+#define ST7796_WRITE_RAM_CONT               0x3CU  /* Memory write continue: WRMEMC               */
+#define ST7796_READ_RAM_CONT                0x3EU  /* Memory read continue: RDMEMC                */
 #define ST7796_FRAME_RATE_CTRL1             0xB1U  /* In normal mode (Full colors): FRMCTR1       */
 #define ST7796_FRAME_RATE_CTRL2             0xB2U  /* In Idle mode (8-colors): FRMCTR2            */
 #define ST7796_FRAME_RATE_CTRL3             0xB3U  /* In partial mode + Full colors: FRMCTR3      */
@@ -98,35 +100,32 @@
 #define ST7796_MAD_COLORMODE  ST7796_MAD_BGR
 #endif
 
-#if (ST7796_ORIENTATION == 0)
-#define ST7796_SIZE_X                     ST7796_LCD_PIXEL_WIDTH
-#define ST7796_SIZE_Y                     ST7796_LCD_PIXEL_HEIGHT
-#define ST7796_MAD_DATA_RIGHT_THEN_UP     (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_UP | ST7796_MAD_HORIZONTAL)
-#define ST7796_MAD_DATA_RIGHT_THEN_DOWN   (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_DOWN | ST7796_MAD_HORIZONTAL)
-#define XSIZE                              Xsize
-#define YSIZE                              Ysize
-#elif (ST7796_ORIENTATION == 1)
-#define ST7796_SIZE_X                     ST7796_LCD_PIXEL_HEIGHT
-#define ST7796_SIZE_Y                     ST7796_LCD_PIXEL_WIDTH
-#define ST7796_MAD_DATA_RIGHT_THEN_UP     (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_DOWN | ST7796_MAD_VERTICAL)
-#define ST7796_MAD_DATA_RIGHT_THEN_DOWN   (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_DOWN | ST7796_MAD_VERTICAL)
-#define XSIZE                              Ysize
-#define YSIZE                              Xsize
-#elif (ST7796_ORIENTATION == 2)
-#define ST7796_SIZE_X                     ST7796_LCD_PIXEL_WIDTH
-#define ST7796_SIZE_Y                     ST7796_LCD_PIXEL_HEIGHT
-#define ST7796_MAD_DATA_RIGHT_THEN_UP     (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_DOWN | ST7796_MAD_HORIZONTAL)
-#define ST7796_MAD_DATA_RIGHT_THEN_DOWN   (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_UP | ST7796_MAD_HORIZONTAL)
-#define XSIZE                              Xsize
-#define YSIZE                              Ysize
-#elif (ST7796_ORIENTATION == 3)
-#define ST7796_SIZE_X                     ST7796_LCD_PIXEL_HEIGHT
-#define ST7796_SIZE_Y                     ST7796_LCD_PIXEL_WIDTH
-#define ST7796_MAD_DATA_RIGHT_THEN_UP     (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_UP | ST7796_MAD_VERTICAL)
-#define ST7796_MAD_DATA_RIGHT_THEN_DOWN   (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_UP | ST7796_MAD_VERTICAL)
-#define XSIZE                              Ysize
-#define YSIZE                              Xsize
-#endif
+/* Drawing directions of the orientations 0 .. 3 */
+#define ST7796_MAD_RIGHT_THEN_UP_0        (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_UP | ST7796_MAD_HORIZONTAL)
+#define ST7796_MAD_RIGHT_THEN_DOWN_0      (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_DOWN | ST7796_MAD_HORIZONTAL)
+#define ST7796_MAD_RIGHT_THEN_UP_1        (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_DOWN | ST7796_MAD_VERTICAL)
+#define ST7796_MAD_RIGHT_THEN_DOWN_1      (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_DOWN | ST7796_MAD_VERTICAL)
+#define ST7796_MAD_RIGHT_THEN_UP_2        (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_DOWN | ST7796_MAD_HORIZONTAL)
+#define ST7796_MAD_RIGHT_THEN_DOWN_2      (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_UP | ST7796_MAD_HORIZONTAL)
+#define ST7796_MAD_RIGHT_THEN_UP_3        (ST7796_MAD_COLORMODE | ST7796_MAD_X_LEFT  | ST7796_MAD_Y_UP | ST7796_MAD_VERTICAL)
+#define ST7796_MAD_RIGHT_THEN_DOWN_3      (ST7796_MAD_COLORMODE | ST7796_MAD_X_RIGHT | ST7796_MAD_Y_UP | ST7796_MAD_VERTICAL)
+
+/* The orientation is a runtime setting of the panel (ST7796_SetOrientation,
+   the start value is ST7796_ORIENTATION), the screen size and the drawing
+   directions are looked up from it */
+extern const uint8_t ST7796_MadRightThenUp[4];
+extern const uint8_t ST7796_MadRightThenDown[4];
+
+#define ST7796_PANEL_SIZE_X(h)                 (((h)->Orientation & 1) ? ST7796_LCD_PIXEL_HEIGHT : ST7796_LCD_PIXEL_WIDTH)
+#define ST7796_PANEL_SIZE_Y(h)                 (((h)->Orientation & 1) ? ST7796_LCD_PIXEL_WIDTH : ST7796_LCD_PIXEL_HEIGHT)
+#define ST7796_PANEL_MAD_RIGHT_THEN_UP(h)      ST7796_MadRightThenUp[(h)->Orientation]
+#define ST7796_PANEL_MAD_RIGHT_THEN_DOWN(h)    ST7796_MadRightThenDown[(h)->Orientation]
+
+/* the same on the single panel interface panel (hst7796) */
+#define ST7796_SIZE_X                     ST7796_PANEL_SIZE_X(&hst7796)
+#define ST7796_SIZE_Y                     ST7796_PANEL_SIZE_Y(&hst7796)
+#define ST7796_MAD_DATA_RIGHT_THEN_UP     ST7796_PANEL_MAD_RIGHT_THEN_UP(&hst7796)
+#define ST7796_MAD_DATA_RIGHT_THEN_DOWN   ST7796_PANEL_MAD_RIGHT_THEN_DOWN(&hst7796)
 
 #endif /* ST7796_REG_H */
 
@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @file    st7796_scatter.c
+ * @author  MCD Application Team
+ * @brief   Batched scatter pixel writer for the st7796 driver (chart and
+ *          scatter plots). Instead of one CASET, RASET and RAMWR / pixel,
+ *          the points are sorted by row with a radix sort (three passes of
+ *          6 bit digits over the row and column, the histograms of every
+ *          pass are counted in one sequential pass), the neighbouring
+ *          pixels of a row are written as one run and the runs of the
+ *          following rows covering the same columns are appended to the same
+ *          window (the address counter continues in the next row).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_scatter.h"
+#if ST7796_ASYNC == 1
+#include "st7796_async.h"
+#define SCATTER_CHUNK    (ST7796_SCATTER_BUFFER / 2)
+#else
+#define SCATTER_CHUNK    ST7796_SCATTER_BUFFER
+#endif
+
+/* Sort key: row * 512 + column (18 bit) */
+#define SCATTER_RADIX    6
+#define SCATTER_PASSES   3
+#define SCATTER_BUCKETS  (1 << SCATTER_RADIX)
+#define SCATTER_ROW      512
+#define SCATTER_DONE     0x80000000U   /* entry flag: written with a previous row */
+#define SCATTER_KEY(e)   (((uint32_t) scatterpts[(e) & ~SCATTER_DONE].Y * SCATTER_ROW) \
+                          + scatterpts[(e) & ~SCATTER_DONE].X)
+
+static uint32_t *scatterwork;
+static uint32_t scatterbatch;          /* points / batch */
+static uint32_t scatterhist[SCATTER_PASSES][SCATTER_BUCKETS];
+static const ST7796_PointTypeDef *scatterpts;
+
+static uint16_t scatterbuf[ST7796_SCATTER_BUFFER];
+static uint16_t *scatterchunk;         /* chunk under filling */
+static uint16_t scattercnt;            /* pixels in the chunk */
+#if ST7796_ASYNC == 1
+static volatile uint8_t scatterbusy[2]; /* 1: the chunk is queued or on the wire */
+static uint8_t scatteridx = 0;
+#else
+static uint8_t scatterfirst;           /* 1: the next transfer starts the window */
+#endif
+
+#if ST7796_ASYNC == 1
+//-----------------------------------------------------------------------------
+/* Queue the pixels and continue in the other half of the buffer */
+static void ScatterFlush(void) {
+	if (!scattercnt)
+		return;
+	ST7796_AsyncWriteChunk(scatterchunk, scattercnt, scatterbusy, scatteridx);
+	scatteridx ^= 1;
+	scatterchunk = &scatterbuf[scatteridx * SCATTER_CHUNK];
+	scattercnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Open the window of a run (the rows of the window below are filled by the
+   following runs with the same columns) */
+static void ScatterWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize) {
+	ST7796_SetWriteWindowAsync(Xpos, Ypos, Xsize, ST7796_SIZE_Y - Ypos);
+	scatterchunk = &scatterbuf[scatteridx * SCATTER_CHUNK];
+	scattercnt = 0;
+}
+
+#else /* #if ST7796_ASYNC == 1 */
+//-----------------------------------------------------------------------------
+/* Send the pixels */
+static void ScatterFlush(void) {
+	if (!scattercnt)
+		return;
+	if (scatterfirst) {
+		LCD_IO_DrawBitmap(scatterchunk, scattercnt);
+	} else {
+		LCD_IO_DrawBitmapCont(scatterchunk, scattercnt);
+	}
+	scatterfirst = 0;
+	scattercnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Open the window of a run (the rows of the window below are filled by the
+   following runs with the same columns) */
+static void ScatterWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize) {
+	ST7796_SetWriteWindow(Xpos, Ypos, Xsize, ST7796_SIZE_Y - Ypos);
+	scatterchunk = scatterbuf;
+	scattercnt = 0;
+	scatterfirst = 1;
+}
+#endif /* #else ST7796_ASYNC == 1 */
+
+//-----------------------------------------------------------------------------
+/* Add the colors of Num sorted entries */
+static void ScatterPut(const uint32_t *pEntry, const uint16_t *pColors,
+		uint32_t Num) {
+	while (Num--) {
+		scatterchunk[scattercnt++] = pColors[*pEntry++ & ~SCATTER_DONE];
+		if (scattercnt >= SCATTER_CHUNK)
+			ScatterFlush();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Sort the entries by the key (stable: the later of two equal points stays
+   behind), retval the sorted half of the work buffer */
+static uint32_t * ScatterSort(uint32_t *pSrc, uint32_t *pDst, uint32_t Num) {
+	uint32_t i, k, p, sum, *t;
+	memset(scatterhist, 0, sizeof(scatterhist));
+	for (i = 0; i < Num; i++) {
+		k = SCATTER_KEY(pSrc[i]);
+		for (p = 0; p < SCATTER_PASSES; p++, k >>= SCATTER_RADIX)
+			scatterhist[p][k & (SCATTER_BUCKETS - 1)]++;
+	}
+	for (p = 0; p < SCATTER_PASSES; p++) {
+		/* the digit is the same everywhere (e.g. the points of a few rows) */
+		k = (SCATTER_KEY(pSrc[0]) >> (p * SCATTER_RADIX)) & (SCATTER_BUCKETS - 1);
+		if (scatterhist[p][k] == Num)
+			continue;
+		for (sum = 0, i = 0; i < SCATTER_BUCKETS; i++) {
+			k = scatterhist[p][i];
+			scatterhist[p][i] = sum;
+			sum += k;
+		}
+		for (i = 0; i < Num; i++) {
+			k = (SCATTER_KEY(pSrc[i]) >> (p * SCATTER_RADIX)) & (SCATTER_BUCKETS - 1);
+			pDst[scatterhist[p][k]++] = pSrc[i];
+		}
+		t = pSrc;
+		pSrc = pDst;
+		pDst = t;
+	}
+	return pSrc;
+}
+
+//-----------------------------------------------------------------------------
+/* First entry at or after From with a key not less than Key */
+static uint32_t ScatterFind(const uint32_t *pEntry, uint32_t From, uint32_t Num,
+		uint32_t Key) {
+	uint32_t m;
+	while (From < Num) {
+		m = From + (Num - From) / 2;
+		if (SCATTER_KEY(pEntry[m]) < Key)
+			From = m + 1;
+		else
+			Num = m;
+	}
+	return From;
+}
+
+//-----------------------------------------------------------------------------
+/* Write one batch of points */
+static void ScatterBatch(const uint16_t *pColors, uint32_t Num) {
+	uint32_t *e = scatterwork, i, n = 0, w, k, p, key;
+	/* drop the points outside of the screen */
+	for (i = 0; i < Num; i++)
+		if ((scatterpts[i].X < ST7796_SIZE_X) && (scatterpts[i].Y < ST7796_SIZE_Y))
+			e[n++] = i;
+	if (!n)
+		return;
+	e = ScatterSort(e, e + scatterbatch, n);
+	/* one entry / pixel: the last point wins */
+	for (i = 0, Num = 0; i < n; i++)
+		if ((i + 1 == n) || (SCATTER_KEY(e[i]) != SCATTER_KEY(e[i + 1])))
+			e[Num++] = e[i];
+
+	for (i = 0; i < Num; i += w) {
+		if (e[i] & SCATTER_DONE) {
+			w = 1;
+			continue;
+		}
+		key = SCATTER_KEY(e[i]);
+		for (w = 1; (i + w < Num) && !(e[i + w] & SCATTER_DONE)
+				&& (SCATTER_KEY(e[i + w]) == key + w); w++);
+		ScatterWindow(key % SCATTER_ROW, key / SCATTER_ROW, w);
+		ScatterPut(&e[i], pColors, w);
+		/* the same columns on the next rows */
+		for (p = i + w;;) {
+			key += SCATTER_ROW;
+			p = ScatterFind(e, p, Num, key);
+			if ((p + w > Num) || (SCATTER_KEY(e[p]) != key)
+					|| (SCATTER_KEY(e[p + w - 1]) != key + w - 1))
+				break;
+			for (k = 0; (k < w) && !(e[p + k] & SCATTER_DONE); k++);
+			if (k < w)
+				break;
+			ScatterPut(&e[p], pColors, w);
+			for (k = 0; k < w; k++)
+				e[p + k] |= SCATTER_DONE;
+		}
+		ScatterFlush();
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the work buffer of the point sort
+ * @param  pWork: work buffer (NULL: no sort)
+ * @param  Size:  work buffer size [entry] (2 / point)
+ * @retval None
+ */
+void ST7796_ScatterInit(uint32_t *pWork, uint32_t Size) {
+	scatterwork = pWork;
+	scatterbatch = pWork ? Size / 2 : 0;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Write a list of pixels
+ * @param  pPoints: pixel positions
+ * @param  pColors: pixel colors (one / point)
+ * @param  Num:     number of points
+ * @retval None
+ */
+void ST7796_WritePixels(const ST7796_PointTypeDef *pPoints,
+		const uint16_t *pColors, uint32_t Num) {
+	uint32_t n;
+	if (!scatterbatch) {
+		for (n = 0; n < Num; n++)
+			ST7796_WritePixel(pPoints[n].X, pPoints[n].Y, pColors[n]);
+		return;
+	}
+	ST7796_Sync();
+	while (Num) {
+		n = (Num < scatterbatch) ? Num : scatterbatch;
+		scatterpts = pPoints;
+		ScatterBatch(pColors, n);
+		pPoints += n;
+		pColors += n;
+		Num -= n;
+	}
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
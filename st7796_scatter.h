@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ * @file    st7796_scatter.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 batched scatter
+ *          pixel writer.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_SCATTER_H
+#define ST7796_SCATTER_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/**
+ * @brief  Pixel position
+ */
+typedef struct {
+	uint16_t X;
+	uint16_t Y;
+} ST7796_PointTypeDef;
+
+//-----------------------------------------------------------------------------
+/* Work buffer: 2 entries / point, a longer point list is drawn in batches of
+   Size / 2 points. Without a work buffer ST7796_WritePixels writes the
+   points one by one. */
+void ST7796_ScatterInit(uint32_t *pWork, uint32_t Size);
+
+/* The points are sorted by row, the pixels of a point which is drawn more
+   than once get the color of the last one, the horizontal runs of
+   neighbouring points are written through one window and the runs
+   continuing on the next rows with the same columns (dense blocks) through
+   the same window. The points outside of the screen are dropped. */
+void ST7796_WritePixels(const ST7796_PointTypeDef *pPoints,
+		const uint16_t *pColors, uint32_t Num);
+
+#endif /* ST7796_SCATTER_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
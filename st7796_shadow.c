@@ -0,0 +1,280 @@
+/**
+ ******************************************************************************
+ * @file    st7796_shadow.c
+ * @author  MCD Application Team
+ * @brief   Shadow framebuffer for the st7796 driver. The screen is split into
+ *          ST7796_SHADOW_TILE sized tiles, the drawing functions mark the
+ *          touched tiles in a bitmap and the flush sends only the dirty
+ *          tiles, merged into rectangles by the ST7796_SHADOW_MERGE policy.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_shadow.h"
+
+#define SHADOW_TX        ((ST7796_SIZE_X + ST7796_SHADOW_TILE - 1) / ST7796_SHADOW_TILE)
+#define SHADOW_TY        ((ST7796_SIZE_Y + ST7796_SHADOW_TILE - 1) / ST7796_SHADOW_TILE)
+
+#define SHADOW_DIRTY(tx, ty)    (shadowdirty[((ty) * SHADOW_TX + (tx)) >> 5] & (1UL << (((ty) * SHADOW_TX + (tx)) & 31)))
+#define SHADOW_SETDIRTY(tx, ty)   shadowdirty[((ty) * SHADOW_TX + (tx)) >> 5] |= (1UL << (((ty) * SHADOW_TX + (tx)) & 31))
+#define SHADOW_CLRDIRTY(tx, ty)   shadowdirty[((ty) * SHADOW_TX + (tx)) >> 5] &= ~(1UL << (((ty) * SHADOW_TX + (tx)) & 31))
+
+static uint16_t *shadowbuf;
+/* the tile count is the same in every orientation */
+static uint32_t shadowdirty[(((ST7796_LCD_PIXEL_WIDTH + ST7796_SHADOW_TILE - 1) / ST7796_SHADOW_TILE)
+		* ((ST7796_LCD_PIXEL_HEIGHT + ST7796_SHADOW_TILE - 1) / ST7796_SHADOW_TILE) + 31) / 32];
+
+//-----------------------------------------------------------------------------
+/* Clip a rectangle to the screen (0: nothing left) */
+static uint8_t ShadowClip(uint16_t *pX, uint16_t *pY, uint16_t *pW,
+		uint16_t *pH) {
+	if ((*pX >= ST7796_SIZE_X) || (*pY >= ST7796_SIZE_Y) || (*pW == 0)
+			|| (*pH == 0))
+		return 0;
+	if (*pW > ST7796_SIZE_X - *pX)
+		*pW = ST7796_SIZE_X - *pX;
+	if (*pH > ST7796_SIZE_Y - *pY)
+		*pH = ST7796_SIZE_Y - *pY;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Mark the tiles of an already clipped rectangle */
+static void ShadowMark(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	uint16_t tx, ty;
+	for (ty = Ypos / ST7796_SHADOW_TILE;
+			ty <= (Ypos + Ysize - 1) / ST7796_SHADOW_TILE; ty++)
+		for (tx = Xpos / ST7796_SHADOW_TILE;
+				tx <= (Xpos + Xsize - 1) / ST7796_SHADOW_TILE; tx++)
+			SHADOW_SETDIRTY(tx, ty);
+}
+
+//-----------------------------------------------------------------------------
+/* Send a rectangle of tiles from the shadow buffer */
+static void ShadowSend(uint16_t Tx0, uint16_t Ty0, uint16_t Tx1, uint16_t Ty1) {
+	uint16_t x = Tx0 * ST7796_SHADOW_TILE;
+	uint16_t y = Ty0 * ST7796_SHADOW_TILE;
+	uint16_t w = Tx1 * ST7796_SHADOW_TILE - x;
+	uint16_t h = Ty1 * ST7796_SHADOW_TILE - y;
+	uint16_t *p;
+	ShadowClip(&x, &y, &w, &h);
+	p = &shadowbuf[y * ST7796_SIZE_X + x];
+	ST7796_SetWriteWindow(x, y, w, h);
+	if (w == ST7796_SIZE_X) {
+		/* full rows: the buffer is continuous */
+		LCD_IO_DrawBitmap(p, w * h);
+	} else {
+		/* one row / transfer, the memory pointer continues in the window */
+		LCD_IO_DrawBitmap(p, w);
+		while (--h) {
+			p += ST7796_SIZE_X;
+			LCD_IO_DrawBitmapCont(p, w);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the shadow buffer (every tile is dirty after the init)
+ * @param  pBuffer: ST7796_SIZE_X * ST7796_SIZE_Y pixels buffer
+ * @retval None
+ */
+void ST7796_ShadowInit(uint16_t *pBuffer) {
+	shadowbuf = pBuffer;
+	ShadowMark(0, 0, ST7796_SIZE_X, ST7796_SIZE_Y);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the shadow buffer address
+ * @param  None
+ * @retval buffer (row pitch: ST7796_SIZE_X pixels)
+ */
+uint16_t * ST7796_ShadowGetBuffer(void) {
+	return shadowbuf;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Mark an area as changed
+ * @param  Xpos:  specifies the X position.
+ * @param  Ypos:  specifies the Y position.
+ * @param  Xsize: specifies the X size
+ * @param  Ysize: specifies the Y size
+ * @retval None
+ */
+void ST7796_ShadowMarkDirty(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize) {
+	if (ShadowClip(&Xpos, &Ypos, &Xsize, &Ysize))
+		ShadowMark(Xpos, Ypos, Xsize, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Write pixel.
+ * @param  Xpos: specifies the X position.
+ * @param  Ypos: specifies the Y position.
+ * @param  RGBCode: the RGB pixel color
+ * @retval None
+ */
+void ST7796_ShadowWritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode) {
+	ST7796_ShadowFillRect(Xpos, Ypos, 1, 1, RGBCode);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Read pixel (from the shadow buffer, no bus traffic)
+ * @param  Xpos: specifies the X position.
+ * @param  Ypos: specifies the Y position.
+ * @retval the RGB pixel color
+ */
+uint16_t ST7796_ShadowReadPixel(uint16_t Xpos, uint16_t Ypos) {
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y))
+		return 0;
+	return shadowbuf[Ypos * ST7796_SIZE_X + Xpos];
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw horizontal line.
+ * @param  RGBCode: Specifies the RGB color
+ * @param  Xpos:     specifies the X position.
+ * @param  Ypos:     specifies the Y position.
+ * @param  Length:   specifies the Line length.
+ * @retval None
+ */
+void ST7796_ShadowDrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Length) {
+	ST7796_ShadowFillRect(Xpos, Ypos, Length, 1, RGBCode);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw vertical line.
+ * @param  RGBCode: Specifies the RGB color
+ * @param  Xpos:     specifies the X position.
+ * @param  Ypos:     specifies the Y position.
+ * @param  Length:   specifies the Line length.
+ * @retval None
+ */
+void ST7796_ShadowDrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos,
+		uint16_t Length) {
+	ST7796_ShadowFillRect(Xpos, Ypos, 1, Length, RGBCode);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw Filled rectangle
+ * @param  Xpos:     specifies the X position.
+ * @param  Ypos:     specifies the Y position.
+ * @param  Xsize:    specifies the X size
+ * @param  Ysize:    specifies the Y size
+ * @param  RGBCode:  specifies the RGB color
+ * @retval None
+ */
+void ST7796_ShadowFillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t RGBCode) {
+	uint16_t x, y;
+	uint16_t *p;
+	if (!ShadowClip(&Xpos, &Ypos, &Xsize, &Ysize))
+		return;
+	for (y = 0; y < Ysize; y++) {
+		p = &shadowbuf[(Ypos + y) * ST7796_SIZE_X + Xpos];
+		for (x = 0; x < Xsize; x++)
+			*p++ = RGBCode;
+	}
+	ShadowMark(Xpos, Ypos, Xsize, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw 16bit/pixel picture
+ * @param  Xpos:  Image X position in the LCD
+ * @param  Ypos:  Image Y position in the LCD
+ * @param  Xsize: Image X size in the LCD
+ * @param  Ysize: Image Y size in the LCD
+ * @param  pData: picture address
+ * @retval None
+ */
+void ST7796_ShadowDrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t *pData) {
+	uint16_t y, w = Xsize;
+	if (!ShadowClip(&Xpos, &Ypos, &w, &Ysize))
+		return;
+	for (y = 0; y < Ysize; y++)
+		memcpy(&shadowbuf[(Ypos + y) * ST7796_SIZE_X + Xpos], &pData[y * Xsize],
+				w * 2);
+	ShadowMark(Xpos, Ypos, w, Ysize);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Send the dirty tiles to the LCD
+ * @param  None
+ * @retval number of sent rectangles
+ */
+uint32_t ST7796_ShadowFlush(void) {
+	uint16_t tx, ty, t0, t1, ty1, g, i;
+	uint32_t n = 0;
+	ST7796_Sync();
+	for (ty = 0; ty < SHADOW_TY; ty++) {
+		tx = 0;
+		while (tx < SHADOW_TX) {
+			if (!SHADOW_DIRTY(tx, ty)) {
+				tx++;
+				continue;
+			}
+			t0 = tx;
+			t1 = tx + 1;
+#if ST7796_SHADOW_MERGE >= 1
+			/* horizontal run, bridging at most ST7796_SHADOW_GAP clean tiles */
+			while (t1 < SHADOW_TX) {
+				for (g = 0; (g <= ST7796_SHADOW_GAP) && (t1 + g < SHADOW_TX); g++)
+					if (SHADOW_DIRTY(t1 + g, ty))
+						break;
+				if ((g > ST7796_SHADOW_GAP) || (t1 + g >= SHADOW_TX))
+					break;
+				t1 += g + 1;
+			}
+#endif
+			ty1 = ty + 1;
+#if ST7796_SHADOW_MERGE >= 2
+			/* the same columns are dirty in the next tile rows */
+			while (ty1 < SHADOW_TY) {
+				for (i = t0; i < t1; i++)
+					if (!SHADOW_DIRTY(i, ty1))
+						break;
+				if (i < t1)
+					break;
+				ty1++;
+			}
+#endif
+			for (g = ty; g < ty1; g++)
+				for (i = t0; i < t1; i++)
+					SHADOW_CLRDIRTY(i, g);
+			ShadowSend(t0, ty, t1, ty1);
+			n++;
+			tx = t1;
+		}
+	}
+	return n;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
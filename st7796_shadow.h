@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file    st7796_shadow.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 shadow framebuffer
+ *          (RAM copy of the screen with dirty tile tracking).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_SHADOW_H
+#define ST7796_SHADOW_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+/* The drawing functions only change the RAM buffer (ST7796_SIZE_X *
+   ST7796_SIZE_Y pixels) and mark the touched tiles, ST7796_ShadowFlush
+   sends the dirty tiles. After a direct change of the buffer, call
+   ST7796_ShadowMarkDirty for the changed area. */
+void ST7796_ShadowInit(uint16_t *pBuffer);
+uint16_t * ST7796_ShadowGetBuffer(void);
+void ST7796_ShadowMarkDirty(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize);
+void ST7796_ShadowWritePixel(uint16_t Xpos, uint16_t Ypos, uint16_t RGBCode);
+uint16_t ST7796_ShadowReadPixel(uint16_t Xpos, uint16_t Ypos);
+void ST7796_ShadowDrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_ShadowDrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
+void ST7796_ShadowFillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t RGBCode);
+void ST7796_ShadowDrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint16_t *pData);
+uint32_t ST7796_ShadowFlush(void);
+
+#endif /* ST7796_SHADOW_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
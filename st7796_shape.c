@@ -0,0 +1,686 @@
+/**
+ ******************************************************************************
+ * @file    st7796_shape.c
+ * @author  MCD Application Team
+ * @brief   Shape rasterizer for the st7796 driver. Lines, circles, arcs,
+ *          triangles and rounded rectangles are scan converted into spans
+ *          instead of single pixels (one CASET, RASET and RAMWR / pixel),
+ *          the spans of a shape are collected into a few open rectangles
+ *          (a vertical run or the pixels of a row grow the rectangle) and
+ *          every rectangle is sent with one fill. The rounded shapes share
+ *          one integer ring rasterizer (a box with rounded corners between
+ *          an inner and an outer radius), the triangles and the thick lines
+ *          one convex polygon rasterizer (edge functions in 1/16 pixel).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_shape.h"
+#if ST7796_SHAPE_AA == 1
+#include "st7796_blend.h"
+#define SHAPE_HALF       128           /* half pixel edge band of the rings [1/256 pixel]
+                                          (the filled shapes reach the pixel border) */
+#define SHAPE_HALF16     8             /* half pixel edge band of the polygons [1/16 pixel] */
+#else
+#define SHAPE_HALF       0
+#define SHAPE_HALF16     0
+#endif
+
+#define SHAPE_SIZE_X     ((int32_t) ST7796_SIZE_X)
+#define SHAPE_SIZE_Y     ((int32_t) ST7796_SIZE_Y)
+
+typedef struct {
+	int16_t x, y;
+	uint16_t w, h;
+} ShapeRectTypeDef;
+
+static ShapeRectTypeDef shaperect[ST7796_SHAPE_PENDING];
+static uint8_t shapenum;               /* open rectangles */
+static uint16_t shapecolor;
+#if ST7796_SHAPE_AA == 1
+static int16_t shapeax, shapeay;       /* pending run of edge pixels */
+static uint16_t shapeaw;
+static uint8_t shapealpha;
+#endif
+
+/* Arc sector (start and end directions in Q14) */
+static uint8_t shapearc;               /* 0: no sector, 1: sweep <= 180, 2: sweep > 180 */
+static int16_t shapecx, shapecy;
+static int32_t shapesx, shapesy, shapeex, shapeey;
+
+/* Ring: box with rounded corners, radii in 1/256 pixel (negative: none) */
+static int16_t shapebx0, shapebx1, shapeby0, shapeby1;
+static int32_t shapero, shaperi;
+
+/* Convex polygon: vertices in 1/16 pixel, edge vectors and lengths */
+static int32_t shapepx[4], shapepy[4], shapepa[4], shapepb[4];
+static uint32_t shapepl[4];
+static uint8_t shapepn;
+
+/* sin(0 .. 90 degree) in Q14 */
+static const int16_t shapesin[91] = {
+	0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+	2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+	5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+	8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+	10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+	12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+	14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+	15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+	16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+	16384 };
+
+//-----------------------------------------------------------------------------
+static uint32_t ShapeSqrt(uint64_t N) {
+	uint64_t r = 0, b = (uint64_t) 1 << 62;
+	while (b > N)
+		b >>= 2;
+	while (b) {
+		if (N >= r + b) {
+			N -= r + b;
+			r = (r >> 1) + b;
+		} else
+			r >>= 1;
+		b >>= 2;
+	}
+	return (uint32_t) r;
+}
+
+//-----------------------------------------------------------------------------
+/* Rounded down division (Den > 0) */
+static int64_t ShapeFloorDiv(int64_t Num, int64_t Den) {
+	return (Num >= 0) ? Num / Den : -((-Num + Den - 1) / Den);
+}
+
+/* Emitter -------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+static void ShapeBegin(uint16_t RGBCode) {
+	shapecolor = RGBCode;
+	shapenum = 0;
+	shapearc = 0;
+#if ST7796_SHAPE_AA == 1
+	shapeaw = 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/* Send an open rectangle */
+static void ShapeSend(uint8_t Idx) {
+	ShapeRectTypeDef *p = &shaperect[Idx];
+	ST7796_FillRect(p->x, p->y, p->w, p->h, shapecolor);
+	shapenum--;
+	for (; Idx < shapenum; Idx++)
+		shaperect[Idx] = shaperect[Idx + 1];
+}
+
+//-----------------------------------------------------------------------------
+/* Add a span (grows an open rectangle when it continues it) */
+static void ShapeSpan(int32_t X, int32_t Y, int32_t Width) {
+	ShapeRectTypeDef *p;
+	uint8_t i;
+	if (X < 0) {
+		Width += X;
+		X = 0;
+	}
+	if (X + Width > SHAPE_SIZE_X)
+		Width = SHAPE_SIZE_X - X;
+	if (Width <= 0 || Y < 0 || Y >= SHAPE_SIZE_Y)
+		return;
+	for (i = 0; i < shapenum;) {
+		p = &shaperect[i];
+		if (p->x == X && p->w == Width && p->y + p->h == Y) {
+			p->h++;
+			return;
+		}
+		if (p->h == 1 && p->y == Y && p->x + p->w == X) {
+			p->w += Width;
+			return;
+		}
+		if (p->y + p->h < Y)
+			ShapeSend(i); /* skipped a row: can not grow any more */
+		else
+			i++;
+	}
+	if (shapenum == ST7796_SHAPE_PENDING)
+		ShapeSend(0);
+	p = &shaperect[shapenum++];
+	p->x = X;
+	p->y = Y;
+	p->w = Width;
+	p->h = 1;
+}
+
+#if ST7796_SHAPE_AA == 1
+//-----------------------------------------------------------------------------
+static void ShapeEdgeSend(void) {
+	if (shapeaw)
+		ST7796_FillRectAlpha(shapeax, shapeay, shapeaw, 1, shapecolor, shapealpha);
+	shapeaw = 0;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+static void ShapeEnd(void) {
+	while (shapenum)
+		ShapeSend(0);
+#if ST7796_SHAPE_AA == 1
+	ShapeEdgeSend();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+/* 1: the pixel is in the arc sector */
+static uint8_t ShapeInArc(int32_t X, int32_t Y) {
+	int32_t px = X - shapecx, py = Y - shapecy;
+	uint8_t a = (shapesx * py - shapesy * px >= 0); /* clockwise from the start */
+	uint8_t b = (px * shapeey - py * shapeex >= 0); /* counterclockwise from the end */
+	return (shapearc == 2) ? (a || b) : (a && b);
+}
+
+//-----------------------------------------------------------------------------
+/* Solid pixels X0 .. X1 of a row */
+static void ShapeSolid(int32_t X0, int32_t X1, int32_t Y) {
+	if (!shapearc) {
+		ShapeSpan(X0, Y, X1 - X0 + 1);
+		return;
+	}
+	if (X0 < 0)
+		X0 = 0;
+	if (X1 >= SHAPE_SIZE_X)
+		X1 = SHAPE_SIZE_X - 1;
+	for (; X0 <= X1; X0++)
+		if (ShapeInArc(X0, Y))
+			ShapeSpan(X0, Y, 1);
+}
+
+//-----------------------------------------------------------------------------
+/* Edge pixel with coverage Alpha (0 .. 256) */
+static void ShapePixel(int32_t X, int32_t Y, int32_t Alpha) {
+#if ST7796_SHAPE_AA == 1
+	if (Alpha >= 252) {
+		ShapeSolid(X, X, Y);
+		return;
+	}
+	if (Alpha < 4 || X < 0 || X >= SHAPE_SIZE_X || Y < 0 || Y >= SHAPE_SIZE_Y)
+		return;
+	if (shapearc && !ShapeInArc(X, Y))
+		return;
+	if (shapeaw && shapeay == Y && shapealpha == Alpha && shapeax + shapeaw == X) {
+		shapeaw++;
+		return;
+	}
+	ShapeEdgeSend();
+	shapeax = X;
+	shapeay = Y;
+	shapeaw = 1;
+	shapealpha = Alpha;
+#else
+	(void) Alpha;
+	ShapeSolid(X, X, Y);
+#endif
+}
+
+/* Ring rasterizer -----------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+/* Largest horizontal distance K with K^2 + Dy2 <= (R8 / 256)^2 (-1: none) */
+static int32_t ShapeMaxK(int32_t R8, int32_t Dy2) {
+	int64_t n;
+	if (R8 < 0)
+		return -1;
+	n = (int64_t) (((uint64_t) R8 * R8) >> 16) - Dy2;
+	return (n < 0) ? -1 : (int32_t) ShapeSqrt(n);
+}
+
+//-----------------------------------------------------------------------------
+/* Coverage of the ring at distance K, Dy2 from the box */
+static int32_t ShapeRingAlpha(int32_t K, int32_t Dy2) {
+	int32_t d8 = ShapeSqrt(((uint64_t) K * K + Dy2) << 16);
+	int32_t a = shapero + 128 - d8, ai = d8 - shaperi + 128;
+	if (ai < a)
+		a = ai;
+	return (a < 0) ? 0 : ((a > 256) ? 256 : a);
+}
+
+//-----------------------------------------------------------------------------
+/* Pixels of the ring within shapero and outside shaperi around the box */
+static void ShapeRing(void) {
+	int32_t y, y0, y1, dy, dy2, k, kl, ko, kh, sa, sb, klo;
+	int32_t r = (shapero + SHAPE_HALF) >> 8;
+	y0 = shapeby0 - r;
+	y1 = shapeby1 + r;
+	if (y0 < 0)
+		y0 = 0;
+	if (y1 >= SHAPE_SIZE_Y)
+		y1 = SHAPE_SIZE_Y - 1;
+	for (y = y0; y <= y1; y++) {
+		dy = (y < shapeby0) ? shapeby0 - y : ((y > shapeby1) ? y - shapeby1 : 0);
+		dy2 = dy * dy;
+		ko = ShapeMaxK(shapero + SHAPE_HALF, dy2); /* any coverage */
+		if (ko < 0)
+			continue;
+		kh = ShapeMaxK(shaperi - SHAPE_HALF, dy2); /* hole */
+		sa = ShapeMaxK(shaperi + SHAPE_HALF, dy2) + 1; /* solid: sa .. sb */
+		sb = ShapeMaxK(shapero - SHAPE_HALF, dy2);
+		klo = (kh + 1 > 1) ? kh + 1 : 1;
+		/* left corner, box, right corner */
+		for (k = ko; k >= klo;) {
+			if (k >= sa && k <= sb) {
+				kl = (sa > klo) ? sa : klo;
+				ShapeSolid(shapebx0 - k, shapebx0 - kl, y);
+				k = kl - 1;
+			} else {
+				ShapePixel(shapebx0 - k, y, ShapeRingAlpha(k, dy2));
+				k--;
+			}
+		}
+		if (kh < 0) {
+			if (sa <= 0 && sb >= 0)
+				ShapeSolid(shapebx0, shapebx1, y);
+			else
+				for (k = shapebx0; k <= shapebx1; k++)
+					ShapePixel(k, y, ShapeRingAlpha(0, dy2));
+		}
+		for (k = klo; k <= ko;) {
+			if (k >= sa && k <= sb) {
+				kl = (sb < ko) ? sb : ko;
+				ShapeSolid(shapebx1 + k, shapebx1 + kl, y);
+				k = kl + 1;
+			} else {
+				ShapePixel(shapebx1 + k, y, ShapeRingAlpha(k, dy2));
+				k++;
+			}
+		}
+	}
+}
+
+/* Polygon rasterizer --------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+/* Prepare the edges of the convex polygon shapepx / shapepy
+   retval 0: degenerate */
+static uint8_t ShapePolySetup(void) {
+	uint8_t i, j;
+	int64_t e;
+	for (i = 0; i < shapepn; i++) {
+		j = (i + 1 < shapepn) ? i + 1 : 0;
+		shapepa[i] = shapepy[j] - shapepy[i];
+		shapepb[i] = shapepx[j] - shapepx[i];
+		shapepl[i] = ShapeSqrt((int64_t) shapepa[i] * shapepa[i]
+				+ (int64_t) shapepb[i] * shapepb[i]);
+	}
+	/* inside: edge function >= 0 */
+	e = (int64_t) (shapepx[2] - shapepx[0]) * shapepa[0]
+			- (int64_t) (shapepy[2] - shapepy[0]) * shapepb[0];
+	if (!e)
+		return 0;
+	if (e < 0)
+		for (i = 0; i < shapepn; i++) {
+			shapepa[i] = -shapepa[i];
+			shapepb[i] = -shapepb[i];
+		}
+	return 1;
+}
+
+#if ST7796_SHAPE_AA == 1
+//-----------------------------------------------------------------------------
+/* Edge function of the pixel center (distance from the edge * length * 16) */
+static int64_t ShapeEdgeFunc(uint8_t Idx, int32_t X, int32_t Y) {
+	return (int64_t) (X * 16 - shapepx[Idx]) * shapepa[Idx]
+			- (int64_t) (Y * 16 - shapepy[Idx]) * shapepb[Idx];
+}
+#endif
+
+//-----------------------------------------------------------------------------
+/* Pixels of a row where every edge function is at least the threshold
+   Band: -1: any coverage, 0: aliased, 1: full coverage
+   retval 0: none */
+static uint8_t ShapePolyRange(int32_t Y, int8_t Band, int32_t *pX0, int32_t *pX1) {
+	int64_t x0 = -1, x1 = SHAPE_SIZE_X, t, r, a;
+	uint8_t i;
+	for (i = 0; i < shapepn; i++) {
+		if (Band)
+			t = (int64_t) Band * SHAPE_HALF16 * shapepl[i] + (Band < 0);
+		else /* top left rule: one of two edges on the pixel center */
+			t = (shapepa[i] > 0 || (!shapepa[i] && shapepb[i] > 0)) ? 0 : 1;
+		r = t + (int64_t) shapepx[i] * shapepa[i]
+				+ (int64_t) (Y * 16 - shapepy[i]) * shapepb[i];
+		a = (int64_t) shapepa[i] * 16;
+		if (a > 0) {
+			t = -ShapeFloorDiv(-r, a);
+			if (t > x0)
+				x0 = t;
+		} else if (a < 0) {
+			t = ShapeFloorDiv(-r, -a);
+			if (t < x1)
+				x1 = t;
+		} else if (r > 0)
+			return 0;
+	}
+	*pX0 = x0;
+	*pX1 = x1;
+	return x0 <= x1;
+}
+
+//-----------------------------------------------------------------------------
+static void ShapePoly(void) {
+	int32_t y, y0, y1, x0, x1;
+#if ST7796_SHAPE_AA == 1
+	int32_t x, f0, f1;
+	int64_t e, m;
+#endif
+	uint8_t i;
+	y0 = y1 = shapepy[0];
+	for (i = 1; i < shapepn; i++) {
+		if (shapepy[i] < y0)
+			y0 = shapepy[i];
+		if (shapepy[i] > y1)
+			y1 = shapepy[i];
+	}
+	y0 = -ShapeFloorDiv(-(y0 - SHAPE_HALF16), 16);
+	y1 = ShapeFloorDiv(y1 + SHAPE_HALF16, 16);
+	if (y0 < 0)
+		y0 = 0;
+	if (y1 >= SHAPE_SIZE_Y)
+		y1 = SHAPE_SIZE_Y - 1;
+	for (y = y0; y <= y1; y++) {
+#if ST7796_SHAPE_AA == 1
+		if (!ShapePolyRange(y, -1, &x0, &x1))
+			continue;
+		if (!ShapePolyRange(y, 1, &f0, &f1))
+			f0 = x1 + 1;
+		for (x = x0; x <= x1;) {
+			if (x == f0) {
+				ShapeSolid(f0, f1, y);
+				x = f1 + 1;
+				continue;
+			}
+			m = 256;
+			for (i = 0; i < shapepn; i++) {
+				e = 128 + ShapeEdgeFunc(i, x, y) * 16 / shapepl[i];
+				if (e < m)
+					m = e;
+			}
+			ShapePixel(x, y, (int32_t) m);
+			x++;
+		}
+#else
+		if (ShapePolyRange(y, 0, &x0, &x1))
+			ShapeSolid(x0, x1, y);
+#endif
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Quad of a line with square cut ends */
+static void ShapeQuad(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, uint16_t Width) {
+	int32_t dx = (X1 - X0) * 16, dy = (Y1 - Y0) * 16, nx, ny, l;
+	if (!dx && !dy)
+		dx = 16;
+	l = ShapeSqrt((int64_t) dx * dx + (int64_t) dy * dy);
+	nx = -dy * 8 * Width / l;
+	ny = dx * 8 * Width / l;
+	shapepx[0] = X0 * 16 + nx;
+	shapepy[0] = Y0 * 16 + ny;
+	shapepx[1] = X1 * 16 + nx;
+	shapepy[1] = Y1 * 16 + ny;
+	shapepx[2] = X1 * 16 - nx;
+	shapepy[2] = Y1 * 16 - ny;
+	shapepx[3] = X0 * 16 - nx;
+	shapepy[3] = Y0 * 16 - ny;
+	shapepn = 4;
+	if (ShapePolySetup())
+		ShapePoly();
+}
+
+/* Shapes --------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a line (aliased: Bresenham, anti-aliased: 1 pixel wide quad)
+ * @param  X0, Y0: start
+ * @param  X1, Y1: end
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_DrawLine(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, uint16_t RGBCode) {
+	ShapeBegin(RGBCode);
+#if ST7796_SHAPE_AA == 1
+	ShapeQuad(X0, Y0, X1, Y1, 1);
+#else
+	int32_t dx, dy, sx, sy, err, e2, x = X0, y = Y0;
+	if (Y0 > Y1) { /* top down (the vertical runs grow the rectangles) */
+		x = X1;
+		y = Y1;
+		X1 = X0;
+		Y1 = Y0;
+	}
+	dx = (X1 > x) ? X1 - x : x - X1;
+	dy = Y1 - y;
+	sx = (x < X1) ? 1 : -1;
+	sy = 1;
+	err = dx - dy;
+	while (1) {
+		ShapeSpan(x, y, 1);
+		if (x == X1 && y == Y1)
+			break;
+		e2 = 2 * err;
+		if (e2 > -dy) {
+			err -= dy;
+			x += sx;
+		}
+		if (e2 < dx) {
+			err += dx;
+			y += sy;
+		}
+	}
+#endif
+	ShapeEnd();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a thick line
+ * @param  X0, Y0: start
+ * @param  X1, Y1: end
+ * @param  Width: line width
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_DrawThickLine(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1,
+		uint16_t Width, uint16_t RGBCode) {
+	if (Width <= 1) {
+		ST7796_DrawLine(X0, Y0, X1, Y1, RGBCode);
+		return;
+	}
+	ShapeBegin(RGBCode);
+	ShapeQuad(X0, Y0, X1, Y1, Width);
+	ShapeEnd();
+}
+
+//-----------------------------------------------------------------------------
+/* Ring around the box X0 .. X1, Y0 .. Y1 */
+static void ShapeRingBox(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1,
+		int32_t Ro, int32_t Ri) {
+	shapebx0 = X0;
+	shapeby0 = Y0;
+	shapebx1 = X1;
+	shapeby1 = Y1;
+	shapero = Ro;
+	shaperi = Ri;
+	ShapeRing();
+	ShapeEnd();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a circle (1 pixel wide)
+ * @param  Xc, Yc: center
+ * @param  Radius: radius
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_DrawCircle(int16_t Xc, int16_t Yc, uint16_t Radius, uint16_t RGBCode) {
+	ShapeBegin(RGBCode);
+	ShapeRingBox(Xc, Yc, Xc, Yc, ((int32_t) Radius << 8) + 128,
+			((int32_t) Radius << 8) - 128);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a filled circle
+ * @param  Xc, Yc: center
+ * @param  Radius: radius
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_FillCircle(int16_t Xc, int16_t Yc, uint16_t Radius, uint16_t RGBCode) {
+	ShapeBegin(RGBCode);
+	ShapeRingBox(Xc, Yc, Xc, Yc, ((int32_t) Radius << 8) + SHAPE_HALF, -256);
+}
+
+//-----------------------------------------------------------------------------
+/* Direction of an angle in Q14 (0: right, clockwise) */
+static void ShapeDir(int16_t Angle, int32_t *pX, int32_t *pY) {
+	int32_t a = Angle % 360, s, c;
+	if (a < 0)
+		a += 360;
+	s = shapesin[a % 90];
+	c = shapesin[90 - a % 90];
+	switch (a / 90) {
+	case 0:
+		*pX = c;
+		*pY = s;
+		break;
+	case 1:
+		*pX = -s;
+		*pY = c;
+		break;
+	case 2:
+		*pX = -c;
+		*pY = -s;
+		break;
+	default:
+		*pX = s;
+		*pY = -c;
+		break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw an arc (the ends are cut along the radius)
+ * @param  Xc, Yc: center
+ * @param  Radius: outer radius
+ * @param  Thickness: ring width (>= Radius: pie)
+ * @param  Start: start angle [degree]
+ * @param  End: end angle [degree] (clockwise from Start)
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_DrawArc(int16_t Xc, int16_t Yc, uint16_t Radius, uint16_t Thickness,
+		int16_t Start, int16_t End, uint16_t RGBCode) {
+	int32_t sweep = (End - Start) % 360;
+	if (sweep < 0)
+		sweep += 360;
+	if (!Thickness)
+		Thickness = 1;
+	ShapeBegin(RGBCode);
+	if (sweep) {
+		shapearc = (sweep > 180) ? 2 : 1;
+		shapecx = Xc;
+		shapecy = Yc;
+		ShapeDir(Start, &shapesx, &shapesy);
+		ShapeDir(End, &shapeex, &shapeey);
+	}
+	ShapeRingBox(Xc, Yc, Xc, Yc, ((int32_t) Radius << 8) + 128,
+			(((int32_t) Radius - Thickness) << 8) + 128);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a filled triangle
+ * @param  X0, Y0, X1, Y1, X2, Y2: vertices
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_FillTriangle(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1,
+		int16_t X2, int16_t Y2, uint16_t RGBCode) {
+	shapepx[0] = X0 * 16;
+	shapepy[0] = Y0 * 16;
+	shapepx[1] = X1 * 16;
+	shapepy[1] = Y1 * 16;
+	shapepx[2] = X2 * 16;
+	shapepy[2] = Y2 * 16;
+	shapepn = 3;
+	if (!ShapePolySetup()) { /* all on one line */
+		ST7796_DrawLine(X0, Y0, X1, Y1, RGBCode);
+		ST7796_DrawLine(X1, Y1, X2, Y2, RGBCode);
+		return;
+	}
+	ShapeBegin(RGBCode);
+	ShapePoly();
+	ShapeEnd();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a rounded rectangle (1 pixel wide)
+ * @param  Xpos, Ypos: top left corner
+ * @param  Xsize, Ysize: size
+ * @param  Radius: corner radius
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_DrawRoundRect(int16_t Xpos, int16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Radius, uint16_t RGBCode) {
+	uint16_t m = (Xsize < Ysize) ? Xsize : Ysize;
+	if (!m)
+		return;
+	if (Radius > (m - 1) / 2)
+		Radius = (m - 1) / 2;
+	if (!Radius)
+		Radius = 1; /* the hole must cover the box */
+	ShapeBegin(RGBCode);
+	ShapeRingBox(Xpos + Radius, Ypos + Radius, Xpos + Xsize - 1 - Radius,
+			Ypos + Ysize - 1 - Radius, ((int32_t) Radius << 8) + 128,
+			((int32_t) Radius << 8) - 128);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Draw a filled rounded rectangle
+ * @param  Xpos, Ypos: top left corner
+ * @param  Xsize, Ysize: size
+ * @param  Radius: corner radius
+ * @param  RGBCode: color
+ * @retval None
+ */
+void ST7796_FillRoundRect(int16_t Xpos, int16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Radius, uint16_t RGBCode) {
+	uint16_t m = (Xsize < Ysize) ? Xsize : Ysize;
+	if (!m)
+		return;
+	if (Radius > (m - 1) / 2)
+		Radius = (m - 1) / 2;
+	ShapeBegin(RGBCode);
+	ShapeRingBox(Xpos + Radius, Ypos + Radius, Xpos + Xsize - 1 - Radius,
+			Ypos + Ysize - 1 - Radius, ((int32_t) Radius << 8) + SHAPE_HALF, -256);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file    st7796_shape.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 shape rasterizer
+ *          (lines, circles, arcs, triangles and rounded rectangles).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_SHAPE_H
+#define ST7796_SHAPE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+/* The shapes are scan converted into spans, the spans continuing an open
+   rectangle (the next row of a vertical run or the next pixels of a row)
+   grow it and every rectangle is sent with one ST7796_FillRect. The
+   coordinates may be outside of the screen (clipped). With
+   ST7796_SHAPE_AA == 1 the edge pixels are blended by ST7796_FillRectAlpha
+   (call ST7796_BlendInit first, or use the shadow buffer). Angles are in
+   degrees, 0: right, clockwise, End == Start: full circle. */
+void ST7796_DrawLine(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, uint16_t RGBCode);
+/* Width: line width [pixel], the ends are square cut */
+void ST7796_DrawThickLine(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1,
+		uint16_t Width, uint16_t RGBCode);
+void ST7796_DrawCircle(int16_t Xc, int16_t Yc, uint16_t Radius, uint16_t RGBCode);
+void ST7796_FillCircle(int16_t Xc, int16_t Yc, uint16_t Radius, uint16_t RGBCode);
+/* Thickness: ring width inwards from Radius [pixel] */
+void ST7796_DrawArc(int16_t Xc, int16_t Yc, uint16_t Radius, uint16_t Thickness,
+		int16_t Start, int16_t End, uint16_t RGBCode);
+void ST7796_FillTriangle(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1,
+		int16_t X2, int16_t Y2, uint16_t RGBCode);
+void ST7796_DrawRoundRect(int16_t Xpos, int16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Radius, uint16_t RGBCode);
+void ST7796_FillRoundRect(int16_t Xpos, int16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, uint16_t Radius, uint16_t RGBCode);
+
+#endif /* ST7796_SHAPE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
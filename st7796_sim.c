@@ -0,0 +1,766 @@
+/**
+ ******************************************************************************
+ * @file    st7796_sim.c
+ * @author  MCD Application Team
+ * @brief   Host side ST7796 panel emulator. It replaces the lcd_io layer of the
+ *          target (LCD_IO_* functions) when the driver is built on a PC, so
+ *          every drawing primitive can be checked pixel by pixel and the bus
+ *          traffic can be measured without hardware.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+#include "st7796_sim.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_conv.h"
+
+/* MADCTL bits handled by the address generator */
+#define SIM_MAD_MY      0x80
+#define SIM_MAD_MX      0x40
+#define SIM_MAD_MV      0x20
+
+/* ID returned by RDDID */
+#define SIM_ID1         0x00
+#define SIM_ID2         0x77
+#define SIM_ID3         0x96
+
+/* the panel of the lcd_io interface */
+static ST7796_SimPanelTypeDef simpanel;
+
+/* 24 bit pixel transfers are converted in chunks of this size (like a
+   target lcd_io with a DMA buffer) */
+#define SIM_CONV_CHUNK  64
+
+/* shortest bus wait [ns] (the wire time of the shorter transactions is
+   collected) */
+#define SIM_BUS_MINSLEEP  50000
+
+/* Power model [per mille of the full screen normal mode]: sleep in, the
+   part independent of the scanning (oscillator, booster, gate driver) and
+   the source driver scanning of every line in every frame, divided in
+   the 8 color idle mode */
+#define SIM_POWER_SLEEP   5
+#define SIM_POWER_BASE    300
+#define SIM_POWER_SCAN    700
+#define SIM_POWER_IDLEDIV 3
+
+//-----------------------------------------------------------------------------
+/* Power on / software reset register values */
+static void SimRegReset(ST7796_SimPanelTypeDef *p) {
+	p->State.Madctl = 0x00;
+	p->State.Colmod = 0x66;
+	p->State.SleepOut = 0;
+	p->State.DisplayOn = 0;
+	p->State.Xs = 0;
+	p->State.Xe = ST7796_SIM_GRAM_WIDTH - 1;
+	p->State.Ys = 0;
+	p->State.Ye = ST7796_SIM_GRAM_HEIGHT - 1;
+	p->State.Tfa = 0;
+	p->State.Vsa = ST7796_SIM_GRAM_HEIGHT;
+	p->State.Bfa = 0;
+	p->State.Vsp = 0;
+	p->State.Partial = 0;
+	p->State.Idle = 0;
+	p->State.Psl = 0;
+	p->State.Pel = ST7796_SIM_GRAM_HEIGHT - 1;
+	p->CurX = 0;
+	p->CurY = 0;
+	p->PixByteCnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+/* Convert a logical (MCU side) address to the physical GRAM address
+   0: outside of the GRAM, 1: valid */
+static uint8_t SimMapAddr(uint8_t Madctl, uint16_t X, uint16_t Y, uint16_t *pPx,
+		uint16_t *pPy) {
+	uint16_t a, b;
+	if (Madctl & SIM_MAD_MV) {
+		a = Y;
+		b = X;
+	} else {
+		a = X;
+		b = Y;
+	}
+	if ((a >= ST7796_SIM_GRAM_WIDTH) || (b >= ST7796_SIM_GRAM_HEIGHT))
+		return 0;
+	*pPx = (Madctl & SIM_MAD_MX) ? ST7796_SIM_GRAM_WIDTH - 1 - a : a;
+	*pPy = (Madctl & SIM_MAD_MY) ? ST7796_SIM_GRAM_HEIGHT - 1 - b : b;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/* Step the address counter inside the CASET / RASET window */
+static void SimNextAddr(ST7796_SimPanelTypeDef *p) {
+	if (p->CurX >= p->State.Xe) {
+		p->CurX = p->State.Xs;
+		if (p->CurY >= p->State.Ye)
+			p->CurY = p->State.Ys;
+		else
+			p->CurY++;
+	} else
+		p->CurX++;
+}
+
+//-----------------------------------------------------------------------------
+static uint8_t SimIsRamWrite(uint8_t Cmd) {
+	return (Cmd == ST7796_WRITE_RAM) || (Cmd == ST7796_WRITE_RAM_CONT);
+}
+
+//-----------------------------------------------------------------------------
+static uint8_t SimIsRamRead(uint8_t Cmd) {
+	return (Cmd == ST7796_READ_RAM) || (Cmd == ST7796_READ_RAM_CONT);
+}
+
+//-----------------------------------------------------------------------------
+static uint8_t SimIs16bit(ST7796_SimPanelTypeDef *p) {
+	return (p->State.Colmod & 0x07) == 0x05;
+}
+
+//-----------------------------------------------------------------------------
+static void SimWritePixel(ST7796_SimPanelTypeDef *p, uint16_t Color) {
+	uint16_t px, py;
+	if (SimMapAddr(p->State.Madctl, p->CurX, p->CurY, &px, &py))
+		p->Gram[py][px] = Color;
+	SimNextAddr(p);
+	p->Stat.WrPixels++;
+}
+
+//-----------------------------------------------------------------------------
+static uint16_t SimReadPixel(ST7796_SimPanelTypeDef *p) {
+	uint16_t px, py, c = 0;
+	if (SimMapAddr(p->State.Madctl, p->CurX, p->CurY, &px, &py))
+		c = p->Gram[py][px];
+	SimNextAddr(p);
+	p->Stat.RdPixels++;
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+/* RAMWR data arriving as a byte stream: assemble the pixels by COLMOD */
+static void SimWriteRamByte(ST7796_SimPanelTypeDef *p, uint8_t d) {
+	p->PixBytes[p->PixByteCnt++] = d;
+	if (SimIs16bit(p)) {
+		if (p->PixByteCnt == 2) {
+			SimWritePixel(p, ((uint16_t) p->PixBytes[0] << 8) | p->PixBytes[1]);
+			p->PixByteCnt = 0;
+		}
+	} else if (p->PixByteCnt == 3) {
+		SimWritePixel(p, ((p->PixBytes[0] & 0xF8) << 8)
+				| ((p->PixBytes[1] & 0xFC) << 3) | (p->PixBytes[2] >> 3));
+		p->PixByteCnt = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* RAMRD data leaving as a byte stream: split the pixels by COLMOD */
+static uint8_t SimReadRamByte(ST7796_SimPanelTypeDef *p) {
+	uint16_t c;
+	if (p->PixByteCnt == 0) {
+		c = SimReadPixel(p);
+		if (SimIs16bit(p)) {
+			p->PixBytes[0] = c >> 8;
+			p->PixBytes[1] = c;
+			p->PixByteCnt = 2;
+		} else {
+			p->PixBytes[0] = (c >> 8) & 0xF8;
+			p->PixBytes[1] = (c >> 3) & 0xFC;
+			p->PixBytes[2] = (c << 3) & 0xF8;
+			p->PixByteCnt = 3;
+		}
+	}
+	c = p->PixBytes[0];
+	p->PixBytes[0] = p->PixBytes[1];
+	p->PixBytes[1] = p->PixBytes[2];
+	p->PixByteCnt--;
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+/* Transaction start: count the command byte and reset the memory pointer */
+static void SimCmd(ST7796_SimPanelTypeDef *p, uint8_t Cmd) {
+	p->Stat.Cmds++;
+	p->Stat.CmdCnt[Cmd]++;
+	p->State.ParamLen[Cmd] = 0;
+	if ((Cmd == ST7796_WRITE_RAM) || (Cmd == ST7796_READ_RAM)) {
+		p->CurX = p->State.Xs;
+		p->CurY = p->State.Ys;
+	}
+	if (SimIsRamWrite(Cmd) || SimIsRamRead(Cmd))
+		p->PixByteCnt = 0;
+}
+
+//-----------------------------------------------------------------------------
+static void SimParam(ST7796_SimPanelTypeDef *p, uint8_t Cmd, uint8_t d) {
+	if (p->State.ParamLen[Cmd] < ST7796_SIM_MAXPARAM)
+		p->State.Param[Cmd][p->State.ParamLen[Cmd]++] = d;
+}
+
+//-----------------------------------------------------------------------------
+static uint16_t SimParam16(ST7796_SimPanelTypeDef *p, uint8_t Cmd,
+		uint8_t Index) {
+	return ((uint16_t) p->State.Param[Cmd][Index] << 8)
+			| p->State.Param[Cmd][Index + 1];
+}
+
+//-----------------------------------------------------------------------------
+/* Transaction end: execute the command with the collected parameters */
+static void SimCmdEnd(ST7796_SimPanelTypeDef *p, uint8_t Cmd, uint32_t Size) {
+	struct timespec ts;
+	uint8_t n = p->State.ParamLen[Cmd];
+	p->Stat.CmdBytes[Cmd] += Size;
+	switch (Cmd) {
+	case ST7796_SW_RESET:
+		SimRegReset(p);
+		break;
+	case ST7796_SLEEP_IN:
+		p->State.SleepOut = 0;
+		break;
+	case ST7796_SLEEP_OUT:
+		p->State.SleepOut = 1;
+		break;
+	case ST7796_DISPLAY_OFF:
+		p->State.DisplayOn = 0;
+		break;
+	case ST7796_DISPLAY_ON:
+		p->State.DisplayOn = 1;
+		break;
+	case ST7796_PARTIAL_DISPLAY_ON:
+		p->State.Partial = 1;
+		break;
+	case ST7796_NORMAL_DISPLAY_OFF:
+		p->State.Partial = 0;
+		break;
+	case ST7796_PTLAR:
+		if (n >= 4) {
+			p->State.Psl = SimParam16(p, Cmd, 0);
+			p->State.Pel = SimParam16(p, Cmd, 2);
+		}
+		break;
+	case ST7796_IDLE_MODE_OFF:
+		p->State.Idle = 0;
+		break;
+	case ST7796_IDLE_MODE_ON:
+		p->State.Idle = 1;
+		break;
+	case ST7796_CASET:
+		if (n >= 4) {
+			p->State.Xs = SimParam16(p, Cmd, 0);
+			p->State.Xe = SimParam16(p, Cmd, 2);
+		}
+		break;
+	case ST7796_RASET:
+		if (n >= 4) {
+			p->State.Ys = SimParam16(p, Cmd, 0);
+			p->State.Ye = SimParam16(p, Cmd, 2);
+		}
+		break;
+	case ST7796_MADCTL:
+		if (n >= 1)
+			p->State.Madctl = p->State.Param[Cmd][0];
+		break;
+	case ST7796_COLOR_MODE:
+		if (n >= 1)
+			p->State.Colmod = p->State.Param[Cmd][0];
+		break;
+	case ST7796_VERT_SCROLLING_DEF:
+		if (n >= 6) {
+			p->State.Tfa = SimParam16(p, Cmd, 0);
+			p->State.Vsa = SimParam16(p, Cmd, 2);
+			p->State.Bfa = SimParam16(p, Cmd, 4);
+		}
+		break;
+	case ST7796_VERT_SCROLLING_ADDR:
+		if (n >= 2)
+			p->State.Vsp = SimParam16(p, Cmd, 0);
+		else if (n == 1)
+			p->State.Vsp = p->State.Param[Cmd][0];
+		break;
+	default:
+		break;
+	}
+	if (p->pTrace)
+		p->pTrace(Cmd, Size);
+	/* bus speed: wait the wire time of the transactions (command byte
+	   included), the short ones are collected into one sleep */
+	if (p->NsPerByte) {
+		p->BusNs += (uint64_t) (Size + 1) * p->NsPerByte;
+		if (p->BusNs >= SIM_BUS_MINSLEEP) {
+			ts.tv_sec = p->BusNs / 1000000000U;
+			ts.tv_nsec = p->BusNs % 1000000000U;
+			nanosleep(&ts, NULL);
+			p->BusNs = 0;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/* Parameter bytes of the read commands */
+static uint8_t SimReadRegByte(ST7796_SimPanelTypeDef *p, uint8_t Cmd,
+		uint32_t Index) {
+	static const uint8_t id[3] = { SIM_ID1, SIM_ID2, SIM_ID3 };
+	switch (Cmd) {
+	case ST7796_READ_ID:
+		return (Index < 3) ? id[Index] : 0;
+	case ST7796_READ_ID1:
+	case ST7796_READ_ID2:
+	case ST7796_READ_ID3:
+		return id[Cmd - ST7796_READ_ID1];
+	case ST7796_READ_MADCTL:
+		return p->State.Madctl;
+	case ST7796_READ_PIXEL_FORMAT:
+		return p->State.Colmod;
+	case ST7796_READ_RAM:
+	case ST7796_READ_RAM_CONT:
+		return SimReadRamByte(p);
+	default:
+		return (Index < p->State.ParamLen[Cmd]) ? p->State.Param[Cmd][Index] : 0;
+	}
+}
+
+/* Panel transport ---------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+static void SimIoDelay(void *pParam, uint32_t delay) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	p->Stat.DelayMs += delay;
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoInit(void *pParam) {
+	(void) pParam;
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoBlOnOff(void *pParam, uint8_t Bl) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	p->State.Backlight = Bl;
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoWriteCmd8MultipleData8(void *pParam, uint8_t Cmd,
+		uint8_t *pData, uint32_t Size) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint32_t i;
+	SimCmd(p, Cmd);
+	p->Stat.WrBytes += Size;
+	for (i = 0; i < Size; i++) {
+		if (SimIsRamWrite(Cmd))
+			SimWriteRamByte(p, pData[i]);
+		else
+			SimParam(p, Cmd, pData[i]);
+	}
+	SimCmdEnd(p, Cmd, Size);
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoWriteCmd8MultipleData16(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint32_t i;
+	SimCmd(p, Cmd);
+	p->Stat.WrBytes += Size * 2;
+	if (SimIsRamWrite(Cmd) && !SimIs16bit(p))
+		p->Stat.FormatErrors++;
+	for (i = 0; i < Size; i++) {
+		if (SimIsRamWrite(Cmd))
+			SimWritePixel(p, pData[i]);
+		else {
+			SimParam(p, Cmd, pData[i] >> 8);
+			SimParam(p, Cmd, pData[i]);
+		}
+	}
+	SimCmdEnd(p, Cmd, Size * 2);
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoWriteCmd8DataFill16(void *pParam, uint8_t Cmd, uint16_t Data,
+		uint32_t Size) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint32_t i;
+	SimCmd(p, Cmd);
+	p->Stat.WrBytes += Size * 2;
+	if (SimIsRamWrite(Cmd) && !SimIs16bit(p))
+		p->Stat.FormatErrors++;
+	for (i = 0; i < Size; i++) {
+		if (SimIsRamWrite(Cmd))
+			SimWritePixel(p, Data);
+		else {
+			SimParam(p, Cmd, Data >> 8);
+			SimParam(p, Cmd, Data);
+		}
+	}
+	SimCmdEnd(p, Cmd, Size * 2);
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoWriteCmd8DataFill16to24(void *pParam, uint8_t Cmd,
+		uint16_t Data, uint32_t Size) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint32_t i;
+	SimCmd(p, Cmd);
+	p->Stat.WrBytes += Size * 3;
+	if (SimIsRamWrite(Cmd) && SimIs16bit(p))
+		p->Stat.FormatErrors++;
+	for (i = 0; i < Size; i++)
+		SimWritePixel(p, Data);
+	SimCmdEnd(p, Cmd, Size * 3);
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoWriteCmd8MultipleData16to24(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint8_t bytes[SIM_CONV_CHUNK * 3];
+	uint32_t i, n, left;
+	SimCmd(p, Cmd);
+	p->Stat.WrBytes += Size * 3;
+	if (SimIsRamWrite(Cmd) && SimIs16bit(p))
+		p->Stat.FormatErrors++;
+	for (left = Size; left; left -= n, pData += n) {
+		n = (left > SIM_CONV_CHUNK) ? SIM_CONV_CHUNK : left;
+		ST7796_Conv16to24(pData, bytes, n);
+		for (i = 0; i < n * 3; i++)
+			SimWriteRamByte(p, bytes[i]);
+	}
+	SimCmdEnd(p, Cmd, Size * 3);
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoReadCmd8MultipleData8(void *pParam, uint8_t Cmd,
+		uint8_t *pData, uint32_t Size, uint32_t DummySize) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint32_t i;
+	SimCmd(p, Cmd);
+	p->Stat.RdBytes += Size;
+	p->Stat.DummyBytes += DummySize;
+	for (i = 0; i < Size; i++)
+		pData[i] = SimReadRegByte(p, Cmd, i);
+	SimCmdEnd(p, Cmd, Size);
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoReadCmd8MultipleData16(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size, uint32_t DummySize) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint32_t i;
+	SimCmd(p, Cmd);
+	p->Stat.RdBytes += Size * 2;
+	p->Stat.DummyBytes += DummySize;
+	if (SimIsRamRead(Cmd) && !SimIs16bit(p))
+		p->Stat.FormatErrors++;
+	for (i = 0; i < Size; i++) {
+		if (SimIsRamRead(Cmd))
+			pData[i] = SimReadPixel(p);
+		else
+			pData[i] = ((uint16_t) SimReadRegByte(p, Cmd, i * 2) << 8)
+					| SimReadRegByte(p, Cmd, i * 2 + 1);
+	}
+	SimCmdEnd(p, Cmd, Size * 2);
+}
+
+//-----------------------------------------------------------------------------
+static void SimIoReadCmd8MultipleData24to16(void *pParam, uint8_t Cmd,
+		uint16_t *pData, uint32_t Size, uint32_t DummySize) {
+	ST7796_SimPanelTypeDef *p = pParam;
+	uint8_t bytes[SIM_CONV_CHUNK * 3];
+	uint32_t i, n, left;
+	SimCmd(p, Cmd);
+	p->Stat.RdBytes += Size * 3;
+	p->Stat.DummyBytes += DummySize;
+	if (SimIsRamRead(Cmd) && SimIs16bit(p))
+		p->Stat.FormatErrors++;
+	for (left = Size; left; left -= n, pData += n) {
+		n = (left > SIM_CONV_CHUNK) ? SIM_CONV_CHUNK : left;
+		for (i = 0; i < n * 3; i++)
+			bytes[i] = SimReadRamByte(p);
+		ST7796_Conv24to16(bytes, pData, n);
+	}
+	SimCmdEnd(p, Cmd, Size * 3);
+}
+
+/* transport of the emulated panels (pIoParam: ST7796_SimPanelTypeDef *) */
+const ST7796_PanelIoTypeDef ST7796_SimPanelIo = {
+		SimIoInit,
+		SimIoDelay,
+		SimIoBlOnOff,
+		SimIoWriteCmd8DataFill16,
+		SimIoWriteCmd8MultipleData8,
+		SimIoWriteCmd8MultipleData16,
+		SimIoReadCmd8MultipleData8,
+		SimIoReadCmd8MultipleData16,
+		SimIoWriteCmd8DataFill16to24,
+		SimIoWriteCmd8MultipleData16to24,
+		SimIoReadCmd8MultipleData24to16
+};
+
+/* lcd_io interface ----------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+void LCD_Delay(uint32_t delay) {
+	SimIoDelay(&simpanel, delay);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_Init(void) {
+	SimIoInit(&simpanel);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_Bl_OnOff(uint8_t Bl) {
+	SimIoBlOnOff(&simpanel, Bl);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_WriteCmd8MultipleData8(uint8_t Cmd, uint8_t *pData, uint32_t Size) {
+	SimIoWriteCmd8MultipleData8(&simpanel, Cmd, pData, Size);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_WriteCmd8MultipleData16(uint8_t Cmd, uint16_t *pData,
+		uint32_t Size) {
+	SimIoWriteCmd8MultipleData16(&simpanel, Cmd, pData, Size);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_WriteCmd8DataFill16(uint8_t Cmd, uint16_t Data, uint32_t Size) {
+	SimIoWriteCmd8DataFill16(&simpanel, Cmd, Data, Size);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_WriteCmd8DataFill16to24(uint8_t Cmd, uint16_t Data, uint32_t Size) {
+	SimIoWriteCmd8DataFill16to24(&simpanel, Cmd, Data, Size);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_WriteCmd8MultipleData16to24(uint8_t Cmd, uint16_t *pData,
+		uint32_t Size) {
+	SimIoWriteCmd8MultipleData16to24(&simpanel, Cmd, pData, Size);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_ReadCmd8MultipleData8(uint8_t Cmd, uint8_t *pData, uint32_t Size,
+		uint32_t DummySize) {
+	SimIoReadCmd8MultipleData8(&simpanel, Cmd, pData, Size, DummySize);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_ReadCmd8MultipleData16(uint8_t Cmd, uint16_t *pData, uint32_t Size,
+		uint32_t DummySize) {
+	SimIoReadCmd8MultipleData16(&simpanel, Cmd, pData, Size, DummySize);
+}
+
+//-----------------------------------------------------------------------------
+void LCD_IO_ReadCmd8MultipleData24to16(uint8_t Cmd, uint16_t *pData,
+		uint32_t Size, uint32_t DummySize) {
+	SimIoReadCmd8MultipleData24to16(&simpanel, Cmd, pData, Size, DummySize);
+}
+
+
+/* Emulator control ----------------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Power on the emulated panel (registers to default, GRAM cleared,
+ *         counters cleared)
+ * @param  None
+ * @retval None
+ */
+void ST7796_Sim_Reset(void) {
+	memset(simpanel.Gram, 0, sizeof(simpanel.Gram));
+	memset(&simpanel.State, 0, sizeof(simpanel.State));
+	SimRegReset(&simpanel);
+	ST7796_Sim_ResetStat();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Clear the bus traffic counters
+ * @param  None
+ * @retval None
+ */
+void ST7796_Sim_ResetStat(void) {
+	memset(&simpanel.Stat, 0, sizeof(simpanel.Stat));
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the bus traffic counters
+ * @param  None
+ * @retval pointer of the counters
+ */
+const ST7796_SimStatTypeDef * ST7796_Sim_GetStat(void) {
+	return &simpanel.Stat;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the emulated register state
+ * @param  None
+ * @retval pointer of the state
+ */
+const ST7796_SimStateTypeDef * ST7796_Sim_GetState(void) {
+	return &simpanel.State;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the transaction trace callback (NULL: disabled)
+ * @param  pCallback: called after every LCD_IO_* transaction
+ * @retval None
+ */
+void ST7796_Sim_SetTraceCallback(ST7796_SimTraceCallback pCallback) {
+	simpanel.pTrace = pCallback;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Read a GRAM pixel by physical address (MADCTL = 0, no scroll)
+ * @param  Xpos: physical column (0..319)
+ * @param  Ypos: physical row (0..479)
+ * @retval RGB565 pixel color
+ */
+uint16_t ST7796_Sim_GetGramPixel(uint16_t Xpos, uint16_t Ypos) {
+	return ST7796_SimPanel_GetGramPixel(&simpanel, Xpos, Ypos);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Read a visible pixel in the coordinate system of the driver
+ *         (actual orientation, right then down), vertical scrolling included
+ * @param  Xpos: specifies the X position (0..ST7796_SIZE_X - 1)
+ * @param  Ypos: specifies the Y position (0..ST7796_SIZE_Y - 1)
+ * @retval RGB565 pixel color
+ */
+uint16_t ST7796_Sim_GetScreenPixel(uint16_t Xpos, uint16_t Ypos) {
+	uint16_t px, py, c;
+	if (!SimMapAddr(ST7796_MAD_DATA_RIGHT_THEN_DOWN, Xpos, Ypos, &px, &py))
+		return 0;
+	/* partial mode: the non-display area is black */
+	if (simpanel.State.Partial && ((py < simpanel.State.Psl)
+			|| (py > simpanel.State.Pel)))
+		return 0;
+	/* display line -> GRAM row (scroll area only) */
+	if ((py >= simpanel.State.Tfa)
+			&& (py < simpanel.State.Tfa + simpanel.State.Vsa)) {
+		py = py - simpanel.State.Tfa + simpanel.State.Vsp;
+		if (py >= simpanel.State.Tfa + simpanel.State.Vsa)
+			py -= simpanel.State.Vsa;
+	}
+	c = ST7796_Sim_GetGramPixel(px, py);
+	/* idle mode: the MSB of every channel */
+	if (simpanel.State.Idle)
+		c = ((c & 0x8000) ? 0xF800 : 0) | ((c & 0x0400) ? 0x07E0 : 0)
+				| ((c & 0x0010) ? 0x001F : 0);
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Relative power draw of an emulated panel (see ST7796_Sim_GetPower)
+ * @param  pSim: emulated panel
+ * @retval power [per mille of the full screen normal mode]
+ */
+uint32_t ST7796_SimPanel_GetPower(const ST7796_SimPanelTypeDef *pSim) {
+	uint32_t scan, lines = ST7796_SIM_GRAM_HEIGHT;
+	uint8_t frmctr = ST7796_FRAME_RATE_CTRL1;
+	if (!pSim->State.SleepOut)
+		return SIM_POWER_SLEEP;
+	if (!pSim->State.DisplayOn)
+		return SIM_POWER_BASE;
+	if (pSim->State.Idle)
+		frmctr = ST7796_FRAME_RATE_CTRL2;
+	else if (pSim->State.Partial)
+		frmctr = ST7796_FRAME_RATE_CTRL3;
+	if (pSim->State.Partial)
+		lines = (pSim->State.Pel >= pSim->State.Psl) ?
+				pSim->State.Pel - pSim->State.Psl + 1 : 0;
+	scan = SIM_POWER_SCAN * lines / ST7796_SIM_GRAM_HEIGHT;
+	/* DIV: the oscillator divided by 1, 2, 4, 8 */
+	if (pSim->State.ParamLen[frmctr])
+		scan >>= pSim->State.Param[frmctr][0] & 0x03;
+	if (pSim->State.Idle)
+		scan /= SIM_POWER_IDLEDIV;
+	return SIM_POWER_BASE + scan;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Relative power draw of the lcd_io panel
+ * @param  None
+ * @retval power [per mille of the full screen normal mode]
+ */
+uint32_t ST7796_Sim_GetPower(void) {
+	return ST7796_SimPanel_GetPower(&simpanel);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Replay a captured command stream
+ *         record format: command (1 byte), data size (4 bytes, little endian),
+ *         data bytes (parameters, or RAMWR pixels in the COLMOD format)
+ * @param  pStream: stream address
+ * @param  Size:    stream size [byte]
+ * @retval number of replayed transactions
+ */
+uint32_t ST7796_Sim_Replay(const uint8_t *pStream, uint32_t Size) {
+	uint32_t len, cnt = 0;
+	while (Size >= 5) {
+		len = pStream[1] | ((uint32_t) pStream[2] << 8)
+				| ((uint32_t) pStream[3] << 16) | ((uint32_t) pStream[4] << 24);
+		if (len > Size - 5)
+			break;
+		LCD_IO_WriteCmd8MultipleData8(pStream[0], (uint8_t*) &pStream[5], len);
+		pStream += 5 + len;
+		Size -= 5 + len;
+		cnt++;
+	}
+	return cnt;
+}
+
+/* Emulated panel instances -------------------------------------------------*/
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Power on an emulated panel of ST7796_SimPanelIo (registers to
+ *         default, GRAM and counters cleared, no trace callback)
+ * @param  pSim:      emulated panel
+ * @param  NsPerByte: simulated wire time of a byte (0: no waiting)
+ * @retval None
+ */
+void ST7796_SimPanel_Reset(ST7796_SimPanelTypeDef *pSim, uint32_t NsPerByte) {
+	memset(pSim, 0, sizeof(*pSim));
+	SimRegReset(pSim);
+	pSim->NsPerByte = NsPerByte;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Read a GRAM pixel of an emulated panel by physical address
+ * @param  pSim: emulated panel
+ * @param  Xpos: physical column (0..319)
+ * @param  Ypos: physical row (0..479)
+ * @retval RGB565 pixel color
+ */
+uint16_t ST7796_SimPanel_GetGramPixel(const ST7796_SimPanelTypeDef *pSim,
+		uint16_t Xpos, uint16_t Ypos) {
+	if ((Xpos >= ST7796_SIM_GRAM_WIDTH) || (Ypos >= ST7796_SIM_GRAM_HEIGHT))
+		return 0;
+	return pSim->Gram[Ypos][Xpos];
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,141 @@
+/**
+ ******************************************************************************
+ * @file    st7796_sim.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the host side ST7796 panel
+ *          emulator. The emulator implements the LCD_IO_* functions used by
+ *          the st7796 driver against a simulated panel (GRAM, address window,
+ *          MADCTL, COLMOD and vertical scrolling) and counts the bus traffic.
+ *          More emulated panels can be driven through ST7796_SimPanelIo
+ *          (st7796 panel instance transport).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_SIM_H
+#define ST7796_SIM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "st7796.h"
+
+/* Host replacement of the CMSIS intrinsics used by the driver (also defined
+   by host/main.h). The emulator links together with st7796_conv.c (its 24
+   bit pixel transfers are converted by the kernels), host/Makefile builds the
+   driver, the emulator and the tests. */
+#ifndef __REVSH
+#define __REVSH(x) ((int16_t)((((uint16_t)(x)) >> 8) | (((uint16_t)(x)) << 8)))
+#endif
+#ifndef __DMB
+#define __DMB() __sync_synchronize()
+#endif
+
+/* Physical GRAM size of the panel (MADCTL = 0) */
+#define ST7796_SIM_GRAM_WIDTH     320U
+#define ST7796_SIM_GRAM_HEIGHT    480U
+
+/* Maximum number of stored parameter bytes / command */
+#define ST7796_SIM_MAXPARAM       16U
+
+/**
+ * @brief  Bus traffic counters
+ */
+typedef struct {
+	uint32_t Cmds;                 /* command bytes (one per LCD_IO_* transaction) */
+	uint32_t WrBytes;              /* data bytes written to the panel */
+	uint32_t RdBytes;              /* data bytes read from the panel (without dummy) */
+	uint32_t DummyBytes;           /* dummy bytes clocked during reads */
+	uint32_t WrPixels;             /* pixels stored into GRAM */
+	uint32_t RdPixels;             /* pixels read from GRAM */
+	uint32_t DelayMs;              /* sum of the LCD_Delay calls [ms] */
+	uint32_t FormatErrors;         /* pixel transfers with a format different from COLMOD */
+	uint32_t CmdCnt[256];          /* transactions / command */
+	uint32_t CmdBytes[256];        /* data bytes / command */
+} ST7796_SimStatTypeDef;
+
+/**
+ * @brief  Emulated panel state
+ */
+typedef struct {
+	uint8_t Madctl;                /* MADCTL register */
+	uint8_t Colmod;                /* COLMOD register */
+	uint8_t SleepOut;              /* 1: sleep out */
+	uint8_t DisplayOn;             /* 1: display on */
+	uint8_t Backlight;             /* LCD_IO_Bl_OnOff state */
+	uint16_t Xs, Xe, Ys, Ye;       /* CASET / RASET window */
+	uint16_t Tfa, Vsa, Bfa;        /* VSCRDEF: top fixed, scroll and bottom fixed area */
+	uint16_t Vsp;                  /* VSCRSADD: vertical scroll pointer */
+	uint8_t Partial;               /* 1: partial mode (PTLON), 0: normal mode (NORON) */
+	uint8_t Idle;                  /* 1: 8 color idle mode (IDMON) */
+	uint16_t Psl, Pel;             /* PTLAR: partial area start and end row */
+	uint8_t Param[256][ST7796_SIM_MAXPARAM]; /* last parameters of the commands */
+	uint8_t ParamLen[256];         /* number of valid bytes in Param */
+} ST7796_SimStateTypeDef;
+
+/* Trace callback: called after every transaction (command, data byte count) */
+typedef void (*ST7796_SimTraceCallback)(uint8_t Cmd, uint32_t Size);
+
+/**
+ * @brief  Emulated panel instance (the lcd_io interface drives its own one)
+ */
+typedef struct {
+	uint16_t Gram[ST7796_SIM_GRAM_HEIGHT][ST7796_SIM_GRAM_WIDTH];
+	ST7796_SimStateTypeDef State;
+	ST7796_SimStatTypeDef Stat;
+	ST7796_SimTraceCallback pTrace;
+	uint32_t NsPerByte;            /* simulated wire time of a byte (0: no waiting) */
+	uint64_t BusNs;                /* wire time not waited yet */
+	uint16_t CurX, CurY;           /* GRAM address counter */
+	uint8_t PixBytes[3];           /* pixel byte assembler */
+	uint8_t PixByteCnt;
+} ST7796_SimPanelTypeDef;
+
+//-----------------------------------------------------------------------------
+void ST7796_Sim_Reset(void);
+void ST7796_Sim_ResetStat(void);
+const ST7796_SimStatTypeDef * ST7796_Sim_GetStat(void);
+const ST7796_SimStateTypeDef * ST7796_Sim_GetState(void);
+void ST7796_Sim_SetTraceCallback(ST7796_SimTraceCallback pCallback);
+uint16_t ST7796_Sim_GetGramPixel(uint16_t Xpos, uint16_t Ypos);
+uint16_t ST7796_Sim_GetScreenPixel(uint16_t Xpos, uint16_t Ypos);
+uint32_t ST7796_Sim_Replay(const uint8_t *pStream, uint32_t Size);
+
+/* Relative power draw of the panel state [per mille of the full screen
+   normal mode at the ST7796_TE_FRAMEUS frame rate]. A rough model for
+   comparing the power profiles: sleep, the oscillator / booster / gate
+   driver base and the source driver scanning, which is proportional to
+   the scanned lines and the frame rate (FRMCTR1 .. 3 DIV field) and is
+   lower in the idle mode. */
+uint32_t ST7796_Sim_GetPower(void);
+
+/* Emulated panel instances: ST7796_PANEL_INIT(&ST7796_SimPanelIo, &simpanel),
+   every panel can be driven from its own thread */
+extern const ST7796_PanelIoTypeDef ST7796_SimPanelIo;
+void ST7796_SimPanel_Reset(ST7796_SimPanelTypeDef *pSim, uint32_t NsPerByte);
+uint16_t ST7796_SimPanel_GetGramPixel(const ST7796_SimPanelTypeDef *pSim,
+		uint16_t Xpos, uint16_t Ypos);
+uint32_t ST7796_SimPanel_GetPower(const ST7796_SimPanelTypeDef *pSim);
+
+/* Threaded st7796_async transport (st7796_sim_async.c) */
+void ST7796_Sim_AsyncStart(uint32_t NsPerPixel);
+void ST7796_Sim_AsyncStop(void);
+
+/* Simulated tearing effect signal and clock for st7796_te (st7796_sim_te.c) */
+void ST7796_Sim_TeStart(uint32_t FrameUs, uint32_t NsPerByte);
+void ST7796_Sim_TeStop(void);
+uint32_t ST7796_Sim_TeGetTimeUs(void);
+
+#endif /* ST7796_SIM_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,175 @@
+/**
+ ******************************************************************************
+ * @file    st7796_sim_async.c
+ * @author  MCD Application Team
+ * @brief   Threaded background transport for the st7796_async functions on
+ *          the host. The transfers run on a worker thread against the
+ *          st7796_sim panel emulator, optionally slowed down to the bus speed
+ *          so the overlap of rendering and transfer can be observed.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_sim.h"
+#include "st7796_async.h"
+
+static pthread_t simthread;
+static pthread_mutex_t simlock;        /* ST7796_AsyncTransportTypeDef Lock / Unlock */
+static pthread_mutex_t simjobmutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t simjobcond = PTHREAD_COND_INITIALIZER;
+static uint8_t simjob = 0;             /* 1: transfer request pending */
+static uint8_t simquit = 0;
+static uint8_t simcmd;
+static uint16_t *simdata;
+static uint8_t *simparam;              /* not NULL: command with parameter bytes */
+static uint16_t simcolor;
+static uint32_t simsize;
+static uint32_t simnsperpixel = 0;
+
+//-----------------------------------------------------------------------------
+static void *SimAsyncThread(void *pArg) {
+	struct timespec ts;
+	uint64_t ns;
+	(void) pArg;
+	pthread_mutex_lock(&simjobmutex);
+	while (1) {
+		while (!simjob && !simquit)
+			pthread_cond_wait(&simjobcond, &simjobmutex);
+		if (simquit)
+			break;
+		simjob = 0;
+		pthread_mutex_unlock(&simjobmutex);
+
+		if (simparam)
+			LCD_IO_WriteCmd8MultipleData8(simcmd, simparam, simsize);
+#if ST7796_WRITEBITDEPTH == 16
+		else if (simdata)
+			LCD_IO_WriteCmd8MultipleData16(simcmd, simdata, simsize);
+		else
+			LCD_IO_WriteCmd8DataFill16(simcmd, simcolor, simsize);
+#elif ST7796_WRITEBITDEPTH == 24
+		else if (simdata)
+			LCD_IO_WriteCmd8MultipleData16to24(simcmd, simdata, simsize);
+		else
+			LCD_IO_WriteCmd8DataFill16to24(simcmd, simcolor, simsize);
+#endif
+		if (simnsperpixel && !simparam) {
+			ns = (uint64_t) simsize * simnsperpixel;
+			ts.tv_sec = ns / 1000000000U;
+			ts.tv_nsec = ns % 1000000000U;
+			nanosleep(&ts, NULL);
+		}
+		ST7796_AsyncTransferCplt();
+
+		pthread_mutex_lock(&simjobmutex);
+	}
+	pthread_mutex_unlock(&simjobmutex);
+	return NULL;
+}
+
+//-----------------------------------------------------------------------------
+static void SimAsyncRequest(uint8_t Cmd, uint8_t *pParam, uint16_t *pData,
+		uint16_t Color, uint32_t Size) {
+	pthread_mutex_lock(&simjobmutex);
+	simcmd = Cmd;
+	simparam = pParam;
+	simdata = pData;
+	simcolor = Color;
+	simsize = Size;
+	simjob = 1;
+	pthread_cond_signal(&simjobcond);
+	pthread_mutex_unlock(&simjobmutex);
+}
+
+//-----------------------------------------------------------------------------
+static void SimAsyncWriteMultiple(uint8_t Cmd, uint16_t *pData, uint32_t Size) {
+	SimAsyncRequest(Cmd, NULL, pData, 0, Size);
+}
+
+//-----------------------------------------------------------------------------
+static void SimAsyncWriteFill(uint8_t Cmd, uint16_t Data, uint32_t Size) {
+	SimAsyncRequest(Cmd, NULL, NULL, Data, Size);
+}
+
+//-----------------------------------------------------------------------------
+static void SimAsyncWriteCmd(uint8_t Cmd, uint8_t *pData, uint32_t Size) {
+	SimAsyncRequest(Cmd, pData, NULL, 0, Size);
+}
+
+//-----------------------------------------------------------------------------
+static void SimAsyncLock(void) {
+	pthread_mutex_lock(&simlock);
+}
+
+//-----------------------------------------------------------------------------
+static void SimAsyncUnlock(void) {
+	pthread_mutex_unlock(&simlock);
+}
+
+//-----------------------------------------------------------------------------
+static void SimAsyncIdle(void) {
+	sched_yield();
+}
+
+static const ST7796_AsyncTransportTypeDef simtransport = {
+	SimAsyncWriteMultiple,
+	SimAsyncWriteFill,
+	SimAsyncWriteCmd,
+	SimAsyncLock,
+	SimAsyncUnlock,
+	SimAsyncIdle
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Start the transport thread and attach it to st7796_async
+ * @param  NsPerPixel: simulated wire time of a pixel (0: no delay)
+ * @retval None
+ */
+void ST7796_Sim_AsyncStart(uint32_t NsPerPixel) {
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&simlock, &attr);
+	pthread_mutexattr_destroy(&attr);
+	simnsperpixel = NsPerPixel;
+	simquit = 0;
+	simjob = 0;
+	ST7796_AsyncInit(&simtransport);
+	pthread_create(&simthread, NULL, SimAsyncThread, NULL);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Wait for the queued transfers and stop the transport thread
+ * @param  None
+ * @retval None
+ */
+void ST7796_Sim_AsyncStop(void) {
+	ST7796_AsyncWait();
+	pthread_mutex_lock(&simjobmutex);
+	simquit = 1;
+	pthread_cond_signal(&simjobcond);
+	pthread_mutex_unlock(&simjobmutex);
+	pthread_join(simthread, NULL);
+	pthread_mutex_destroy(&simlock);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    st7796_sim_te.c
+ * @author  MCD Application Team
+ * @brief   Simulated tearing effect source for the st7796_te functions on the
+ *          host. A virtual clock advances with the emulated bus traffic and
+ *          with the waiting of st7796_te, the TE edges are generated from the
+ *          virtual clock while the TE output is turned on.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_sim.h"
+#include "st7796_te.h"
+
+static uint64_t simnow;                /* virtual time [ns] */
+static uint64_t simnextedge;           /* next TE edge [ns] */
+static uint64_t simframe;              /* refresh period [ns] */
+static uint64_t simbaseframe;          /* refresh period of the FRMCTR1 DIV 0 [ns] */
+static uint32_t simnsperbyte;
+static uint8_t simteon = 0;
+
+//-----------------------------------------------------------------------------
+/* Advance the virtual clock, the passed TE edges are signaled in time order */
+static void SimTeAdvance(uint64_t Ns) {
+	uint64_t target = simnow + Ns;
+	while (target >= simnextedge) {
+		simnow = simnextedge;
+		simnextedge += simframe;
+		if (simteon)
+			ST7796_TeEdge();
+	}
+	simnow = target;
+}
+
+//-----------------------------------------------------------------------------
+static void SimTeTrace(uint8_t Cmd, uint32_t Size) {
+	if (Cmd == ST7796_TE_LINE_ON)
+		simteon = 1;
+	else if (Cmd == ST7796_TE_LINE_OFF)
+		simteon = 0;
+	else if ((Cmd == ST7796_FRAME_RATE_CTRL1)
+			&& ST7796_Sim_GetState()->ParamLen[Cmd])
+		/* DIV: the oscillator divided by 1, 2, 4, 8 (from the next frame) */
+		simframe = simbaseframe << (ST7796_Sim_GetState()->Param[Cmd][0] & 0x03);
+	SimTeAdvance((uint64_t) (Size + 1) * simnsperbyte);
+}
+
+//-----------------------------------------------------------------------------
+static void SimTeIdle(void) {
+	SimTeAdvance(1000);
+}
+
+static const ST7796_TeSourceTypeDef simtesource = {
+	ST7796_Sim_TeGetTimeUs,
+	SimTeIdle
+};
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Start the virtual clock and attach it to st7796_te
+ *         (uses the trace callback of the emulator)
+ * @param  FrameUs:   refresh period of the simulated panel [us] (FRMCTR1
+ *                    DIV 0, the DIV field divides the refresh rate)
+ * @param  NsPerByte: simulated wire time of a bus byte [ns]
+ * @retval None
+ */
+void ST7796_Sim_TeStart(uint32_t FrameUs, uint32_t NsPerByte) {
+	simnow = 0;
+	simframe = (uint64_t) FrameUs * 1000U;
+	simbaseframe = simframe;
+	simnextedge = simframe;
+	simnsperbyte = NsPerByte;
+	simteon = 0;
+	ST7796_Sim_SetTraceCallback(SimTeTrace);
+	ST7796_TeInit(&simtesource);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Turn off the TE output and detach the virtual clock
+ * @param  None
+ * @retval None
+ */
+void ST7796_Sim_TeStop(void) {
+	ST7796_TeDeInit();
+	ST7796_Sim_SetTraceCallback(NULL);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the virtual time
+ * @param  None
+ * @retval time [us]
+ */
+uint32_t ST7796_Sim_TeGetTimeUs(void) {
+	return (uint32_t) (simnow / 1000U);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,221 @@
+/**
+ ******************************************************************************
+ * @file    st7796_te.c
+ * @author  MCD Application Team
+ * @brief   Tearing effect synchronized presentation for the st7796 driver.
+ *          The TE output signals the vertical blanking, the update of a
+ *          rectangle is started when the panel scan line has left the
+ *          touched gate lines and must end before the scan of the next frame
+ *          reaches them, so the write pointer stays behind the scan line.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lcd_io.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_te.h"
+
+static const ST7796_TeSourceTypeDef *tesrc;
+static ST7796_TeStatTypeDef testat;
+static volatile uint32_t teedgecnt;
+static volatile uint32_t teedgetime;
+
+//-----------------------------------------------------------------------------
+static void TeIdle(void) {
+	if (tesrc->Idle)
+		tesrc->Idle();
+}
+
+//-----------------------------------------------------------------------------
+/* GRAM rows -> display lines (vertical scrolling: VSCRDEF and VSCRSADD), the
+   rows wrapping around the end of the scroll area cover all of its lines */
+static void TeScrollLines(uint16_t *pFirst, uint16_t *pLines) {
+	uint16_t vsp = __REVSH(hst7796.ScrParam[0]);
+	uint16_t tfa = __REVSH(hst7796.ScrParam[1]);
+	uint16_t vsa = __REVSH(hst7796.ScrParam[2]);
+	uint16_t first = *pFirst, last = *pFirst + *pLines - 1, s, e;
+	if ((vsa == 0) || (vsp == tfa) || (last < tfa) || (first >= tfa + vsa))
+		return;
+	/* the rows in the scroll area */
+	s = (first > tfa) ? first : tfa;
+	e = (last < tfa + vsa - 1) ? last : tfa + vsa - 1;
+	s = tfa + (s + vsa - vsp) % vsa;
+	e = tfa + (e + vsa - vsp) % vsa;
+	if (e < s) {
+		s = tfa;
+		e = tfa + vsa - 1;
+	}
+	/* and the rows of the fixed areas */
+	if (first < tfa)
+		s = first;
+	if (last >= tfa + vsa)
+		e = last;
+	*pFirst = s;
+	*pLines = e - s + 1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the frame rate and turn on the TE output (V-blank mode)
+ * @param  pSource: TE source
+ * @retval None
+ */
+void ST7796_TeInit(const ST7796_TeSourceTypeDef *pSource) {
+	tesrc = pSource;
+	teedgecnt = 0;
+	ST7796_TeResetStat();
+	ST7796_Sync();
+	LCD_IO_WriteCmd8MultipleData8(ST7796_FRAME_RATE_CTRL1,
+			(uint8_t *) ST7796_TE_FRMCTR1, 2);
+	LCD_IO_WriteCmd8MultipleData8(ST7796_TE_LINE_ON, (uint8_t *) "\x00", 1);
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Turn off the TE output
+ * @param  None
+ * @retval None
+ */
+void ST7796_TeDeInit(void) {
+	ST7796_Sync();
+	LCD_IO_WriteCmd8MultipleData8(ST7796_TE_LINE_OFF, NULL, 0);
+	tesrc = NULL;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  TE edge (called from the TE pin interrupt or the simulator)
+ *         the refresh period follows the measured edge distance
+ * @param  None
+ * @retval None
+ */
+void ST7796_TeEdge(void) {
+	uint32_t t, d;
+	if (!tesrc)
+		return;
+	t = tesrc->GetTimeUs();
+	d = t - teedgetime;
+	/* skip the first edge and the edges lost while the interrupt was off */
+	if (teedgecnt && (d > testat.FrameUs / 2) && (d < testat.FrameUs * 3 / 2))
+		testat.FrameUs = (testat.FrameUs * 7 + d) / 8;
+	teedgetime = t;
+	teedgecnt++;
+	testat.Edges++;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Send an update behind the scan line
+ * @param  Xpos:   updated rectangle X position
+ * @param  Ypos:   updated rectangle Y position
+ * @param  Xsize:  updated rectangle X size
+ * @param  Ysize:  updated rectangle Y size
+ * @param  pFlush: callback sending the rectangle
+ * @param  pParam: callback parameter
+ * @retval 0: in time (or nothing on the screen), 1: missed the deadline
+ */
+uint8_t ST7796_TePresent(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, ST7796_TeFlushCallback pFlush, void *pParam) {
+	uint32_t edge, line, start, deadline, late;
+	uint16_t first, lines;
+
+	if ((Xpos >= ST7796_SIZE_X) || (Ypos >= ST7796_SIZE_Y) || (Xsize == 0)
+			|| (Ysize == 0))
+		return 0;
+	if (Xpos + Xsize > ST7796_SIZE_X)
+		Xsize = ST7796_SIZE_X - Xpos;
+	if (Ypos + Ysize > ST7796_SIZE_Y)
+		Ysize = ST7796_SIZE_Y - Ypos;
+	/* gate lines (GRAM rows) touched by the rectangle */
+	if (ST7796_MAD_DATA_RIGHT_THEN_DOWN & ST7796_MAD_VERTICAL) {
+		first = Xpos;
+		lines = Xsize;
+	} else {
+		first = Ypos;
+		lines = Ysize;
+	}
+	if (ST7796_MAD_DATA_RIGHT_THEN_DOWN & ST7796_MAD_Y_DOWN)
+		first = ST7796_LCD_PIXEL_HEIGHT - first - lines;
+	TeScrollLines(&first, &lines);
+
+	ST7796_Sync();
+	while (!teedgecnt)
+		TeIdle();
+
+	/* line period, the porch lines are scanned before the first line */
+	line = testat.FrameUs / (ST7796_LCD_PIXEL_HEIGHT + ST7796_TE_PORCH);
+	start = (ST7796_TE_PORCH + first + lines) * line;
+	deadline = testat.FrameUs + (ST7796_TE_PORCH + first) * line;
+
+	/* the first frame where the scan line has not yet passed the start point
+	   (the edges of the later frames are predicted from the refresh period) */
+	edge = teedgetime;
+	while ((int32_t) (tesrc->GetTimeUs() - edge) > (int32_t) start)
+		edge += testat.FrameUs;
+	while ((int32_t) (tesrc->GetTimeUs() - edge) < (int32_t) start)
+		TeIdle();
+
+	pFlush(pParam);
+	ST7796_Sync();
+
+	testat.Frames++;
+	late = tesrc->GetTimeUs() - edge;
+	if ((int32_t) late <= (int32_t) deadline)
+		return 0;
+	late -= deadline;
+	testat.Missed++;
+	if (late > testat.LateUsMax)
+		testat.LateUsMax = late;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the presentation statistics
+ * @param  None
+ * @retval statistics
+ */
+const ST7796_TeStatTypeDef * ST7796_TeGetStat(void) {
+	return &testat;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Clear the presentation statistics (the refresh period restarts from
+ *         ST7796_TE_FRAMEUS)
+ * @param  None
+ * @retval None
+ */
+void ST7796_TeResetStat(void) {
+	testat.Edges = 0;
+	testat.Frames = 0;
+	testat.Missed = 0;
+	testat.LateUsMax = 0;
+	testat.FrameUs = ST7796_TE_FRAMEUS;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Set the refresh period after a frame rate change (the measurement
+ *         continues from this value)
+ * @param  FrameUs: refresh period [us]
+ * @retval None
+ */
+void ST7796_TeSetFrameUs(uint32_t FrameUs) {
+	testat.FrameUs = FrameUs;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,65 @@
+/**
+ ******************************************************************************
+ * @file    st7796_te.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 tearing effect
+ *          synchronized presentation.
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_TE_H
+#define ST7796_TE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/**
+ * @brief  Tearing effect source
+ *         The TE edges must be signaled with ST7796_TeEdge (EXTI interrupt of
+ *         the TE pin or the simulator).
+ */
+typedef struct {
+	uint32_t (*GetTimeUs)(void);   /* free running microsecond counter */
+	void (*Idle)(void);            /* called while waiting (NULL: busy loop) */
+} ST7796_TeSourceTypeDef;
+
+/**
+ * @brief  Presentation statistics
+ */
+typedef struct {
+	uint32_t Edges;                /* TE edges */
+	uint32_t Frames;               /* presented updates */
+	uint32_t Missed;               /* updates finished after the deadline (tearing possible) */
+	uint32_t LateUsMax;            /* worst deadline overrun [us] */
+	uint32_t FrameUs;              /* measured refresh period [us] */
+} ST7796_TeStatTypeDef;
+
+/* Flush callback: sends the update (any driver function or module flush) */
+typedef void (*ST7796_TeFlushCallback)(void *pParam);
+
+//-----------------------------------------------------------------------------
+void ST7796_TeInit(const ST7796_TeSourceTypeDef *pSource);
+void ST7796_TeDeInit(void);
+void ST7796_TeEdge(void);
+uint8_t ST7796_TePresent(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize,
+		uint16_t Ysize, ST7796_TeFlushCallback pFlush, void *pParam);
+const ST7796_TeStatTypeDef * ST7796_TeGetStat(void);
+void ST7796_TeResetStat(void);
+/* Refresh period after a frame rate change (e.g. from st7796_rate) */
+void ST7796_TeSetFrameUs(uint32_t FrameUs);
+
+#endif /* ST7796_TE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
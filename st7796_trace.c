@@ -0,0 +1,234 @@
+/**
+ ******************************************************************************
+ * @file    st7796_trace.c
+ * @author  MCD Application Team
+ * @brief   Instrumentation of the st7796 driver (ST7796_TRACE). Every
+ *          primitive of the single panel interface counts its calls,
+ *          pixels, commands, bus bytes, MADCTL and COLMOD writes and time,
+ *          and stores a timestamped event into a lock-free ring buffer
+ *          (read with ST7796_TraceRead, dumped as text over the UART or read
+ *          from the memory by a host tool).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "st7796.h"
+#include "st7796_reg.h"
+#include "st7796_trace.h"
+
+#if (ST7796_TRACE_RING & (ST7796_TRACE_RING - 1)) != 0
+#error "ST7796_TRACE_RING must be a power of 2"
+#endif
+
+#define TRACETIME()      (tracetime ? tracetime() : 0)
+
+ST7796_TraceRingTypeDef st7796_tracering;
+
+static const char * const tracename[ST7796_TR_NUM] = { "other", "init",
+		"writepixel", "readpixel", "hline", "vline", "fillrect", "bitmap",
+		"rgbimage", "readimage", "scroll", "transform", "command" };
+
+static ST7796_TraceTimeCallback tracetime;
+static ST7796_TraceCountTypeDef tracecount[ST7796_TR_NUM];
+static ST7796_TraceEventTypeDef tracecur;  /* the running primitive */
+static uint8_t tracedepth;
+
+//-----------------------------------------------------------------------------
+/* Append a decimal number and a separator to the text */
+static char * TraceNum(char *p, uint32_t Num, char Sep) {
+	char d[10];
+	uint8_t n = 0;
+	do {
+		d[n++] = '0' + Num % 10;
+		Num /= 10;
+	} while (Num);
+	while (n)
+		*p++ = d[--n];
+	*p++ = Sep;
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+/* Append a string and a separator to the text */
+static char * TraceStr(char *p, const char *pStr, char Sep) {
+	while (*pStr)
+		*p++ = *pStr++;
+	*p++ = Sep;
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Reset the counters and the ring
+ * @param  GetTime: time source (NULL: no timestamps)
+ * @retval None
+ */
+void ST7796_TraceInit(ST7796_TraceTimeCallback GetTime) {
+	tracetime = GetTime;
+	tracedepth = 0;
+	memset(tracecount, 0, sizeof(tracecount));
+	st7796_tracering.Dropped = 0;
+	st7796_tracering.Tail = st7796_tracering.Head;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Start of a primitive
+ * @param  Prim:   ST7796_TR_...
+ * @param  Pixels: number of pixels
+ * @retval None
+ */
+void ST7796_TraceBegin(uint8_t Prim, uint32_t Pixels) {
+	if (tracedepth++)
+		return; /* e.g. the display list flush inside a primitive */
+	tracecur.Prim = Prim;
+	tracecur.Pixels = Pixels;
+	tracecur.Cmds = 0;
+	tracecur.BusBytes = 0;
+	tracecur.Flags = 0;
+	tracecur.Time = TRACETIME();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  End of a primitive: count and store the event
+ * @param  None
+ * @retval None
+ */
+void ST7796_TraceEnd(void) {
+	ST7796_TraceCountTypeDef *pCount;
+	uint32_t head;
+	if (--tracedepth)
+		return;
+	tracecur.Duration = TRACETIME() - tracecur.Time;
+	pCount = &tracecount[tracecur.Prim];
+	pCount->Calls++;
+	pCount->Pixels += tracecur.Pixels;
+	pCount->TimeSum += tracecur.Duration;
+
+	head = st7796_tracering.Head;
+	if (head - st7796_tracering.Tail >= ST7796_TRACE_RING) {
+		st7796_tracering.Dropped++;
+		return;
+	}
+	st7796_tracering.Event[head & (ST7796_TRACE_RING - 1)] = tracecur;
+	/* the event is complete before the consumer can see it */
+	__DMB();
+	st7796_tracering.Head = head + 1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Count a bus transfer (called by the lcd_io adapters)
+ * @param  Cmd:   command
+ * @param  Bytes: parameter / pixel bytes
+ * @retval None
+ */
+void ST7796_TraceBus(uint8_t Cmd, uint32_t Bytes) {
+	ST7796_TraceCountTypeDef *pCount;
+	if (tracedepth) {
+		pCount = &tracecount[tracecur.Prim];
+		tracecur.Cmds++;
+		tracecur.BusBytes += Bytes;
+		if (Cmd == ST7796_MADCTL)
+			tracecur.Flags |= ST7796_TRF_MADCTL;
+		else if (Cmd == ST7796_COLOR_MODE)
+			tracecur.Flags |= ST7796_TRF_COLMOD;
+	} else
+		pCount = &tracecount[ST7796_TR_OTHER];
+	pCount->Cmds++;
+	pCount->BusBytes += Bytes;
+	if (Cmd == ST7796_MADCTL)
+		pCount->Madctl++;
+	else if (Cmd == ST7796_COLOR_MODE)
+		pCount->Colmod++;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Get the counters of a primitive
+ * @param  Prim: ST7796_TR_...
+ * @retval counters
+ */
+const ST7796_TraceCountTypeDef * ST7796_TraceGetCount(uint8_t Prim) {
+	return &tracecount[Prim];
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Take the oldest event from the ring
+ * @param  pEvent: event
+ * @retval 1: pEvent is valid, 0: the ring is empty
+ */
+uint8_t ST7796_TraceRead(ST7796_TraceEventTypeDef *pEvent) {
+	uint32_t tail = st7796_tracering.Tail;
+	if (tail == st7796_tracering.Head)
+		return 0;
+	/* Head before the event */
+	__DMB();
+	*pEvent = st7796_tracering.Event[tail & (ST7796_TRACE_RING - 1)];
+	/* the event is copied before the producer can overwrite it */
+	__DMB();
+	st7796_tracering.Tail = tail + 1;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief  Write the counters and the pending events as CSV lines
+ *         ("count,<primitive>,calls,pixels,cmds,bytes,madctl,colmod,time"
+ *         and "event,<primitive>,time,duration,pixels,cmds,bytes,flags")
+ * @param  Write: text output
+ * @retval None
+ */
+void ST7796_TraceDump(ST7796_TraceWriteCallback Write) {
+	const ST7796_TraceCountTypeDef *c;
+	ST7796_TraceEventTypeDef e;
+	char line[128], *p;
+	uint8_t i;
+	for (i = 0; i < ST7796_TR_NUM; i++) {
+		c = &tracecount[i];
+		p = TraceStr(line, "count", ',');
+		p = TraceStr(p, tracename[i], ',');
+		p = TraceNum(p, c->Calls, ',');
+		p = TraceNum(p, c->Pixels, ',');
+		p = TraceNum(p, c->Cmds, ',');
+		p = TraceNum(p, c->BusBytes, ',');
+		p = TraceNum(p, c->Madctl, ',');
+		p = TraceNum(p, c->Colmod, ',');
+		p = TraceNum(p, c->TimeSum, '\n');
+		*p = 0;
+		Write(line);
+	}
+	while (ST7796_TraceRead(&e)) {
+		p = TraceStr(line, "event", ',');
+		p = TraceStr(p, tracename[e.Prim], ',');
+		p = TraceNum(p, e.Time, ',');
+		p = TraceNum(p, e.Duration, ',');
+		p = TraceNum(p, e.Pixels, ',');
+		p = TraceNum(p, e.Cmds, ',');
+		p = TraceNum(p, e.BusBytes, ',');
+		p = TraceNum(p, e.Flags, '\n');
+		*p = 0;
+		Write(line);
+	}
+	p = TraceStr(line, "dropped", ',');
+	p = TraceNum(p, st7796_tracering.Dropped, '\n');
+	*p = 0;
+	Write(line);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
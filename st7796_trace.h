@@ -0,0 +1,112 @@
+/**
+ ******************************************************************************
+ * @file    st7796_trace.h
+ * @author  MCD Application Team
+ * @brief   This file contains the interface of the st7796 instrumentation
+ *          (per primitive counters and the trace event ring buffer).
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2018 STMicroelectronics.
+ * All rights reserved.</center></h2>
+ *
+ * This software component is licensed by ST under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the
+ * License. You may obtain a copy of the License at:
+ *                        opensource.org/licenses/BSD-3-Clause
+ *
+ ******************************************************************************
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ST7796_TRACE_H
+#define ST7796_TRACE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "st7796.h"
+
+/* Primitives of the single panel interface */
+#define ST7796_TR_OTHER        0   /* bus traffic outside of the primitives (driver modules) */
+#define ST7796_TR_INIT         1
+#define ST7796_TR_WRITEPIXEL   2
+#define ST7796_TR_READPIXEL    3
+#define ST7796_TR_HLINE        4
+#define ST7796_TR_VLINE        5
+#define ST7796_TR_FILLRECT     6
+#define ST7796_TR_BITMAP       7
+#define ST7796_TR_RGBIMAGE     8
+#define ST7796_TR_READIMAGE    9
+#define ST7796_TR_SCROLL       10
+#define ST7796_TR_TRANSFORM    11
+#define ST7796_TR_COMMAND      12  /* on / off, ID, cursor, window, orientation, user command */
+#define ST7796_TR_NUM          13
+
+/**
+ * @brief  Counters of a primitive
+ */
+typedef struct {
+	uint32_t Calls;
+	uint32_t Pixels;               /* requested pixels (before clipping) */
+	uint32_t Cmds;                 /* commands sent on the bus */
+	uint32_t BusBytes;             /* parameter / pixel bytes (dummy read bytes included) */
+	uint32_t Madctl;               /* MADCTL writes (memory access direction changes) */
+	uint32_t Colmod;               /* COLMOD writes (read / write bitdepth changes) */
+	uint32_t TimeSum;              /* sum of the durations [time source unit] */
+} ST7796_TraceCountTypeDef;
+
+/**
+ * @brief  Trace event (one primitive call)
+ */
+typedef struct {
+	uint32_t Time;                 /* start time */
+	uint32_t Duration;
+	uint32_t Pixels;
+	uint32_t BusBytes;
+	uint16_t Cmds;
+	uint8_t Prim;                  /* ST7796_TR_... */
+	uint8_t Flags;                 /* ST7796_TRF_... */
+} ST7796_TraceEventTypeDef;
+
+#define ST7796_TRF_MADCTL      0x01 /* the primitive has switched MADCTL */
+#define ST7796_TRF_COLMOD      0x02 /* the primitive has switched COLMOD */
+
+/**
+ * @brief  Event ring buffer (single producer: the driver, single consumer:
+ *         ST7796_TraceRead or a host tool reading the memory through the
+ *         debugger). Head is written only by the producer, Tail only by the
+ *         consumer, the events between Tail and Head are valid. A full ring
+ *         drops the new events.
+ */
+typedef struct {
+	volatile uint32_t Head;        /* free running write index */
+	volatile uint32_t Tail;        /* free running read index */
+	uint32_t Dropped;              /* events lost (full ring) */
+	ST7796_TraceEventTypeDef Event[ST7796_TRACE_RING];
+} ST7796_TraceRingTypeDef;
+
+extern ST7796_TraceRingTypeDef st7796_tracering;
+
+//-----------------------------------------------------------------------------
+/* Time source (free running counter, e.g. DWT->CYCCNT or a microsecond
+   timer, NULL: no timestamps) and text output (e.g. UART) of the dump */
+typedef uint32_t (*ST7796_TraceTimeCallback)(void);
+typedef void (*ST7796_TraceWriteCallback)(const char *pText);
+
+/* Reset the counters and the ring */
+void ST7796_TraceInit(ST7796_TraceTimeCallback GetTime);
+
+/* Hooks of st7796.c (nested calls are counted in the outer primitive) */
+void ST7796_TraceBegin(uint8_t Prim, uint32_t Pixels);
+void ST7796_TraceEnd(void);
+void ST7796_TraceBus(uint8_t Cmd, uint32_t Bytes);
+
+const ST7796_TraceCountTypeDef * ST7796_TraceGetCount(uint8_t Prim);
+/* Take the oldest event (1: pEvent is valid, 0: the ring is empty) */
+uint8_t ST7796_TraceRead(ST7796_TraceEventTypeDef *pEvent);
+/* Counters and the pending events as CSV lines (the events are taken) */
+void ST7796_TraceDump(ST7796_TraceWriteCallback Write);
+
+#endif /* ST7796_TRACE_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/